@@ -2,6 +2,8 @@
 #define INCLUDE_INCLUDE_CONSTANTS_H_
 
 #include "Filter.h"
+#include "FilterOrder.h"
+#include "Fir.h"
 #include "imgui.h"
 #include <numbers>
 
@@ -47,6 +49,53 @@ constexpr int          kDefaultFilterOrder = 2;
 constexpr double       kDefaultCutoffFreq  = 100.0;
 constexpr double       kDefaultCutoffFreq2 = 200.0;
 
+// Default specification (FilterNode designed from passband and stopband)
+constexpr double             kDefaultStopFreq        = 150.0;
+constexpr double             kDefaultStopFreq2       = 250.0;
+constexpr double             kDefaultPassRipple      = 1.0;
+constexpr double             kDefaultStopAttenuation = 40.0;
+constexpr Filter::FilterSpec kDefaultFilterSpec{
+    kDefaultFilterMode,   kDefaultCutoffFreq,   kDefaultStopFreq,
+    kDefaultCutoffFreq2,  kDefaultStopFreq2,    kDefaultSamplingFreq,
+    kDefaultPassRipple,   kDefaultStopAttenuation,
+};
+
+// Default parameters (FilterBankNode)
+constexpr int    kDefaultBankBands    = 8;
+constexpr int    kMaxBankBands        = 64;
+constexpr double kDefaultBankLowFreq  = 20.0;
+constexpr double kDefaultBankHighFreq = 400.0;
+
+// Default parameters (ResampleNode)
+constexpr int kDefaultResampleUp   = 1;
+constexpr int kDefaultResampleDown = 2;
+constexpr int kMaxResampleFactor   = 100;
+
+// Default parameters (SpectrogramNode)
+constexpr Filter::Window kDefaultStftWindow       = Filter::hann;
+constexpr int            kDefaultStftLength       = 256;
+constexpr int            kDefaultStftHop          = 64;
+constexpr int            kMinStftLength           = 16;
+constexpr int            kMaxStftLength           = 4096;
+constexpr int            kMaxSpectrogramColumns   = 1024;
+constexpr double         kSpectrogramDynamicRange = 80.0; // dB
+
+// Default parameters (ToneTrackerNode)
+constexpr int    kDefaultToneHarmonics = 3;
+constexpr int    kMaxToneHarmonics     = 16;
+constexpr double kDefaultToneFrequency = 50.0;
+constexpr int    kDefaultTonePeriods   = 10; // Fundamental periods per window
+constexpr int    kMaxTonePeriods       = 100;
+
+// Default parameters (SmoothingNode and RunningStatsNode)
+constexpr int    kDefaultSmoothingWindow = 32;
+constexpr int    kMaxSmoothingWindow     = 4096;
+constexpr double kDefaultSmoothingAlpha  = 0.1;
+constexpr int    kDefaultCicStages       = 3;
+constexpr int    kMaxCicStages           = 8;
+constexpr int    kDefaultCicDecimation   = 4;
+constexpr int    kMaxCicDecimation       = 100;
+
 } // namespace Nodex::Constants
 
 #endif // INCLUDE_INCLUDE_CONSTANTS_H_
@@ -1,14 +1,21 @@
 #ifndef INCLUDE_INCLUDE_GUI_H_
 #define INCLUDE_INCLUDE_GUI_H_
 
+#include "Averaging.h"
 #include "Constants.h"
+#include "DesignCache.h"
 #include "Filter.h"
+#include "FilterBank.h"
+#include "FilterOrder.h"
 #include "Node.h"
+#include "SlidingDft.h"
+#include "Stft.h"
 #include "Utils.h"
 #include "imgui.h"
 #include "nlohmann/json_fwd.hpp"
 #include <Eigen/Dense>
 #include <cstddef>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -120,18 +127,191 @@ public:
              const int              order      = Constants::kDefaultFilterOrder,
              const double           cutoffFreq = Constants::kDefaultCutoffFreq,
              const double samplingFreq = Constants::kDefaultSamplingFreq,
-             const double cutoffFreq2  = Constants::kDefaultCutoffFreq2);
+             const double cutoffFreq2  = Constants::kDefaultCutoffFreq2,
+             const bool   fromSpec     = false,
+             const Filter::FilterSpec& spec = Constants::kDefaultFilterSpec);
 
   void           render() override;
   nlohmann::json serialize() const override;
 
 private:
+  // The design to run: the manual parameters, or the cheapest design meeting
+  // the specification when designing from spec (and the spec is valid)
+  Filter::DesignKey designKey();
+
   Nodex::Filter::Mode m_filterMode{};
   Nodex::Filter::Type m_filterType{};
   int                 m_filterOrder{};
   double              m_cutoffFreq{};
   double              m_samplingFreq{};
   double              m_cutoffFreq2{};
+
+  // Design from a passband and stopband specification; the choice is kept
+  // until the specification changes
+  bool               m_fromSpec{};
+  Filter::FilterSpec m_spec{};
+  Filter::FilterSpec m_chosenSpec{};
+  Filter::DesignKey  m_chosen{};
+  std::string        m_specError{};
+  bool               m_hasChosen{false};
+};
+
+class FilterBankNode : public Core::Node {
+public:
+  FilterBankNode(const std::string_view name,
+                 const int          bands    = Constants::kDefaultBankBands,
+                 const Filter::Type type     = Constants::kDefaultFilterType,
+                 const int          order    = Constants::kDefaultFilterOrder,
+                 const double       lowFreq  = Constants::kDefaultBankLowFreq,
+                 const double       highFreq = Constants::kDefaultBankHighFreq,
+                 const double samplingFreq = Constants::kDefaultSamplingFreq);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  const Filter::RowMajorMatrixXd& bankOutput();
+
+  int                 m_bands{};
+  Nodex::Filter::Type m_filterType{};
+  int                 m_filterOrder{};
+  double              m_lowFreq{};
+  double              m_highFreq{};
+  double              m_samplingFreq{};
+
+  // Designs the bank was built from, and its output for the current frame
+  std::vector<Filter::DesignKey> m_keys{};
+  Filter::FilterBank             m_bank{};
+  Filter::RowMajorMatrixXd       m_output{};
+  std::size_t                    m_outputFrame{0};
+  bool                           m_hasOutput{false};
+};
+
+class ResampleNode : public Core::Node {
+public:
+  ResampleNode(const std::string_view name,
+               const int              up   = Constants::kDefaultResampleUp,
+               const int              down = Constants::kDefaultResampleDown);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  int m_up{};
+  int m_down{};
+};
+
+class SpectrogramNode : public Core::Node {
+public:
+  SpectrogramNode(
+      const std::string_view name,
+      const Filter::Window   window       = Constants::kDefaultStftWindow,
+      const int              windowLength = Constants::kDefaultStftLength,
+      const int              hop          = Constants::kDefaultStftHop,
+      const double           samplingFreq = Constants::kDefaultSamplingFreq);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  // Feeds the samples of the input not seen yet. The transform restarts when
+  // the parameters change or the input no longer extends what it has seen.
+  void update(const Eigen::ArrayXd& data);
+
+  Filter::Window m_window{};
+  int            m_windowLength{};
+  int            m_hop{};
+  double         m_samplingFreq{};
+
+  Filter::Stft   m_stft{};
+  Eigen::ArrayXd m_seen{};
+  bool           m_stale{true};
+
+  // Spectrogram in dB, one column of bins per frame (highest bin first, as
+  // the heatmap draws its first row at the top), oldest frame first
+  std::vector<double> m_image{};
+  int                 m_columns{0};
+  int                 m_dropped{0};
+  double              m_peakDb{0.0};
+};
+
+class ToneTrackerNode : public Core::Node {
+public:
+  ToneTrackerNode(
+      const std::string_view name,
+      const int              harmonics    = Constants::kDefaultToneHarmonics,
+      const double           fundamental  = Constants::kDefaultToneFrequency,
+      const int              periods      = Constants::kDefaultTonePeriods,
+      const double           samplingFreq = Constants::kDefaultSamplingFreq);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  // Tracks the harmonics over the input once per frame for all outputs
+  void track();
+
+  // Samples in the window: a whole number of fundamental periods, so that
+  // every harmonic falls on a bin
+  int windowLength() const;
+
+  int    m_harmonics{};
+  double m_fundamental{};
+  int    m_periods{};
+  double m_samplingFreq{};
+
+  // Amplitude and phase of each harmonic (one row each) for the current
+  // frame
+  Filter::SlidingDft       m_tracker{};
+  bool                     m_stale{true};
+  Filter::RowMajorMatrixXd m_amplitude{};
+  Filter::RowMajorMatrixXd m_phase{};
+  std::size_t              m_outputFrame{0};
+  bool                     m_hasOutput{false};
+};
+
+class SmoothingNode : public Core::Node {
+public:
+  // How the input is smoothed
+  enum Method { movingAverage, exponential, cic, maxMethod };
+
+  SmoothingNode(
+      const std::string_view name, const Method method = movingAverage,
+      const int    windowLength = Constants::kDefaultSmoothingWindow,
+      const double alpha        = Constants::kDefaultSmoothingAlpha,
+      const int    stages       = Constants::kDefaultCicStages,
+      const int    decimation   = Constants::kDefaultCicDecimation);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  Method m_method{};
+  int    m_windowLength{};
+  double m_alpha{};
+  int    m_stages{};
+  int    m_decimation{};
+};
+
+class RunningStatsNode : public Core::Node {
+public:
+  RunningStatsNode(
+      const std::string_view name,
+      const int              windowLength = Constants::kDefaultSmoothingWindow);
+
+  void           render() override;
+  nlohmann::json serialize() const override;
+
+private:
+  // Computes the statistics of the input once per frame for all outputs
+  void update();
+
+  int m_windowLength{};
+
+  // Mean, variance and RMS (one row each) for the current frame
+  Filter::RowMajorMatrixXd m_stats{};
+  std::size_t              m_outputFrame{0};
+  bool                     m_hasOutput{false};
 };
 
 class CSVNode : public Core::Node {
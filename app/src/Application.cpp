@@ -1,5 +1,6 @@
 #include "Application.h"
 #include "Constants.h"
+#include "FilterDispatch.h"
 #include "Gui.h"
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -42,6 +43,9 @@ bool Application::initialize() {
     return false;
   }
 
+  // Lets the filter nodes pick time-domain or FFT filtering for this host
+  Nodex::Filter::calibrateFilterCostModel();
+
   initializeNodeGraph();
   m_isRunning = true;
 
@@ -1,15 +1,23 @@
 #include "Gui.h"
 #include "Core.h"
+#include "DesignCache.h"
 #include "Eigen/Core"
+#include "FilterDispatch.h"
 #include "FilterEigen.h"
+#include "FilterOrder.h"
+#include "Resample.h"
 #include "Serializer.h"
 #include "Utils.h"
 #include "imgui.h"
 #include "implot.h"
 #include "nfd.hpp"
 #include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
 namespace ImGui {
@@ -31,6 +39,14 @@ static int         s_mixerInputs          = 2;
 static bool        s_openMixerModal       = false;
 static std::string s_pendingMixerNodeName = {};
 
+static int         s_bankBands               = Constants::kDefaultBankBands;
+static bool        s_openBankModal           = false;
+static std::string s_pendingBankNodeName     = {};
+
+static int         s_toneHarmonics           = Constants::kDefaultToneHarmonics;
+static bool        s_openToneModal           = false;
+static std::string s_pendingToneNodeName     = {};
+
 static int         s_multiViewerInputs          = 2;
 static bool        s_openMultiViewerModal       = false;
 static std::string s_pendingMultiViewerNodeName = {};
@@ -125,7 +141,7 @@ void ViewerNode::render() {
 
       if (ImPlot::BeginPlot("Frequency plot",
                             ImVec2{kPlotWidth, kPlotHeight})) {
-        auto x{generateFrequencyVector(fft.size(), m_samplingFreq)};
+        auto x{generateRfftFrequencyVector(data.size(), m_samplingFreq)};
         ImPlot::SetupAxis(ImAxis_X1, "Frequency (Hz)");
         ImPlot::SetupAxis(ImAxis_Y1, "Magnitude");
         ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
@@ -199,7 +215,7 @@ void MultiViewerNode::render() {
       for (std::size_t i{0}; i < m_inputs; ++i) {
         auto data{inputValue<Eigen::ArrayXd>("In " + std::to_string(i + 1))};
         auto fft{computeFFT(data)};
-        auto x{generateFrequencyVector(fft.size(), m_samplingFreq)};
+        auto x{generateRfftFrequencyVector(data.size(), m_samplingFreq)};
 
         ImPlot::PlotLine(("Input " + std::to_string(i + 1)).c_str(), x.data(),
                          fft.data(), static_cast<int>(fft.size()));
@@ -296,57 +312,103 @@ FilterNode::FilterNode(const std::string_view    name,
                        const Nodex::Filter::Mode mode,
                        const Nodex::Filter::Type type, const int order,
                        const double cutoffFreq, const double samplingFreq,
-                       const double cutoffFreq2)
+                       const double cutoffFreq2, const bool fromSpec,
+                       const Nodex::Filter::FilterSpec& spec)
     : Node{name, "Filter"}, m_filterMode{mode}, m_filterType{type},
       m_filterOrder{order}, m_cutoffFreq{cutoffFreq},
-      m_samplingFreq{samplingFreq}, m_cutoffFreq2{cutoffFreq2} {
+      m_samplingFreq{samplingFreq}, m_cutoffFreq2{cutoffFreq2},
+      m_fromSpec{fromSpec}, m_spec{spec} {
   addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
   addOutput<Eigen::ArrayXd>("Out", [this]() {
     auto inputData{inputValue<Eigen::ArrayXd>("In")};
-    ZPK  filterCoeffs{};
 
-    if (m_filterMode == Mode::bandpass || m_filterMode == Mode::bandstop) {
-      filterCoeffs = iirFilter(m_filterOrder, m_cutoffFreq, m_cutoffFreq2,
-                               m_samplingFreq, m_filterType, m_filterMode);
-    } else {
-      filterCoeffs = iirFilter(m_filterOrder, m_cutoffFreq, m_samplingFreq,
-                               m_filterType, m_filterMode);
-    }
+    // The output is evaluated every frame, so the design is memoized
+    const auto design{DesignCache::global().get(designKey())};
 
-    EigenCoeffs filter{};
-    filter = zpk2tf(EigenZPK(filterCoeffs));
-
-    return linearFilter(filter, inputData);
+    // Long or high-order filters may run faster as an FFT convolution
+    return filter(design->sos, inputData);
   });
 }
 
+DesignKey FilterNode::designKey() {
+  const DesignKey manual{m_filterType, m_filterMode,  m_filterOrder,
+                         m_cutoffFreq, m_cutoffFreq2, m_samplingFreq};
+  if (!m_fromSpec)
+    return manual;
+
+  m_spec.mode = m_filterMode;
+  m_spec.fs   = m_samplingFreq;
+  if (!m_hasChosen || !(m_spec == m_chosenSpec)) {
+    m_chosenSpec = m_spec;
+    m_hasChosen  = true;
+    try {
+      m_chosen = designFromSpec(m_spec);
+      m_specError.clear();
+    } catch (const std::runtime_error& e) {
+      m_specError = e.what();
+    }
+  }
+
+  return m_specError.empty() ? m_chosen : manual;
+}
+
 void FilterNode::render() {
   ImGui::Text("Parameters:");
   static constexpr const char* filterTypes[] = {"Butterworth", "Chebyshev I",
-                                                "Chebyshev II"};
+                                                "Chebyshev II", "Elliptic"};
   static constexpr const char* filterModes[] = {"Lowpass", "Highpass",
                                                 "Bandpass", "Bandstop"};
 
-  int filterTypeIdx = static_cast<int>(m_filterType);
-  if (ImGui::Combo("Type", &filterTypeIdx, filterTypes, 3)) {
-    m_filterType = static_cast<Type>(filterTypeIdx);
-  }
-
   int filterModeIdx = static_cast<int>(m_filterMode);
   if (ImGui::Combo("Mode", &filterModeIdx, filterModes, 4)) {
     m_filterMode = static_cast<Mode>(filterModeIdx);
   }
 
-  ImGui::SliderInt("Order", &m_filterOrder, 1, 10);
-
-  if (m_filterMode == Mode::bandpass || m_filterMode == Mode::bandstop) {
-    ImGui::SliderDouble("f low (Hz)", &m_cutoffFreq, 1.0, m_samplingFreq / 2,
-                        "%.1f");
-    ImGui::SliderDouble("f high (Hz)", &m_cutoffFreq2, m_cutoffFreq,
-                        m_samplingFreq / 2, "%.1f");
+  ImGui::Checkbox("Design from spec", &m_fromSpec);
+
+  const bool band{m_filterMode == Mode::bandpass ||
+                  m_filterMode == Mode::bandstop};
+
+  if (m_fromSpec) {
+    // Band edges, then the cheapest family and order that meet them
+    const double nyquist{m_samplingFreq / 2};
+    ImGui::SliderDouble(band ? "f pass low (Hz)" : "f pass (Hz)",
+                        &m_spec.passFreq, 1.0, nyquist, "%.1f");
+    ImGui::SliderDouble(band ? "f stop low (Hz)" : "f stop (Hz)",
+                        &m_spec.stopFreq, 1.0, nyquist, "%.1f");
+    if (band) {
+      ImGui::SliderDouble("f pass high (Hz)", &m_spec.passFreq2, 1.0, nyquist,
+                          "%.1f");
+      ImGui::SliderDouble("f stop high (Hz)", &m_spec.stopFreq2, 1.0, nyquist,
+                          "%.1f");
+    }
+    ImGui::SliderDouble("Ripple (dB)", &m_spec.passRipple, 0.1, 3.0, "%.2f");
+    ImGui::SliderDouble("Attenuation (dB)", &m_spec.stopAttenuation, 10.0,
+                        120.0, "%.1f");
+
+    const DesignKey key{designKey()};
+    if (m_specError.empty())
+      ImGui::Text("Design: %s, order %d", filterTypes[key.type], key.order);
+    else
+      ImGui::TextColored(ImVec4{1.0f, 0.4f, 0.4f, 1.0f}, "%s",
+                         m_specError.c_str());
   } else {
-    ImGui::SliderDouble("fc (Hz)", &m_cutoffFreq, 1.0, m_samplingFreq / 2,
-                        "%.1f");
+    int filterTypeIdx = static_cast<int>(m_filterType);
+    if (ImGui::Combo("Type", &filterTypeIdx, filterTypes, maxType)) {
+      m_filterType = static_cast<Type>(filterTypeIdx);
+    }
+
+    ImGui::SliderInt("Order", &m_filterOrder, 1, 10);
+
+    if (band) {
+      ImGui::SliderDouble("f low (Hz)", &m_cutoffFreq, 1.0,
+                          m_samplingFreq / 2, "%.1f");
+      ImGui::SliderDouble("f high (Hz)", &m_cutoffFreq2, m_cutoffFreq,
+                          m_samplingFreq / 2, "%.1f");
+    } else {
+      ImGui::SliderDouble("fc (Hz)", &m_cutoffFreq, 1.0, m_samplingFreq / 2,
+                          "%.1f");
+    }
   }
 
   ImGui::SliderDouble("fs (Hz)", &m_samplingFreq, 10.0, 10000.0, "%.1f");
@@ -363,6 +425,491 @@ nlohmann::json FilterNode::serialize() const {
       {   "fs",                 m_samplingFreq},
       {  "fc2",                  m_cutoffFreq2},
   };
+  j["parameters"]["fromSpec"] = m_fromSpec;
+  j["parameters"]["spec"]     = {
+      { "fpass",        m_spec.passFreq},
+      { "fstop",        m_spec.stopFreq},
+      {"fpass2",       m_spec.passFreq2},
+      {"fstop2",       m_spec.stopFreq2},
+      {    "rp",      m_spec.passRipple},
+      {    "rs", m_spec.stopAttenuation},
+  };
+
+  return j;
+}
+
+// FilterBankNode
+FilterBankNode::FilterBankNode(const std::string_view name, const int bands,
+                               const Filter::Type type, const int order,
+                               const double lowFreq, const double highFreq,
+                               const double samplingFreq)
+    : Node{name, "Filter Bank"}, m_bands{bands}, m_filterType{type},
+      m_filterOrder{order}, m_lowFreq{lowFreq}, m_highFreq{highFreq},
+      m_samplingFreq{samplingFreq} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+
+  for (int i{0}; i < m_bands; ++i) {
+    addOutput<Eigen::ArrayXd>("Band " + std::to_string(i + 1), [this, i]() {
+      return Eigen::ArrayXd{bankOutput().row(i).transpose()};
+    });
+  }
+}
+
+const RowMajorMatrixXd& FilterBankNode::bankOutput() {
+  // Every band output is pulled each frame; the bank runs once for all
+  const std::size_t frame{graph()->frame()};
+  if (m_hasOutput && m_outputFrame == frame)
+    return m_output;
+
+  // Log-spaced bandpass bands between the low and high frequencies
+  std::vector<DesignKey> keys{};
+  const double           ratio{m_highFreq / m_lowFreq};
+  for (int i{0}; i < m_bands; ++i) {
+    const double low{m_lowFreq * std::pow(ratio, static_cast<double>(i) /
+                                                     m_bands)};
+    const double high{m_lowFreq * std::pow(ratio, static_cast<double>(i + 1) /
+                                                      m_bands)};
+    keys.push_back(
+        {m_filterType, Mode::bandpass, m_filterOrder, low, high,
+         m_samplingFreq});
+  }
+
+  if (keys != m_keys) {
+    std::vector<SosArray> sos{};
+    for (const auto& key : keys)
+      sos.push_back(DesignCache::global().get(key)->sos);
+
+    m_bank = FilterBank{sos};
+    m_keys = std::move(keys);
+  }
+
+  // Each frame filters the whole input afresh
+  m_bank.reset();
+  m_output      = m_bank.process(inputValue<Eigen::ArrayXd>("In"));
+  m_outputFrame = frame;
+  m_hasOutput   = true;
+
+  return m_output;
+}
+
+void FilterBankNode::render() {
+  ImGui::Text("Parameters:");
+  static constexpr const char* filterTypes[] = {"Butterworth", "Chebyshev I",
+                                                "Chebyshev II", "Elliptic"};
+
+  int filterTypeIdx = static_cast<int>(m_filterType);
+  if (ImGui::Combo("Type", &filterTypeIdx, filterTypes, maxType)) {
+    m_filterType = static_cast<Type>(filterTypeIdx);
+  }
+
+  ImGui::SliderInt("Order", &m_filterOrder, 1, 10);
+  ImGui::SliderDouble("f low (Hz)", &m_lowFreq, 1.0, m_highFreq, "%.1f");
+  ImGui::SliderDouble("f high (Hz)", &m_highFreq, m_lowFreq,
+                      m_samplingFreq / 2, "%.1f");
+  ImGui::SliderDouble("fs (Hz)", &m_samplingFreq, 10.0, 10000.0, "%.1f");
+  ImGui::Text("Bands: %d", m_bands);
+}
+
+nlohmann::json FilterBankNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "FilterBankNode";
+  j["parameters"]  = {
+      {"bands",                      m_bands},
+      { "type", static_cast<int>(m_filterType)},
+      {"order",                m_filterOrder},
+      {  "low",                    m_lowFreq},
+      { "high",                   m_highFreq},
+      {   "fs",               m_samplingFreq},
+  };
+
+  return j;
+}
+
+// ResampleNode
+ResampleNode::ResampleNode(const std::string_view name, const int up,
+                           const int down)
+    : Node{name, "Resample"}, m_up{up}, m_down{down} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+  addOutput<Eigen::ArrayXd>("Out", [this]() {
+    auto inputData{inputValue<Eigen::ArrayXd>("In")};
+
+    return resamplePoly(inputData, m_up, m_down);
+  });
+}
+
+void ResampleNode::render() {
+  ImGui::Text("Parameters:");
+  ImGui::SliderInt("Up", &m_up, 1, Constants::kMaxResampleFactor);
+  ImGui::SliderInt("Down", &m_down, 1, Constants::kMaxResampleFactor);
+  ImGui::Text("Rate: x%.4g", static_cast<double>(m_up) / m_down);
+}
+
+nlohmann::json ResampleNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "ResampleNode";
+  j["parameters"]  = {
+      {  "up",   m_up},
+      {"down", m_down},
+  };
+
+  return j;
+}
+
+// SpectrogramNode
+SpectrogramNode::SpectrogramNode(const std::string_view name,
+                                 const Filter::Window   window,
+                                 const int windowLength, const int hop,
+                                 const double samplingFreq)
+    : Node{name, "Spectrogram"}, m_window{window},
+      m_windowLength{std::max(windowLength, 1)},
+      m_hop{std::clamp(hop, 1, m_windowLength)},
+      m_samplingFreq{std::max(samplingFreq, 1.0)} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+}
+
+void SpectrogramNode::update(const Eigen::ArrayXd& data) {
+  using namespace Constants;
+
+  const Index seen{m_seen.size()};
+  const bool  extends{data.size() >= seen &&
+                     (data.head(seen) == m_seen).all()};
+  if (m_stale || !extends) {
+    m_stft = Filter::Stft{m_window, m_windowLength, m_hop, -1, 1,
+                          m_samplingFreq};
+    m_seen.resize(0);
+    m_image.clear();
+    m_columns = 0;
+    m_dropped = 0;
+    m_peakDb  = -std::numeric_limits<double>::infinity();
+    m_stale   = false;
+  }
+
+  const Index fresh{data.size() - m_seen.size()};
+  if (fresh == 0)
+    return;
+
+  // Only the new samples go through the transform
+  const Index added{m_stft.process(Eigen::Map<const RowMajorMatrixXd>(
+      data.data() + m_seen.size(), 1, fresh))};
+  m_seen = data;
+
+  const RowMajorMatrixXd& frames{m_stft.frames()};
+  for (Index f{0}; f < added; ++f) {
+    for (Index b{m_stft.bins()}; b-- > 0;) {
+      const double db{10 * std::log10(std::max(frames(f, b), 1e-300))};
+      m_image.push_back(db);
+      m_peakDb = std::max(m_peakDb, db);
+    }
+  }
+  m_columns += static_cast<int>(added);
+
+  // Keep the latest columns
+  if (m_columns > kMaxSpectrogramColumns) {
+    const int dropped{m_columns - kMaxSpectrogramColumns};
+    m_image.erase(m_image.begin(),
+                  m_image.begin() + dropped * m_stft.bins());
+    m_columns = kMaxSpectrogramColumns;
+    m_dropped += dropped;
+  }
+}
+
+void SpectrogramNode::render() {
+  using namespace Constants;
+
+  ImGui::Text("Parameters:");
+  static constexpr const char* windows[] = {"Rectangular", "Hann", "Hamming",
+                                            "Blackman", "Kaiser"};
+
+  int windowIdx = static_cast<int>(m_window);
+  if (ImGui::Combo("Window", &windowIdx, windows, Filter::maxWindow)) {
+    m_window = static_cast<Filter::Window>(windowIdx);
+    m_stale  = true;
+  }
+
+  if (ImGui::SliderInt("Length", &m_windowLength, kMinStftLength,
+                       kMaxStftLength)) {
+    m_hop   = std::min(m_hop, m_windowLength);
+    m_stale = true;
+  }
+  if (ImGui::SliderInt("Hop", &m_hop, 1, m_windowLength))
+    m_stale = true;
+  if (ImGui::InputDouble("fs (Hz)", &m_samplingFreq, 10.0, 100.0, "%.2f")) {
+    m_samplingFreq = std::max(m_samplingFreq, 1.0);
+    m_stale        = true;
+  }
+
+  auto data{inputValue<Eigen::ArrayXd>("In")};
+  if (data.size() == 0) {
+    ImGui::Text("No data connected.");
+    return;
+  }
+  update(data);
+
+  ImGui::BeginTabBar("Plots");
+  if (ImGui::BeginTabItem("Spectrogram")) {
+    const double t0{m_dropped * m_hop / m_samplingFreq};
+    const double t1{t0 + m_columns * m_hop / m_samplingFreq};
+
+    ImPlot::PushColormap(ImPlotColormap_Viridis);
+    if (ImPlot::BeginPlot("Spectrogram", ImVec2{kPlotWidth, kPlotHeight})) {
+      ImPlot::SetupAxes("Time (s)", "Frequency (Hz)");
+      if (m_columns > 0) {
+        ImPlot::PlotHeatmap("##Spectrogram", m_image.data(),
+                            static_cast<int>(m_stft.bins()), m_columns,
+                            m_peakDb - kSpectrogramDynamicRange, m_peakDb,
+                            nullptr, ImPlotPoint{t0, 0.0},
+                            ImPlotPoint{t1, m_samplingFreq / 2},
+                            ImPlotHeatmapFlags_ColMajor);
+      }
+      ImPlot::EndPlot();
+    }
+    ImPlot::PopColormap();
+    ImGui::EndTabItem();
+  }
+  if (ImGui::BeginTabItem("PSD")) {
+    if (ImPlot::BeginPlot("Welch PSD", ImVec2{kPlotWidth, kPlotHeight})) {
+      auto x{m_stft.frequencies()};
+      Eigen::ArrayXd psd{
+          10 * m_stft.psd().row(0).transpose().array().max(1e-300).log10()};
+      ImPlot::SetupAxis(ImAxis_X1, "Frequency (Hz)");
+      ImPlot::SetupAxis(ImAxis_Y1, "PSD (dB/Hz)");
+
+      ImPlot::PlotLine("", x.data(), psd.data(), static_cast<int>(psd.size()));
+      ImPlot::EndPlot();
+    }
+    ImGui::EndTabItem();
+  }
+  ImGui::EndTabBar();
+  ImGui::Text("Frames: %d", static_cast<int>(m_stft.averaged()));
+}
+
+nlohmann::json SpectrogramNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "SpectrogramNode";
+  j["parameters"]  = {
+      {"window", static_cast<int>(m_window)},
+      {"length",              m_windowLength},
+      {   "hop",                       m_hop},
+      {    "fs",              m_samplingFreq},
+  };
+
+  return j;
+}
+
+// ToneTrackerNode
+ToneTrackerNode::ToneTrackerNode(const std::string_view name,
+                                 const int harmonics, const double fundamental,
+                                 const int periods, const double samplingFreq)
+    : Node{name, "Tone Tracker"}, m_harmonics{harmonics},
+      m_fundamental{fundamental}, m_periods{std::max(periods, 1)},
+      m_samplingFreq{std::max(samplingFreq, 1.0)} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+
+  for (int i{0}; i < m_harmonics; ++i) {
+    addOutput<Eigen::ArrayXd>("Amplitude " + std::to_string(i + 1),
+                              [this, i]() {
+                                track();
+                                return Eigen::ArrayXd{
+                                    m_amplitude.row(i).transpose()};
+                              });
+  }
+  for (int i{0}; i < m_harmonics; ++i) {
+    addOutput<Eigen::ArrayXd>("Phase " + std::to_string(i + 1), [this, i]() {
+      track();
+      return Eigen::ArrayXd{m_phase.row(i).transpose()};
+    });
+  }
+}
+
+int ToneTrackerNode::windowLength() const {
+  return std::max(1, static_cast<int>(std::lround(m_periods * m_samplingFreq /
+                                                  m_fundamental)));
+}
+
+void ToneTrackerNode::track() {
+  // Every output is pulled each frame; the tracker runs once for all
+  const std::size_t frame{graph()->frame()};
+  if (m_hasOutput && m_outputFrame == frame)
+    return;
+
+  if (m_stale) {
+    const Eigen::ArrayXd harmonics{
+        m_fundamental *
+        Eigen::ArrayXd::LinSpaced(m_harmonics, 1.0, m_harmonics)};
+    m_tracker = SlidingDft{harmonics, m_samplingFreq, windowLength()};
+    m_stale   = false;
+  }
+
+  // Each frame tracks the whole input afresh
+  const auto data{inputValue<Eigen::ArrayXd>("In")};
+  m_amplitude.resize(m_harmonics, data.size());
+  m_phase.resize(m_harmonics, data.size());
+
+  m_tracker.reset();
+  m_tracker.process(
+      Eigen::Map<const RowMajorMatrixXd>(data.data(), 1, data.size()),
+      m_amplitude, m_phase);
+  m_outputFrame = frame;
+  m_hasOutput   = true;
+}
+
+void ToneTrackerNode::render() {
+  using namespace Constants;
+
+  ImGui::Text("Parameters:");
+  if (ImGui::SliderDouble("f0 (Hz)", &m_fundamental, 1.0,
+                          m_samplingFreq / (2 * m_harmonics), "%.2f"))
+    m_stale = true;
+  if (ImGui::SliderInt("Periods", &m_periods, 1, kMaxTonePeriods))
+    m_stale = true;
+  if (ImGui::SliderDouble("fs (Hz)", &m_samplingFreq, 10.0, 10000.0,
+                          "%.1f"))
+    m_stale = true;
+  ImGui::Text("Window: %d samples", windowLength());
+
+  track();
+  if (m_amplitude.cols() == 0) {
+    ImGui::Text("No data connected.");
+    return;
+  }
+
+  // Latest estimate of each harmonic
+  const Index last{m_amplitude.cols() - 1};
+  for (int i{0}; i < m_harmonics; ++i) {
+    ImGui::Text("%.1f Hz: %.4g, %.3f rad", m_fundamental * (i + 1),
+                m_amplitude(i, last), m_phase(i, last));
+  }
+}
+
+nlohmann::json ToneTrackerNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "ToneTrackerNode";
+  j["parameters"]  = {
+      {  "harmonics",    m_harmonics},
+      {"fundamental",  m_fundamental},
+      {    "periods",      m_periods},
+      {         "fs", m_samplingFreq},
+  };
+
+  return j;
+}
+
+// SmoothingNode
+SmoothingNode::SmoothingNode(const std::string_view name, const Method method,
+                             const int windowLength, const double alpha,
+                             const int stages, const int decimation)
+    : Node{name, "Smoothing"}, m_method{method},
+      m_windowLength{std::max(windowLength, 1)},
+      m_alpha{std::clamp(alpha, 1e-6, 1.0)}, m_stages{std::max(stages, 1)},
+      m_decimation{std::max(decimation, 1)} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+  addOutput<Eigen::ArrayXd>("Out", [this]() {
+    auto inputData{inputValue<Eigen::ArrayXd>("In")};
+    const Eigen::Map<const RowMajorMatrixXd> x(inputData.data(), 1,
+                                               inputData.size());
+
+    // Each pull smooths the whole input afresh
+    RowMajorMatrixXd y(1, inputData.size());
+    switch (m_method) {
+    case exponential:
+      ExponentialAverage{m_alpha}.process(x, y);
+      break;
+    case cic:
+      y = CicDecimator{m_decimation, m_stages}.process(x);
+      break;
+    default:
+      MovingAverage{m_windowLength}.process(x, y);
+      break;
+    }
+
+    return Eigen::ArrayXd{y.row(0).transpose()};
+  });
+}
+
+void SmoothingNode::render() {
+  using namespace Constants;
+
+  ImGui::Text("Parameters:");
+  static constexpr const char* methods[] = {"Moving average", "Exponential",
+                                            "CIC decimator"};
+
+  int methodIdx = static_cast<int>(m_method);
+  if (ImGui::Combo("Method", &methodIdx, methods, maxMethod)) {
+    m_method = static_cast<Method>(methodIdx);
+  }
+
+  switch (m_method) {
+  case exponential:
+    ImGui::SliderDouble("Alpha", &m_alpha, 1e-4, 1.0, "%.4f",
+                        ImGuiSliderFlags_Logarithmic);
+    break;
+  case cic:
+    ImGui::SliderInt("Stages", &m_stages, 1, kMaxCicStages);
+    ImGui::SliderInt("Decimation", &m_decimation, 1, kMaxCicDecimation);
+    break;
+  default:
+    ImGui::SliderInt("Window", &m_windowLength, 1, kMaxSmoothingWindow);
+    break;
+  }
+}
+
+nlohmann::json SmoothingNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "SmoothingNode";
+  j["parameters"]  = {
+      {    "method", static_cast<int>(m_method)},
+      {    "window",             m_windowLength},
+      {     "alpha",                    m_alpha},
+      {    "stages",                   m_stages},
+      {"decimation",               m_decimation},
+  };
+
+  return j;
+}
+
+// RunningStatsNode
+RunningStatsNode::RunningStatsNode(const std::string_view name,
+                                   const int              windowLength)
+    : Node{name, "Running Stats"}, m_windowLength{std::max(windowLength, 1)} {
+  addInput<Eigen::ArrayXd>("In", Eigen::ArrayXd{});
+
+  const char* outputs[]{"Mean", "Variance", "RMS"};
+  for (int i{0}; i < 3; ++i) {
+    addOutput<Eigen::ArrayXd>(outputs[i], [this, i]() {
+      update();
+      return Eigen::ArrayXd{m_stats.row(i).transpose()};
+    });
+  }
+}
+
+void RunningStatsNode::update() {
+  // Every output is pulled each frame; the statistics run once for all
+  const std::size_t frame{graph()->frame()};
+  if (m_hasOutput && m_outputFrame == frame)
+    return;
+
+  const auto data{inputValue<Eigen::ArrayXd>("In")};
+  const Eigen::Map<const RowMajorMatrixXd> x(data.data(), 1, data.size());
+
+  m_stats.resize(3, data.size());
+  RunningStats{m_windowLength}.process(x, m_stats.row(0), m_stats.row(1),
+                                       m_stats.row(2));
+  m_outputFrame = frame;
+  m_hasOutput   = true;
+}
+
+void RunningStatsNode::render() {
+  ImGui::Text("Parameters:");
+  ImGui::SliderInt("Window", &m_windowLength, 1,
+                   Constants::kMaxSmoothingWindow);
+}
+
+nlohmann::json RunningStatsNode::serialize() const {
+  nlohmann::json j = Node::serialize();
+  j["type"]        = "RunningStatsNode";
+  j["parameters"]  = {
+      {"window", m_windowLength},
+  };
 
   return j;
 }
@@ -507,6 +1054,25 @@ void renderNodeMenu(Graph& graph) {
   if (ImGui::MenuItem("Filter"))
     graph.createNode<FilterNode>(nodeName);
 
+  if (ImGui::MenuItem("Filter Bank")) {
+    s_pendingBankNodeName = nodeName;
+    s_openBankModal       = true;
+  }
+
+  if (ImGui::MenuItem("Resample"))
+    graph.createNode<ResampleNode>(nodeName);
+
+  if (ImGui::MenuItem("Smoothing"))
+    graph.createNode<SmoothingNode>(nodeName);
+
+  if (ImGui::MenuItem("Running Stats"))
+    graph.createNode<RunningStatsNode>(nodeName);
+
+  if (ImGui::MenuItem("Tone Tracker")) {
+    s_pendingToneNodeName = nodeName;
+    s_openToneModal       = true;
+  }
+
   if (ImGui::MenuItem("Viewer"))
     graph.createNode<ViewerNode>(nodeName);
 
@@ -514,6 +1080,9 @@ void renderNodeMenu(Graph& graph) {
     s_pendingMultiViewerNodeName = nodeName;
     s_openMultiViewerModal       = true;
   }
+
+  if (ImGui::MenuItem("Spectrogram"))
+    graph.createNode<SpectrogramNode>(nodeName);
 }
 
 void graphWindow(Graph& graph) {
@@ -694,6 +1263,39 @@ void graphWindow(Graph& graph) {
     ImGui::EndPopup();
   }
 
+  if (s_openBankModal) {
+    ImGui::OpenPopup("Filter Bank Bands");
+    s_openBankModal = false;
+  }
+  if (ImGui::BeginPopupModal("Filter Bank Bands", nullptr,
+                             ImGuiWindowFlags_AlwaysAutoResize)) {
+    ImGui::SliderInt("Number of bands", &s_bankBands, 1,
+                     Constants::kMaxBankBands);
+    if (ImGui::Button("Ok")) {
+      graph.createNode<FilterBankNode>(s_pendingBankNodeName, s_bankBands);
+      s_pendingBankNodeName.clear();
+      ImGui::CloseCurrentPopup();
+    }
+    ImGui::EndPopup();
+  }
+
+  if (s_openToneModal) {
+    ImGui::OpenPopup("Tone Tracker Harmonics");
+    s_openToneModal = false;
+  }
+  if (ImGui::BeginPopupModal("Tone Tracker Harmonics", nullptr,
+                             ImGuiWindowFlags_AlwaysAutoResize)) {
+    ImGui::SliderInt("Number of harmonics", &s_toneHarmonics, 1,
+                     Constants::kMaxToneHarmonics);
+    if (ImGui::Button("Ok")) {
+      graph.createNode<ToneTrackerNode>(s_pendingToneNodeName,
+                                        s_toneHarmonics);
+      s_pendingToneNodeName.clear();
+      ImGui::CloseCurrentPopup();
+    }
+    ImGui::EndPopup();
+  }
+
   if (s_openMultiViewerModal) {
     ImGui::OpenPopup("Multi-Viewer Inputs");
     s_openMultiViewerModal = false;
@@ -78,9 +78,130 @@ Core::Node* createFilter(Core::Graph& graph, const std::string& nodeName,
       params.contains("fs") ? params["fs"].get<double>() : kDefaultSamplingFreq;
   double cutoffFreq2 = params.contains("fc2") ? params["fc2"].get<double>()
                                               : kDefaultCutoffFreq2;
+  bool   fromSpec    = params.contains("fromSpec")
+                           ? params["fromSpec"].get<bool>()
+                           : false;
+
+  Filter::FilterSpec spec{kDefaultFilterSpec};
+  if (params.contains("spec")) {
+    const auto& s{params["spec"]};
+    const auto  read{[&s](const char* key, const double fallback) {
+      return s.contains(key) ? s[key].get<double>() : fallback;
+    }};
+
+    spec.passFreq        = read("fpass", spec.passFreq);
+    spec.stopFreq        = read("fstop", spec.stopFreq);
+    spec.passFreq2       = read("fpass2", spec.passFreq2);
+    spec.stopFreq2       = read("fstop2", spec.stopFreq2);
+    spec.passRipple      = read("rp", spec.passRipple);
+    spec.stopAttenuation = read("rs", spec.stopAttenuation);
+  }
 
   return graph.createNode<FilterNode>(nodeName, mode, type, order, cutoffFreq,
-                                      samplingFreq, cutoffFreq2);
+                                      samplingFreq, cutoffFreq2, fromSpec,
+                                      spec);
+}
+
+Core::Node* createFilterBank(Core::Graph& graph, const std::string& nodeName,
+                             const nlohmann::json& params) {
+  using namespace Constants;
+
+  int  bands = params.contains("bands") ? params["bands"].get<int>()
+                                        : kDefaultBankBands;
+  auto type  = params.contains("type")
+                   ? static_cast<Filter::Type>(params["type"].get<int>())
+                   : kDefaultFilterType;
+  int  order = params.contains("order") ? params["order"].get<int>()
+                                        : kDefaultFilterOrder;
+  double lowFreq  = params.contains("low") ? params["low"].get<double>()
+                                           : kDefaultBankLowFreq;
+  double highFreq = params.contains("high") ? params["high"].get<double>()
+                                            : kDefaultBankHighFreq;
+  double samplingFreq =
+      params.contains("fs") ? params["fs"].get<double>() : kDefaultSamplingFreq;
+
+  return graph.createNode<FilterBankNode>(nodeName, bands, type, order,
+                                          lowFreq, highFreq, samplingFreq);
+}
+
+Core::Node* createResample(Core::Graph& graph, const std::string& nodeName,
+                           const nlohmann::json& params) {
+  using namespace Constants;
+
+  int up =
+      params.contains("up") ? params["up"].get<int>() : kDefaultResampleUp;
+  int down = params.contains("down") ? params["down"].get<int>()
+                                     : kDefaultResampleDown;
+
+  return graph.createNode<ResampleNode>(nodeName, up, down);
+}
+
+Core::Node* createSpectrogram(Core::Graph& graph, const std::string& nodeName,
+                              const nlohmann::json& params) {
+  using namespace Constants;
+
+  auto window = params.contains("window")
+                    ? static_cast<Filter::Window>(params["window"].get<int>())
+                    : kDefaultStftWindow;
+  int  length = params.contains("length") ? params["length"].get<int>()
+                                          : kDefaultStftLength;
+  int  hop =
+      params.contains("hop") ? params["hop"].get<int>() : kDefaultStftHop;
+  double samplingFreq =
+      params.contains("fs") ? params["fs"].get<double>() : kDefaultSamplingFreq;
+
+  return graph.createNode<SpectrogramNode>(nodeName, window, length, hop,
+                                           samplingFreq);
+}
+
+Core::Node* createToneTracker(Core::Graph& graph, const std::string& nodeName,
+                              const nlohmann::json& params) {
+  using namespace Constants;
+
+  int harmonics = params.contains("harmonics")
+                      ? params["harmonics"].get<int>()
+                      : kDefaultToneHarmonics;
+  double fundamental = params.contains("fundamental")
+                           ? params["fundamental"].get<double>()
+                           : kDefaultToneFrequency;
+  int periods = params.contains("periods") ? params["periods"].get<int>()
+                                           : kDefaultTonePeriods;
+  double samplingFreq =
+      params.contains("fs") ? params["fs"].get<double>() : kDefaultSamplingFreq;
+
+  return graph.createNode<ToneTrackerNode>(nodeName, harmonics, fundamental,
+                                           periods, samplingFreq);
+}
+
+Core::Node* createSmoothing(Core::Graph& graph, const std::string& nodeName,
+                            const nlohmann::json& params) {
+  using namespace Constants;
+
+  auto method = params.contains("method")
+                    ? static_cast<SmoothingNode::Method>(
+                          params["method"].get<int>())
+                    : SmoothingNode::movingAverage;
+  int window = params.contains("window") ? params["window"].get<int>()
+                                         : kDefaultSmoothingWindow;
+  double alpha = params.contains("alpha") ? params["alpha"].get<double>()
+                                          : kDefaultSmoothingAlpha;
+  int stages = params.contains("stages") ? params["stages"].get<int>()
+                                         : kDefaultCicStages;
+  int decimation = params.contains("decimation")
+                       ? params["decimation"].get<int>()
+                       : kDefaultCicDecimation;
+
+  return graph.createNode<SmoothingNode>(nodeName, method, window, alpha,
+                                         stages, decimation);
+}
+
+Core::Node* createRunningStats(Core::Graph& graph, const std::string& nodeName,
+                               const nlohmann::json& params) {
+  int window = params.contains("window")
+                   ? params["window"].get<int>()
+                   : Constants::kDefaultSmoothingWindow;
+
+  return graph.createNode<RunningStatsNode>(nodeName, window);
 }
 
 Core::Node* createViewer(Core::Graph& graph, const std::string& nodeName,
@@ -116,13 +237,19 @@ Core::Node* createCSV(Core::Graph& graph, const std::string& nodeName,
 static const std::map<std::string, NodeFactory>& getNodeFactories() {
   using namespace Constants;
   static const std::map<std::string, NodeFactory> factories = {
-      { "RandomDataNode",      createRandom},
-      {       "SineNode",        createSine},
-      {      "MixerNode",       createMixer},
-      {     "FilterNode",      createFilter},
-      {     "ViewerNode",      createViewer},
-      {        "CSVNode",         createCSV},
-      {"MultiViewerNode", createMultiViewer},
+      {  "RandomDataNode",       createRandom},
+      {        "SineNode",         createSine},
+      {       "MixerNode",        createMixer},
+      {      "FilterNode",       createFilter},
+      {  "FilterBankNode",   createFilterBank},
+      {    "ResampleNode",     createResample},
+      { "SpectrogramNode",  createSpectrogram},
+      { "ToneTrackerNode",  createToneTracker},
+      {   "SmoothingNode",    createSmoothing},
+      {"RunningStatsNode", createRunningStats},
+      {      "ViewerNode",       createViewer},
+      {         "CSVNode",          createCSV},
+      { "MultiViewerNode",  createMultiViewer},
   };
 
   return factories;
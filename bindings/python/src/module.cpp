@@ -1,9 +1,27 @@
+#include "Averaging.h"
+#include "BatchDesign.h"
+#include "Convolution.h"
+#include "DesignCache.h"
 #include "Filter.h"
+#include "FilterBank.h"
+#include "FilterDispatch.h"
 #include "FilterEigen.h"
+#include "FilterOrder.h"
+#include "Fir.h"
+#include "FixedPoint.h"
+#include "Resample.h"
+#include "SlidingDft.h"
+#include "Stft.h"
+#include "StreamingFilter.h"
+#include <algorithm>
+#include <array>
 #include <complex>
+#include <cstdint>
+#include <optional>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <tuple>
 #include <vector>
 
 namespace py = pybind11;
@@ -13,6 +31,127 @@ lfilter_multi(py::array_t<double, py::array::c_style | py::array::forcecast> b,
               py::array_t<double, py::array::c_style | py::array::forcecast> a,
               py::array_t<double, py::array::c_style | py::array::forcecast> x);
 
+// sos is (sections, 6), shared by every channel, or (channels, sections, 6)
+py::array_t<double> sosfilt_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> sos,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x);
+
+py::array_t<double> filtfilt_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> b,
+    py::array_t<double, py::array::c_style | py::array::forcecast> a,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    const Nodex::Filter::Index padlen);
+
+py::array_t<double> resample_poly_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    const Nodex::Filter::Index up, const Nodex::Filter::Index down);
+
+// Single precision entry points take float32 arrays without conversion
+using FloatArray = py::array_t<float, py::array::c_style>;
+
+FloatArray lfilter_f32(const std::vector<double>& b,
+                       const std::vector<double>& a, FloatArray x,
+                       const bool double_accumulation);
+
+FloatArray lfilter_multi_f32(const std::vector<double>& b,
+                             const std::vector<double>& a, FloatArray x);
+
+FloatArray fft_filter_f32(const std::vector<double>& b,
+                          const std::vector<double>& a, FloatArray x,
+                          const double epsilon, const std::size_t max_length);
+
+Nodex::Filter::SosArray sos_array(const Nodex::Filter::SOS& sos);
+
+// One row per band
+py::array_t<double> filter_bank(
+    const std::vector<Nodex::Filter::SOS>&                         bands,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x);
+
+py::array_t<double> filter_bank_process(
+    Nodex::Filter::FilterBank&                                     bank,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x);
+
+// Filters x into out when given (no allocation), else into a new array
+py::array_t<double, py::array::c_style> streaming_process(
+    Nodex::Filter::StreamingFilter&                                filter,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    std::optional<py::array_t<double, py::array::c_style>>         out);
+
+// New frames of x (one row per channel, or 1D for a single channel), as a
+// (frames, channels, bins) array
+py::array_t<double> stft_process(
+    Nodex::Filter::Stft&                                           stft,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x);
+
+// Amplitude and phase after each sample of x (one row per channel, or 1D),
+// each a (channels, frequencies, samples) array
+std::tuple<py::array_t<double>, py::array_t<double>> sliding_dft_process(
+    Nodex::Filter::SlidingDft&                                     tracker,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x);
+
+// Copies a row-major matrix into a new 2D array
+py::array_t<double> to_array(const Nodex::Filter::RowMajorMatrixXd& m);
+
+// Samples of one channel (1D) or several (2D, one row per channel)
+using ChannelArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// x as (channels, samples)
+Eigen::Map<const Nodex::Filter::RowMajorMatrixXd>
+channel_rows(const ChannelArray& x);
+
+// A new array with the channels of x and the given number of samples (1D
+// when x is 1D)
+py::array_t<double> shaped_like(const ChannelArray& x,
+                                const Nodex::Filter::Index samples);
+
+// Runs a streaming smoother over x; the output has the shape of x
+template <typename Smoother>
+py::array_t<double> smooth(Smoother& smoother, ChannelArray x);
+
+py::array_t<double> cic_process(Nodex::Filter::CicDecimator& cic,
+                                ChannelArray                 x);
+
+// (mean, variance, rms), each with the shape of x
+using StatsTuple = std::tuple<py::array_t<double>, py::array_t<double>,
+                              py::array_t<double>>;
+
+StatsTuple running_stats_process(Nodex::Filter::RunningStats& stats,
+                                 ChannelArray                 x);
+
+// (z, p, k, counts, sos, sections) of every design, padded to the largest
+using BatchTuple =
+    std::tuple<py::array_t<std::complex<double>>,
+               py::array_t<std::complex<double>>, py::array_t<double>,
+               py::array_t<Nodex::Filter::Index>, py::array_t<double>,
+               py::array_t<Nodex::Filter::Index>>;
+
+// Parameters of length 1 are shared by every design
+BatchTuple iirfilter_batch(
+    py::array_t<int, py::array::c_style | py::array::forcecast>    n,
+    py::array_t<double, py::array::c_style | py::array::forcecast> fc,
+    const double fs, const Nodex::Filter::Type type,
+    const Nodex::Filter::Mode                                      mode,
+    py::array_t<double, py::array::c_style | py::array::forcecast> fc2,
+    py::array_t<double, py::array::c_style | py::array::forcecast> ripple,
+    const double attenuation);
+
+// Binds an order estimator taking the spec as keyword arguments
+void bind_order(py::module_& m, const char* name,
+                Nodex::Filter::OrderEstimate (*estimate)(
+                    const Nodex::Filter::FilterSpec&));
+
+// Binds FixedSosFilter<Sample> as a class taking and returning Sample arrays
+template <typename Sample>
+void bind_fixed_sos(py::module_& m, const char* name);
+
+// (w, h, magnitude, phase, group delay)
+using ResponseTuple =
+    std::tuple<std::vector<double>, std::vector<std::complex<double>>,
+               std::vector<double>, std::vector<double>, std::vector<double>>;
+
+ResponseTuple response_tuple(const Nodex::Filter::FrequencyResponse& r);
+
 PYBIND11_MODULE(pynodex, m, py::mod_gil_not_used()) {
   using Nodex::Filter::Signal;
 
@@ -33,9 +172,504 @@ PYBIND11_MODULE(pynodex, m, py::mod_gil_not_used()) {
          const Signal& x) { return Nodex::Filter::linearFilter({b, a}, x); },
       py::arg("b"), py::arg("a"), py::arg("x"));
 
+  m.def(
+      "lfilter_parallel",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const Signal& x, const std::size_t blocks) {
+        return Nodex::Filter::parallelLinearFilter({b, a}, x, blocks);
+      },
+      py::arg("b"), py::arg("a"), py::arg("x"), py::arg("blocks") = 0);
+
+  // b and a are 1-D (shared) or 2-D (one row of coefficients per channel)
   m.def("lfilter_multi", &lfilter_multi, py::arg("b"), py::arg("a"),
         py::arg("x"));
 
+  m.def("sosfilt_multi", &sosfilt_multi, py::arg("sos"), py::arg("x"));
+
+  m.def("lfilter_f32", &lfilter_f32, py::arg("b"), py::arg("a"),
+        py::arg("x").noconvert(), py::arg("double_accumulation") = true);
+
+  m.def("lfilter_multi_f32", &lfilter_multi_f32, py::arg("b"), py::arg("a"),
+        py::arg("x").noconvert());
+
+  m.def("fft_filter_f32", &fft_filter_f32, py::arg("b"), py::arg("a"),
+        py::arg("x").noconvert(), py::arg("epsilon") = 1e-12,
+        py::arg("max_length") = 10000);
+
+  m.def(
+      "filtfilt",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const Signal& x, const int padlen) {
+        return Nodex::Filter::filtFilt({b, a}, x, padlen);
+      },
+      py::arg("b"), py::arg("a"), py::arg("x"), py::arg("padlen") = -1);
+
+  m.def("filtfilt_multi", &filtfilt_multi, py::arg("b"), py::arg("a"),
+        py::arg("x"), py::arg("padlen") = -1);
+
+  m.def(
+      "sosfilt",
+      [](const Nodex::Filter::SOS& sos, const Signal& x) {
+        return Nodex::Filter::sosFilter(sos, x);
+      },
+      py::arg("sos"), py::arg("x"));
+
+  m.def(
+      "sosfiltfilt",
+      [](const Nodex::Filter::SOS& sos, const Signal& x, const int padlen) {
+        return Nodex::Filter::filtFilt(sos, x, padlen);
+      },
+      py::arg("sos"), py::arg("x"), py::arg("padlen") = -1);
+
+  py::enum_<Nodex::Filter::FilterStrategy>(m, "FilterStrategy")
+      .value("time_domain", Nodex::Filter::timeDomain)
+      .value("fft_convolution", Nodex::Filter::fftConvolution);
+
+  py::class_<Nodex::Filter::FilterCostModel>(m, "FilterCostModel")
+      .def(py::init<>())
+      .def_readwrite("sample_cost",
+                     &Nodex::Filter::FilterCostModel::sampleCost)
+      .def_readwrite("state_cost", &Nodex::Filter::FilterCostModel::stateCost)
+      .def_readwrite("section_cost",
+                     &Nodex::Filter::FilterCostModel::sectionCost)
+      .def_readwrite("fft_cost", &Nodex::Filter::FilterCostModel::fftCost);
+
+  m.def("filter_cost_model", &Nodex::Filter::filterCostModel);
+
+  m.def("set_filter_cost_model", &Nodex::Filter::setFilterCostModel,
+        py::arg("model"));
+
+  m.def("calibrate_filter", &Nodex::Filter::calibrateFilterCostModel,
+        py::arg("length") = 1 << 15);
+
+  // Picks lfilter or fft_filter from the cost model
+  m.def(
+      "filter",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const Signal& x, const double epsilon,
+         const Nodex::Filter::Index max_length) {
+        return Nodex::Filter::filter({b, a}, x, epsilon, max_length);
+      },
+      py::arg("b"), py::arg("a"), py::arg("x"), py::arg("epsilon") = 1e-12,
+      py::arg("max_length") = 10000);
+
+  m.def(
+      "filter_sos",
+      [](const Nodex::Filter::SOS& sos, const Signal& x, const double epsilon,
+         const Nodex::Filter::Index max_length) {
+        using Nodex::Filter::ArrayXd;
+        using Nodex::Filter::Index;
+
+        const ArrayXd y{Nodex::Filter::filter(
+            sos_array(sos),
+            Eigen::Map<const ArrayXd>(x.data(), static_cast<Index>(x.size())),
+            epsilon, max_length)};
+        return Signal(y.begin(), y.end());
+      },
+      py::arg("sos"), py::arg("x"), py::arg("epsilon") = 1e-12,
+      py::arg("max_length") = 10000);
+
+  // (strategy, effective IR length, predicted time and FFT costs in ns)
+  m.def(
+      "filter_plan",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const Nodex::Filter::Index length, const double epsilon,
+         const Nodex::Filter::Index max_length) {
+        Nodex::Filter::Coeffs coeffs{b, a};
+        const auto            plan{Nodex::Filter::planFilter(
+            Nodex::Filter::EigenCoeffs{coeffs}, length, epsilon, max_length)};
+        return std::make_tuple(plan.strategy, plan.irLength, plan.timeCost,
+                               plan.fftCost);
+      },
+      py::arg("b"), py::arg("a"), py::arg("length"), py::arg("epsilon") = 1e-12,
+      py::arg("max_length") = 10000);
+
+  m.def(
+      "zpk2sos",
+      [](const std::vector<std::complex<double>>& z,
+         const std::vector<std::complex<double>>& p, const double k) {
+        return Nodex::Filter::zpk2sos(Nodex::Filter::ZPK{z, p, k});
+      },
+      py::arg("z"), py::arg("p"), py::arg("k"));
+
+  m.def(
+      "resample_poly",
+      [](const Signal& x, const Nodex::Filter::Index up,
+         const Nodex::Filter::Index down) {
+        return Nodex::Filter::resamplePoly(x, up, down);
+      },
+      py::arg("x"), py::arg("up"), py::arg("down"));
+
+  m.def("resample_poly_multi", &resample_poly_multi, py::arg("x"),
+        py::arg("up"), py::arg("down"));
+
+  m.def(
+      "upfirdn",
+      [](const std::vector<double>& h, const Signal& x,
+         const Nodex::Filter::Index up, const Nodex::Filter::Index down) {
+        using Nodex::Filter::ArrayXd;
+        using Nodex::Filter::Index;
+
+        const ArrayXd y{Nodex::Filter::upfirdn(
+            Eigen::Map<const ArrayXd>(h.data(), static_cast<Index>(h.size())),
+            Eigen::Map<const ArrayXd>(x.data(), static_cast<Index>(x.size())),
+            up, down)};
+        return Signal(y.begin(), y.end());
+      },
+      py::arg("h"), py::arg("x"), py::arg("up") = 1, py::arg("down") = 1);
+
+  m.def("filter_bank", &filter_bank, py::arg("sos"), py::arg("x"));
+
+  py::class_<Nodex::Filter::FilterBank>(m, "FilterBank")
+      .def(py::init([](const std::vector<Nodex::Filter::SOS>& bands) {
+             std::vector<Nodex::Filter::SosArray> sos{};
+             for (const auto& band : bands)
+               sos.push_back(sos_array(band));
+             return Nodex::Filter::FilterBank{sos};
+           }),
+           py::arg("sos"))
+      .def("process", &filter_bank_process, py::arg("x"))
+      .def("reset", &Nodex::Filter::FilterBank::reset)
+      .def_property_readonly("bands", &Nodex::Filter::FilterBank::bands);
+
+  py::class_<Nodex::Filter::PolyphaseResampler>(m, "PolyphaseResampler")
+      .def(py::init<Nodex::Filter::Index, Nodex::Filter::Index>(),
+           py::arg("up"), py::arg("down"))
+      .def(
+          "process",
+          [](Nodex::Filter::PolyphaseResampler& self, const Signal& x) {
+            return self.process(x);
+          },
+          py::arg("x"))
+      .def("reset", &Nodex::Filter::PolyphaseResampler::reset)
+      .def_property_readonly("up", &Nodex::Filter::PolyphaseResampler::up)
+      .def_property_readonly("down", &Nodex::Filter::PolyphaseResampler::down);
+
+  py::enum_<Nodex::Filter::Type>(m, "FilterType")
+      .value("butter", Nodex::Filter::butter)
+      .value("cheb1", Nodex::Filter::cheb1)
+      .value("cheb2", Nodex::Filter::cheb2)
+      .value("ellip", Nodex::Filter::ellip);
+
+  py::enum_<Nodex::Filter::Mode>(m, "FilterMode")
+      .value("lowpass", Nodex::Filter::lowpass)
+      .value("highpass", Nodex::Filter::highpass)
+      .value("bandpass", Nodex::Filter::bandpass)
+      .value("bandstop", Nodex::Filter::bandstop);
+
+  // Designs go through the process-wide design cache
+  m.def(
+      "iirfilter",
+      [](const int n, const double fc, const double fs,
+         const Nodex::Filter::Type type, const Nodex::Filter::Mode mode,
+         const double fc2, const double ripple, const double attenuation) {
+        const auto design{Nodex::Filter::DesignCache::global().get(
+            {type, mode, n, fc, fc2, fs, ripple, attenuation})};
+        return std::make_tuple(design->zpk.z, design->zpk.p, design->zpk.k);
+      },
+      py::arg("n"), py::arg("fc"), py::arg("fs"),
+      py::arg("type") = Nodex::Filter::butter,
+      py::arg("mode") = Nodex::Filter::lowpass, py::arg("fc2") = 0.0,
+      py::arg("ripple") = 5.0, py::arg("attenuation") = 40.0);
+
+  m.def(
+      "iirfilter_ba",
+      [](const int n, const double fc, const double fs,
+         const Nodex::Filter::Type type, const Nodex::Filter::Mode mode,
+         const double fc2, const double ripple, const double attenuation) {
+        const auto design{Nodex::Filter::DesignCache::global().get(
+            {type, mode, n, fc, fc2, fs, ripple, attenuation})};
+        const auto& tf{design->tf};
+        return std::make_tuple(
+            std::vector<double>(tf.b.data(), tf.b.data() + tf.b.size()),
+            std::vector<double>(tf.a.data(), tf.a.data() + tf.a.size()));
+      },
+      py::arg("n"), py::arg("fc"), py::arg("fs"),
+      py::arg("type") = Nodex::Filter::butter,
+      py::arg("mode") = Nodex::Filter::lowpass, py::arg("fc2") = 0.0,
+      py::arg("ripple") = 5.0, py::arg("attenuation") = 40.0);
+
+  m.def(
+      "iirfilter_sos",
+      [](const int n, const double fc, const double fs,
+         const Nodex::Filter::Type type, const Nodex::Filter::Mode mode,
+         const double fc2, const double ripple, const double attenuation) {
+        const auto design{Nodex::Filter::DesignCache::global().get(
+            {type, mode, n, fc, fc2, fs, ripple, attenuation})};
+        Nodex::Filter::SOS sos(static_cast<std::size_t>(design->sos.rows()));
+        for (std::size_t i{0}; i < sos.size(); ++i) {
+          for (std::size_t j{0}; j < 6; ++j) {
+            sos[i][j] = design->sos(static_cast<Nodex::Filter::Index>(i),
+                                    static_cast<Nodex::Filter::Index>(j));
+          }
+        }
+        return sos;
+      },
+      py::arg("n"), py::arg("fc"), py::arg("fs"),
+      py::arg("type") = Nodex::Filter::butter,
+      py::arg("mode") = Nodex::Filter::lowpass, py::arg("fc2") = 0.0,
+      py::arg("ripple") = 5.0, py::arg("attenuation") = 40.0);
+
+  // Designs of a parameter sweep, computed in parallel without the cache
+  m.def("iirfilter_batch", &iirfilter_batch, py::arg("n"), py::arg("fc"),
+        py::arg("fs"), py::arg("type") = Nodex::Filter::butter,
+        py::arg("mode") = Nodex::Filter::lowpass, py::arg("fc2") = 0.0,
+        py::arg("ripple") = 5.0, py::arg("attenuation") = 40.0);
+
+  // (hits, misses, size) of the design cache
+  m.def("design_cache_info", []() {
+    const auto& cache{Nodex::Filter::DesignCache::global()};
+    return std::make_tuple(cache.hits(), cache.misses(), cache.size());
+  });
+
+  m.def("design_cache_clear",
+        []() { Nodex::Filter::DesignCache::global().clear(); });
+
+  m.def(
+      "ellipap",
+      [](const int n, const double rp, const double rs) {
+        const auto zpk{Nodex::Filter::ellipap(n, rp, rs)};
+        return std::make_tuple(zpk.z, zpk.p, zpk.k);
+      },
+      py::arg("n"), py::arg("rp"), py::arg("rs"));
+
+  // Minimum orders: (order, fc, fc2) to pass to iirfilter
+  bind_order(m, "buttord", &Nodex::Filter::buttord);
+  bind_order(m, "cheb1ord", &Nodex::Filter::cheb1ord);
+  bind_order(m, "cheb2ord", &Nodex::Filter::cheb2ord);
+  bind_order(m, "ellipord", &Nodex::Filter::ellipord);
+
+  // Cheapest design meeting the spec: (type, order, fc, fc2, ripple)
+  m.def(
+      "design_from_spec",
+      [](const Nodex::Filter::Mode mode, const double fpass, const double fstop,
+         const double fs, const double rp, const double rs,
+         const double fpass2, const double fstop2) {
+        const auto key{Nodex::Filter::designFromSpec(
+            {mode, fpass, fstop, fpass2, fstop2, fs, rp, rs})};
+        return std::make_tuple(key.type, key.order, key.fc, key.fc2,
+                               key.ripple);
+      },
+      py::arg("mode"), py::arg("fpass"), py::arg("fstop"), py::arg("fs"),
+      py::arg("rp") = 1.0, py::arg("rs") = 40.0, py::arg("fpass2") = 0.0,
+      py::arg("fstop2") = 0.0);
+
+  py::enum_<Nodex::Filter::Window>(m, "Window")
+      .value("rectangular", Nodex::Filter::rectangular)
+      .value("hann", Nodex::Filter::hann)
+      .value("hamming", Nodex::Filter::hamming)
+      .value("blackman", Nodex::Filter::blackman)
+      .value("kaiser", Nodex::Filter::kaiser);
+
+  m.def(
+      "firwin",
+      [](const Nodex::Filter::Index numtaps, const double fc, const double fs,
+         const Nodex::Filter::Mode mode, const Nodex::Filter::Window window,
+         const double beta, const double fc2) {
+        using namespace Nodex::Filter;
+
+        const bool    band{mode == bandpass || mode == bandstop};
+        const ArrayXd taps{
+            band ? firwin(numtaps, fc, fc2, fs, mode, window, beta)
+                 : firwin(numtaps, fc, fs, mode, window, beta)};
+        return Signal(taps.begin(), taps.end());
+      },
+      py::arg("numtaps"), py::arg("fc"), py::arg("fs"),
+      py::arg("mode")   = Nodex::Filter::lowpass,
+      py::arg("window") = Nodex::Filter::hamming, py::arg("beta") = 8.6,
+      py::arg("fc2") = 0.0);
+
+  m.def(
+      "remez",
+      [](const Nodex::Filter::Index numtaps, const std::vector<double>& bands,
+         const std::vector<double>& desired,
+         const std::vector<double>& weights, const double fs,
+         const int maxiter) {
+        const Nodex::Filter::ArrayXd taps{Nodex::Filter::remez(
+            numtaps, bands, desired, weights, fs, maxiter)};
+        return Signal(taps.begin(), taps.end());
+      },
+      py::arg("numtaps"), py::arg("bands"), py::arg("desired"),
+      py::arg("weights") = std::vector<double>{}, py::arg("fs") = 1.0,
+      py::arg("maxiter") = 40);
+
+  m.def(
+      "fir_filter",
+      [](const std::vector<double>& taps, const Signal& x) {
+        return Nodex::Filter::firFilter(taps, x);
+      },
+      py::arg("taps"), py::arg("x"));
+
+  py::class_<Nodex::Filter::FirFilter>(m, "FirFilter")
+      .def(py::init([](const std::vector<double>& taps) {
+             return Nodex::Filter::FirFilter{
+                 Eigen::Map<const Nodex::Filter::ArrayXd>(
+                     taps.data(),
+                     static_cast<Nodex::Filter::Index>(taps.size()))};
+           }),
+           py::arg("taps"))
+      .def(
+          "process",
+          [](Nodex::Filter::FirFilter& self, const Signal& x) {
+            return self.process(x);
+          },
+          py::arg("x"))
+      .def("reset", &Nodex::Filter::FirFilter::reset)
+      .def_property_readonly("num_taps", &Nodex::Filter::FirFilter::numTaps)
+      .def_property_readonly("uses_fft", &Nodex::Filter::FirFilter::usesFft);
+
+  py::enum_<Nodex::Filter::FixedPointFormat::Rounding>(m, "FixedRounding")
+      .value("truncate", Nodex::Filter::FixedPointFormat::truncate)
+      .value("nearest", Nodex::Filter::FixedPointFormat::nearest);
+
+  // (integer b0, b1, b2, a1, a2 per section, fractional bits, max |error|,
+  // max error in dB relative to the peak of the response)
+  m.def(
+      "quantize_sos",
+      [](const Nodex::Filter::SOS& sos, const int word_bits,
+         const int coeff_bits, const Nodex::Filter::Index n) {
+        const auto q{Nodex::Filter::quantizeSos(sos_array(sos), word_bits,
+                                                coeff_bits, n)};
+
+        std::vector<std::array<std::int32_t, 5>> coeffs(
+            static_cast<std::size_t>(q.coeffs.rows()));
+        for (std::size_t i{0}; i < coeffs.size(); ++i) {
+          for (std::size_t j{0}; j < 5; ++j) {
+            coeffs[i][j] = q.coeffs(static_cast<Nodex::Filter::Index>(i),
+                                    static_cast<Nodex::Filter::Index>(j));
+          }
+        }
+        return std::make_tuple(coeffs, q.coeffBits, q.maxError, q.maxErrorDb);
+      },
+      py::arg("sos"), py::arg("word_bits") = 16, py::arg("coeff_bits") = -1,
+      py::arg("n") = 512);
+
+  bind_fixed_sos<std::int16_t>(m, "SosFilterQ15");
+  bind_fixed_sos<std::int32_t>(m, "SosFilterQ31");
+
+  py::enum_<Nodex::Filter::StreamingFilter::Backend>(m, "StreamingBackend")
+      .value("tf", Nodex::Filter::StreamingFilter::tf)
+      .value("sos", Nodex::Filter::StreamingFilter::sos)
+      .value("fft", Nodex::Filter::StreamingFilter::fft);
+
+  py::class_<Nodex::Filter::StreamingFilter>(m, "StreamingFilter")
+      .def(py::init([](const std::vector<double>& b,
+                       const std::vector<double>& a) {
+             Nodex::Filter::Coeffs coeffs{b, a};
+             return Nodex::Filter::StreamingFilter{
+                 Nodex::Filter::EigenCoeffs{coeffs}};
+           }),
+           py::arg("b"), py::arg("a"))
+      .def(py::init([](const Nodex::Filter::SOS& sos) {
+             return Nodex::Filter::StreamingFilter{sos_array(sos)};
+           }),
+           py::arg("sos"))
+      // Overlap-save convolution with the truncated impulse response
+      .def_static(
+          "fft",
+          [](const std::vector<double>& b, const std::vector<double>& a,
+             const double epsilon, const Nodex::Filter::Index max_length,
+             const Nodex::Filter::Index fft_size) {
+            Nodex::Filter::Coeffs coeffs{b, a};
+            return Nodex::Filter::StreamingFilter{Nodex::Filter::FftConvolver{
+                Nodex::Filter::EigenCoeffs{coeffs}, epsilon, max_length,
+                fft_size}};
+          },
+          py::arg("b"), py::arg("a"), py::arg("epsilon") = 1e-12,
+          py::arg("max_length") = 10000, py::arg("fft_size") = 0)
+      .def("process", &streaming_process, py::arg("x"),
+           py::arg("out") = py::none())
+      .def("reset", &Nodex::Filter::StreamingFilter::reset)
+      .def("snapshot",
+           [](const Nodex::Filter::StreamingFilter& self) {
+             const Nodex::Filter::ArrayXd state{self.snapshot()};
+             return std::vector<double>(state.begin(), state.end());
+           })
+      .def(
+          "restore",
+          [](Nodex::Filter::StreamingFilter& self,
+             const std::vector<double>&      state) {
+            self.restore(Eigen::Map<const Nodex::Filter::ArrayXd>(
+                state.data(), static_cast<Nodex::Filter::Index>(state.size())));
+          },
+          py::arg("state"))
+      .def_property_readonly("backend",
+                             &Nodex::Filter::StreamingFilter::backend)
+      .def_property_readonly("state_size",
+                             &Nodex::Filter::StreamingFilter::stateSize);
+
+  py::class_<Nodex::Filter::FftConvolver>(m, "FftConvolver")
+      .def(py::init([](const std::vector<double>& ir,
+                       const Nodex::Filter::Index fft_size) {
+             return Nodex::Filter::FftConvolver{
+                 Eigen::Map<const Nodex::Filter::ArrayXd>(
+                     ir.data(), static_cast<Nodex::Filter::Index>(ir.size())),
+                 fft_size};
+           }),
+           py::arg("ir"), py::arg("fft_size") = 0)
+      .def(py::init([](const std::vector<double>& b,
+                       const std::vector<double>& a, const double epsilon,
+                       const Nodex::Filter::Index max_length,
+                       const Nodex::Filter::Index fft_size) {
+             Nodex::Filter::Coeffs coeffs{b, a};
+             return Nodex::Filter::FftConvolver{
+                 Nodex::Filter::EigenCoeffs{coeffs}, epsilon, max_length,
+                 fft_size};
+           }),
+           py::arg("b"), py::arg("a"), py::arg("epsilon") = 1e-12,
+           py::arg("max_length") = 10000, py::arg("fft_size") = 0)
+      .def(
+          "process",
+          [](Nodex::Filter::FftConvolver& self, const Signal& x) {
+            return self.process(x);
+          },
+          py::arg("x"))
+      .def("reset", &Nodex::Filter::FftConvolver::reset)
+      .def_property_readonly("ir_length",
+                             &Nodex::Filter::FftConvolver::irLength)
+      .def_property_readonly("fft_size", &Nodex::Filter::FftConvolver::fftSize)
+      .def_property_readonly("block_length",
+                             &Nodex::Filter::FftConvolver::blockLength);
+
+  py::class_<Nodex::Filter::PartitionedConvolver>(m, "PartitionedConvolver")
+      .def(py::init([](const std::vector<double>& ir,
+                       const Nodex::Filter::Index block_size,
+                       const Nodex::Filter::Index tail_block_size) {
+             return Nodex::Filter::PartitionedConvolver{
+                 Eigen::Map<const Nodex::Filter::ArrayXd>(
+                     ir.data(), static_cast<Nodex::Filter::Index>(ir.size())),
+                 block_size, tail_block_size};
+           }),
+           py::arg("ir"), py::arg("block_size") = 64,
+           py::arg("tail_block_size") = 0)
+      .def(py::init([](const std::vector<double>& b,
+                       const std::vector<double>& a, const double epsilon,
+                       const Nodex::Filter::Index max_length,
+                       const Nodex::Filter::Index block_size,
+                       const Nodex::Filter::Index tail_block_size) {
+             Nodex::Filter::Coeffs coeffs{b, a};
+             return Nodex::Filter::PartitionedConvolver{
+                 Nodex::Filter::EigenCoeffs{coeffs}, epsilon, max_length,
+                 block_size, tail_block_size};
+           }),
+           py::arg("b"), py::arg("a"), py::arg("epsilon") = 1e-12,
+           py::arg("max_length") = 10000, py::arg("block_size") = 64,
+           py::arg("tail_block_size") = 0)
+      .def(
+          "process",
+          [](Nodex::Filter::PartitionedConvolver& self, const Signal& x) {
+            return self.process(x);
+          },
+          py::arg("x"))
+      .def("reset", &Nodex::Filter::PartitionedConvolver::reset)
+      .def_property_readonly("ir_length",
+                             &Nodex::Filter::PartitionedConvolver::irLength)
+      .def_property_readonly("block_size",
+                             &Nodex::Filter::PartitionedConvolver::blockSize)
+      .def_property_readonly(
+          "tail_block_size",
+          &Nodex::Filter::PartitionedConvolver::tailBlockSize);
+
   m.def(
       "freqz",
       [](const std::vector<std::complex<double>>& z,
@@ -46,6 +680,258 @@ PYBIND11_MODULE(pynodex, m, py::mod_gil_not_used()) {
         return Nodex::Filter::freqz(digitalFilter, w);
       },
       py::arg("z"), py::arg("p"), py::arg("k"), py::arg("w"));
+
+  m.def(
+      "freqz_ba",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const Nodex::Filter::Index n, const bool whole) {
+        Nodex::Filter::Coeffs coeffs{b, a};
+        return response_tuple(
+            Nodex::Filter::freqz(Nodex::Filter::EigenCoeffs{coeffs}, n, whole));
+      },
+      py::arg("b"), py::arg("a"), py::arg("n") = 512, py::arg("whole") = false);
+
+  m.def(
+      "freqz_ba_at",
+      [](const std::vector<double>& b, const std::vector<double>& a,
+         const std::vector<double>& w) {
+        Nodex::Filter::Coeffs coeffs{b, a};
+        return response_tuple(Nodex::Filter::freqz(
+            Nodex::Filter::EigenCoeffs{coeffs},
+            Eigen::Map<const Nodex::Filter::ArrayXd>(
+                w.data(), static_cast<Nodex::Filter::Index>(w.size()))));
+      },
+      py::arg("b"), py::arg("a"), py::arg("w"));
+
+  py::class_<Nodex::Filter::Stft>(m, "Stft")
+      .def(py::init<Nodex::Filter::Window, Nodex::Filter::Index,
+                    Nodex::Filter::Index, Nodex::Filter::Index,
+                    Nodex::Filter::Index, double>(),
+           py::arg("window"), py::arg("window_length"), py::arg("hop"),
+           py::arg("nfft") = -1, py::arg("channels") = 1, py::arg("fs") = 1.0)
+      .def("process", &stft_process, py::arg("x"))
+      // Welch average, one row per channel
+      .def("psd",
+           [](const Nodex::Filter::Stft& self) { return to_array(self.psd()); })
+      .def("frequencies",
+           [](const Nodex::Filter::Stft& self) {
+             const Nodex::Filter::ArrayXd f{self.frequencies()};
+             return Signal(f.begin(), f.end());
+           })
+      .def("reset", &Nodex::Filter::Stft::reset)
+      .def_property_readonly("averaged", &Nodex::Filter::Stft::averaged)
+      .def_property_readonly("window_length",
+                             &Nodex::Filter::Stft::windowLength)
+      .def_property_readonly("hop", &Nodex::Filter::Stft::hop)
+      .def_property_readonly("nfft", &Nodex::Filter::Stft::nfft)
+      .def_property_readonly("bins", &Nodex::Filter::Stft::bins)
+      .def_property_readonly("channels", &Nodex::Filter::Stft::channels)
+      .def_property_readonly("fs", &Nodex::Filter::Stft::fs);
+
+  // (frequencies, segment centre times, PSD with one row per segment)
+  m.def(
+      "spectrogram",
+      [](const Signal& x, const Nodex::Filter::Window window,
+         const Nodex::Filter::Index window_length,
+         const Nodex::Filter::Index hop, const Nodex::Filter::Index nfft,
+         const double fs) {
+        using namespace Nodex::Filter;
+
+        Stft stft{window, window_length, hop, nfft, 1, fs};
+        stft.process(Eigen::Map<const RowMajorMatrixXd>(
+            x.data(), 1, static_cast<Index>(x.size())));
+
+        const RowMajorMatrixXd& sxx{stft.frames()};
+        Signal                  t(static_cast<std::size_t>(sxx.rows()));
+        for (std::size_t i{0}; i < t.size(); ++i)
+          t[i] = (static_cast<double>(window_length) / 2 +
+                  static_cast<double>(i * static_cast<std::size_t>(hop))) /
+                 fs;
+
+        const ArrayXd f{stft.frequencies()};
+        return std::make_tuple(Signal(f.begin(), f.end()), t, to_array(sxx));
+      },
+      py::arg("x"), py::arg("window") = Nodex::Filter::hann,
+      py::arg("window_length") = 256, py::arg("hop") = 128,
+      py::arg("nfft") = -1, py::arg("fs") = 1.0);
+
+  // (frequencies, PSD)
+  m.def(
+      "welch",
+      [](const Signal& x, const Nodex::Filter::Window window,
+         const Nodex::Filter::Index window_length,
+         const Nodex::Filter::Index hop, const Nodex::Filter::Index nfft,
+         const double fs) {
+        using namespace Nodex::Filter;
+
+        Stft stft{window, window_length, hop, nfft, 1, fs};
+        stft.process(Eigen::Map<const RowMajorMatrixXd>(
+            x.data(), 1, static_cast<Index>(x.size())));
+
+        const ArrayXd f{stft.frequencies()};
+        const ArrayXd psd{stft.psd().row(0).transpose().array()};
+        return std::make_tuple(Signal(f.begin(), f.end()),
+                               Signal(psd.begin(), psd.end()));
+      },
+      py::arg("x"), py::arg("window") = Nodex::Filter::hann,
+      py::arg("window_length") = 256, py::arg("hop") = 128,
+      py::arg("nfft") = -1, py::arg("fs") = 1.0);
+
+  m.def(
+      "goertzel",
+      [](const Signal& x, const std::vector<double>& frequencies,
+         const double fs) {
+        using namespace Nodex::Filter;
+
+        const ArrayXcd bins{goertzel(
+            Eigen::Map<const ArrayXd>(x.data(), static_cast<Index>(x.size())),
+            Eigen::Map<const ArrayXd>(frequencies.data(),
+                                      static_cast<Index>(frequencies.size())),
+            fs)};
+        return std::vector<std::complex<double>>(bins.begin(), bins.end());
+      },
+      py::arg("x"), py::arg("frequencies"), py::arg("fs") = 1.0);
+
+  // x is (channels, samples); one row of bins per channel
+  m.def(
+      "goertzel_multi",
+      [](py::array_t<double, py::array::c_style | py::array::forcecast> x,
+         const std::vector<double>& frequencies, const double fs) {
+        using namespace Nodex::Filter;
+
+        if (x.ndim() != 2)
+          throw std::runtime_error("x must be 2D (channels, samples)");
+
+        const Eigen::Map<const RowMajorMatrixXd> x_map(
+            x.data(), static_cast<Index>(x.shape(0)),
+            static_cast<Index>(x.shape(1)));
+        const Eigen::Map<const ArrayXd> f_map(
+            frequencies.data(), static_cast<Index>(frequencies.size()));
+
+        RowMajorMatrixXcd bins{};
+        {
+          const py::gil_scoped_release release{};
+          bins = goertzelMultichannel(x_map, f_map, fs);
+        }
+
+        py::array_t<std::complex<double>> out(
+            {static_cast<py::ssize_t>(bins.rows()),
+             static_cast<py::ssize_t>(bins.cols())});
+        std::copy(bins.data(), bins.data() + bins.size(), out.mutable_data());
+        return out;
+      },
+      py::arg("x"), py::arg("frequencies"), py::arg("fs") = 1.0);
+
+  py::class_<Nodex::Filter::SlidingDft>(m, "SlidingDft")
+      .def(py::init([](const std::vector<double>& frequencies, const double fs,
+                       const Nodex::Filter::Index window_length,
+                       const Nodex::Filter::Index channels) {
+             return Nodex::Filter::SlidingDft{
+                 Eigen::Map<const Nodex::Filter::ArrayXd>(
+                     frequencies.data(),
+                     static_cast<Nodex::Filter::Index>(frequencies.size())),
+                 fs, window_length, channels};
+           }),
+           py::arg("frequencies"), py::arg("fs"), py::arg("window_length"),
+           py::arg("channels") = 1)
+      .def("process", &sliding_dft_process, py::arg("x"))
+      .def("bins",
+           [](const Nodex::Filter::SlidingDft& self) {
+             const Nodex::Filter::ArrayXcd bins{self.bins()};
+             return std::vector<std::complex<double>>(bins.begin(),
+                                                      bins.end());
+           })
+      .def("reset", &Nodex::Filter::SlidingDft::reset)
+      .def_property_readonly("frequencies",
+                             &Nodex::Filter::SlidingDft::frequencies)
+      .def_property_readonly("channels", &Nodex::Filter::SlidingDft::channels)
+      .def_property_readonly("window_length",
+                             &Nodex::Filter::SlidingDft::windowLength);
+
+  // The averages take 1D signals or (channels, samples) arrays
+  py::class_<Nodex::Filter::MovingAverage>(m, "MovingAverage")
+      .def(py::init<Nodex::Filter::Index, Nodex::Filter::Index>(),
+           py::arg("window_length"), py::arg("channels") = 1)
+      .def("process", &smooth<Nodex::Filter::MovingAverage>, py::arg("x"))
+      .def("reset", &Nodex::Filter::MovingAverage::reset)
+      .def_property_readonly("window_length",
+                             &Nodex::Filter::MovingAverage::windowLength)
+      .def_property_readonly("channels",
+                             &Nodex::Filter::MovingAverage::channels);
+
+  py::class_<Nodex::Filter::ExponentialAverage>(m, "ExponentialAverage")
+      .def(py::init<double, Nodex::Filter::Index>(), py::arg("alpha"),
+           py::arg("channels") = 1)
+      .def("process", &smooth<Nodex::Filter::ExponentialAverage>,
+           py::arg("x"))
+      .def("reset", &Nodex::Filter::ExponentialAverage::reset)
+      .def_static("alpha_from_time_constant",
+                  &Nodex::Filter::ExponentialAverage::alphaFromTimeConstant,
+                  py::arg("tau"), py::arg("fs"))
+      .def_property_readonly("alpha", &Nodex::Filter::ExponentialAverage::alpha)
+      .def_property_readonly("channels",
+                             &Nodex::Filter::ExponentialAverage::channels);
+
+  py::class_<Nodex::Filter::CicDecimator>(m, "CicDecimator")
+      .def(py::init<Nodex::Filter::Index, Nodex::Filter::Index,
+                    Nodex::Filter::Index, Nodex::Filter::Index>(),
+           py::arg("decimation"), py::arg("stages"), py::arg("delay") = 1,
+           py::arg("channels") = 1)
+      .def("process", &cic_process, py::arg("x"))
+      .def("reset", &Nodex::Filter::CicDecimator::reset)
+      .def_property_readonly("decimation",
+                             &Nodex::Filter::CicDecimator::decimation)
+      .def_property_readonly("stages", &Nodex::Filter::CicDecimator::stages)
+      .def_property_readonly("channels",
+                             &Nodex::Filter::CicDecimator::channels);
+
+  py::class_<Nodex::Filter::RunningStats>(m, "RunningStats")
+      .def(py::init<Nodex::Filter::Index, Nodex::Filter::Index>(),
+           py::arg("window_length"), py::arg("channels") = 1)
+      .def("process", &running_stats_process, py::arg("x"))
+      .def("reset", &Nodex::Filter::RunningStats::reset)
+      .def_property_readonly("window_length",
+                             &Nodex::Filter::RunningStats::windowLength)
+      .def_property_readonly("channels",
+                             &Nodex::Filter::RunningStats::channels);
+
+  m.def(
+      "moving_average",
+      [](ChannelArray x, const Nodex::Filter::Index window_length) {
+        Nodex::Filter::MovingAverage average{window_length,
+                                             channel_rows(x).rows()};
+        return smooth(average, x);
+      },
+      py::arg("x"), py::arg("window_length"));
+
+  m.def(
+      "exponential_average",
+      [](ChannelArray x, const double alpha) {
+        Nodex::Filter::ExponentialAverage average{alpha,
+                                                  channel_rows(x).rows()};
+        return smooth(average, x);
+      },
+      py::arg("x"), py::arg("alpha"));
+
+  m.def(
+      "cic_decimate",
+      [](ChannelArray x, const Nodex::Filter::Index decimation,
+         const Nodex::Filter::Index stages, const Nodex::Filter::Index delay) {
+        Nodex::Filter::CicDecimator cic{decimation, stages, delay,
+                                        channel_rows(x).rows()};
+        return cic_process(cic, x);
+      },
+      py::arg("x"), py::arg("decimation"), py::arg("stages") = 3,
+      py::arg("delay") = 1);
+
+  m.def(
+      "running_stats",
+      [](ChannelArray x, const Nodex::Filter::Index window_length) {
+        Nodex::Filter::RunningStats stats{window_length,
+                                          channel_rows(x).rows()};
+        return running_stats_process(stats, x);
+      },
+      py::arg("x"), py::arg("window_length"));
 }
 
 py::array_t<double> lfilter_multi(
@@ -57,8 +943,6 @@ py::array_t<double> lfilter_multi(
   const auto n_channels{static_cast<Index>(x.shape(0))};
   const auto n_samples{static_cast<Index>(x.shape(1))};
 
-  Eigen::Map<const ArrayXd>          b_map(b.data(), b.size());
-  Eigen::Map<const ArrayXd>          a_map(a.data(), a.size());
   Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
 
   py::array_t<double>          y_out({static_cast<py::ssize_t>(n_channels),
@@ -66,6 +950,36 @@ py::array_t<double> lfilter_multi(
   Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), n_channels,
                                      n_samples);
 
+  if (b.ndim() == 2 || a.ndim() == 2) {
+    // One row per channel, a 1-D b or a repeated for every channel
+    const auto perChannel{[&](const auto& c) {
+      const auto taps{static_cast<Index>(c.shape(c.ndim() - 1))};
+      if (c.ndim() == 2 && c.shape(0) != n_channels)
+        throw std::runtime_error("Coefficients must have one row per channel");
+
+      Eigen::Map<const RowMajorMatrixXd> c_map(
+          c.data(), c.ndim() == 2 ? n_channels : 1, taps);
+      return RowMajorMatrixXd{c_map.replicate(c.ndim() == 2 ? 1 : n_channels,
+                                              1)};
+    }};
+    const RowMajorMatrixXd b_rows{perChannel(b)};
+    const RowMajorMatrixXd a_rows{perChannel(a)};
+
+    RowMajorMatrixXd state{RowMajorMatrixXd::Zero(
+        n_channels, std::max(b_rows.cols(), a_rows.cols()) - 1)};
+
+    // The buffers are owned by numpy arrays held for the whole call
+    {
+      const py::gil_scoped_release release{};
+      linearFilter(b_rows, a_rows, x_map, y_map, state);
+    }
+
+    return y_out;
+  }
+
+  Eigen::Map<const ArrayXd> b_map(b.data(), b.size());
+  Eigen::Map<const ArrayXd> a_map(a.data(), a.size());
+
   RowMajorMatrixXd state{RowMajorMatrixXd::Zero(
       n_channels, std::max(b_map.size(), a_map.size()) - 1)};
 
@@ -73,3 +987,481 @@ py::array_t<double> lfilter_multi(
 
   return y_out;
 }
+
+py::array_t<double> sosfilt_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> sos,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x) {
+  using namespace Nodex::Filter;
+
+  const auto n_channels{static_cast<Index>(x.shape(0))};
+  const auto n_samples{static_cast<Index>(x.shape(1))};
+
+  if (sos.shape(sos.ndim() - 1) != 6 ||
+      (sos.ndim() == 3 && sos.shape(0) != n_channels))
+    throw std::runtime_error(
+        "sos must be (sections, 6) or (channels, sections, 6)");
+
+  const auto n_sections{static_cast<Index>(sos.shape(sos.ndim() - 2))};
+
+  // Every channel's sections flattened into one row
+  Eigen::Map<const RowMajorMatrixXd> sos_map(
+      sos.data(), sos.ndim() == 3 ? n_channels : 1, 6 * n_sections);
+  const RowMajorMatrixXd sos_rows{
+      sos_map.replicate(sos.ndim() == 3 ? 1 : n_channels, 1)};
+
+  Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
+
+  py::array_t<double>          y_out({static_cast<py::ssize_t>(n_channels),
+                                      static_cast<py::ssize_t>(n_samples)});
+  Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), n_channels,
+                                     n_samples);
+
+  RowMajorMatrixXd state{RowMajorMatrixXd::Zero(n_channels, 2 * n_sections)};
+
+  {
+    const py::gil_scoped_release release{};
+    sosFilterMultichannel(sos_rows, x_map, y_map, state);
+  }
+
+  return y_out;
+}
+
+py::array_t<double> filtfilt_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> b,
+    py::array_t<double, py::array::c_style | py::array::forcecast> a,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    const Nodex::Filter::Index padlen) {
+  using namespace Nodex::Filter;
+
+  const auto n_channels{static_cast<Index>(x.shape(0))};
+  const auto n_samples{static_cast<Index>(x.shape(1))};
+
+  Eigen::Map<const ArrayXd>          b_map(b.data(), b.size());
+  Eigen::Map<const ArrayXd>          a_map(a.data(), a.size());
+  Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
+
+  py::array_t<double>          y_out({static_cast<py::ssize_t>(n_channels),
+                                      static_cast<py::ssize_t>(n_samples)});
+  Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), n_channels,
+                                     n_samples);
+
+  y_map = filtFiltMultichannel({b_map, a_map}, x_map, padlen);
+
+  return y_out;
+}
+
+py::array_t<double> resample_poly_multi(
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    const Nodex::Filter::Index up, const Nodex::Filter::Index down) {
+  using namespace Nodex::Filter;
+
+  const auto n_channels{static_cast<Index>(x.shape(0))};
+  const auto n_samples{static_cast<Index>(x.shape(1))};
+
+  Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
+  const RowMajorMatrixXd y{resamplePolyMultichannel(x_map, up, down)};
+
+  py::array_t<double>          y_out({static_cast<py::ssize_t>(n_channels),
+                                      static_cast<py::ssize_t>(y.cols())});
+  Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), n_channels,
+                                     y.cols());
+  y_map = y;
+
+  return y_out;
+}
+
+BatchTuple iirfilter_batch(
+    py::array_t<int, py::array::c_style | py::array::forcecast>    n,
+    py::array_t<double, py::array::c_style | py::array::forcecast> fc,
+    const double fs, const Nodex::Filter::Type type,
+    const Nodex::Filter::Mode                                      mode,
+    py::array_t<double, py::array::c_style | py::array::forcecast> fc2,
+    py::array_t<double, py::array::c_style | py::array::forcecast> ripple,
+    const double attenuation) {
+  using namespace Nodex::Filter;
+
+  const py::ssize_t size{
+      std::max({n.size(), fc.size(), fc2.size(), ripple.size()})};
+  for (const py::ssize_t s : {n.size(), fc.size(), fc2.size(), ripple.size()})
+    if (s != 1 && s != size)
+      throw std::runtime_error("Parameters must have length 1 or the same "
+                               "length");
+
+  const auto at{[](const auto& a, const py::ssize_t i) {
+    return a.data()[a.size() == 1 ? 0 : i];
+  }};
+
+  std::vector<DesignKey> keys(static_cast<std::size_t>(size));
+  for (py::ssize_t i{0}; i < size; ++i)
+    keys[static_cast<std::size_t>(i)] = {type,          mode,       at(n, i),
+                                         at(fc, i),     at(fc2, i), fs,
+                                         at(ripple, i), attenuation};
+
+  DesignBatch batch{};
+  {
+    const py::gil_scoped_release release{};
+    batch = iirFilterBatch(keys);
+  }
+
+  const auto rows{static_cast<py::ssize_t>(batch.size())};
+  const auto roots{static_cast<py::ssize_t>(batch.zeros.cols())};
+  const auto sections{static_cast<py::ssize_t>(batch.sos.cols() / 6)};
+
+  py::array_t<std::complex<double>> z({rows, roots});
+  py::array_t<std::complex<double>> p({rows, roots});
+  py::array_t<double>               k(rows);
+  py::array_t<Index>                counts(rows);
+  py::array_t<double>               sos({rows, sections, py::ssize_t{6}});
+  py::array_t<Index>                n_sections(rows);
+
+  std::copy_n(batch.zeros.data(), batch.zeros.size(), z.mutable_data());
+  std::copy_n(batch.poles.data(), batch.poles.size(), p.mutable_data());
+  std::copy_n(batch.gains.data(), batch.size(), k.mutable_data());
+  std::copy_n(batch.counts.data(), batch.size(), counts.mutable_data());
+  std::copy_n(batch.sos.data(), batch.sos.size(), sos.mutable_data());
+  std::copy_n(batch.sections.data(), batch.size(), n_sections.mutable_data());
+
+  return {z, p, k, counts, sos, n_sections};
+}
+
+py::array_t<double> filter_bank(
+    const std::vector<Nodex::Filter::SOS>&                         bands,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x) {
+  using namespace Nodex::Filter;
+
+  std::vector<SosArray> sos{};
+  for (const auto& band : bands)
+    sos.push_back(sos_array(band));
+
+  FilterBank bank{sos};
+
+  return filter_bank_process(bank, x);
+}
+
+py::array_t<double> filter_bank_process(
+    Nodex::Filter::FilterBank&                                     bank,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x) {
+  using namespace Nodex::Filter;
+
+  const auto n_samples{static_cast<Index>(x.size())};
+
+  Eigen::Map<const ArrayXd> x_map(x.data(), n_samples);
+
+  py::array_t<double>          y_out({static_cast<py::ssize_t>(bank.bands()),
+                                      static_cast<py::ssize_t>(n_samples)});
+  Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), bank.bands(),
+                                     n_samples);
+
+  bank.process(x_map, y_map);
+
+  return y_out;
+}
+
+FloatArray lfilter_f32(const std::vector<double>& b,
+                       const std::vector<double>& a, FloatArray x,
+                       const bool double_accumulation) {
+  using namespace Nodex::Filter;
+
+  Eigen::Map<const ArrayXd> b_map(b.data(), static_cast<Index>(b.size()));
+  Eigen::Map<const ArrayXd> a_map(a.data(), static_cast<Index>(a.size()));
+  Eigen::Map<const ArrayXf> x_map(x.data(), x.size());
+  const EigenCoeffs         filter{b_map, a_map};
+
+  FloatArray          y_out(x.size());
+  Eigen::Map<ArrayXf> y_map(y_out.mutable_data(), x.size());
+
+  if (double_accumulation)
+    y_map = linearFilter(filter, x_map);
+  else
+    y_map = linearFilter(EigenCoeffsF{filter}, x_map);
+
+  return y_out;
+}
+
+FloatArray lfilter_multi_f32(const std::vector<double>& b,
+                             const std::vector<double>& a, FloatArray x) {
+  using namespace Nodex::Filter;
+
+  const auto n_channels{static_cast<Index>(x.shape(0))};
+  const auto n_samples{static_cast<Index>(x.shape(1))};
+
+  Eigen::Map<const ArrayXd> b_map(b.data(), static_cast<Index>(b.size()));
+  Eigen::Map<const ArrayXd> a_map(a.data(), static_cast<Index>(a.size()));
+  Eigen::Map<const RowMajorMatrixXf> x_map(x.data(), n_channels, n_samples);
+
+  FloatArray                   y_out({static_cast<py::ssize_t>(n_channels),
+                                      static_cast<py::ssize_t>(n_samples)});
+  Eigen::Map<RowMajorMatrixXf> y_map(y_out.mutable_data(), n_channels,
+                                     n_samples);
+
+  RowMajorMatrixXf state{RowMajorMatrixXf::Zero(
+      n_channels, std::max(b_map.size(), a_map.size()) - 1)};
+
+  y_map = linearFilter(EigenCoeffsF{EigenCoeffs{b_map, a_map}}, x_map, state);
+
+  return y_out;
+}
+
+FloatArray fft_filter_f32(const std::vector<double>& b,
+                          const std::vector<double>& a, FloatArray x,
+                          const double epsilon, const std::size_t max_length) {
+  using namespace Nodex::Filter;
+
+  Eigen::Map<const ArrayXd> b_map(b.data(), static_cast<Index>(b.size()));
+  Eigen::Map<const ArrayXd> a_map(a.data(), static_cast<Index>(a.size()));
+  Eigen::Map<const ArrayXf> x_map(x.data(), x.size());
+
+  FloatArray          y_out(x.size());
+  Eigen::Map<ArrayXf> y_map(y_out.mutable_data(), x.size());
+
+  y_map = fftFilter(EigenCoeffs{b_map, a_map}, x_map, epsilon,
+                    static_cast<Index>(max_length));
+
+  return y_out;
+}
+
+py::array_t<double, py::array::c_style> streaming_process(
+    Nodex::Filter::StreamingFilter&                                filter,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x,
+    std::optional<py::array_t<double, py::array::c_style>>         out) {
+  using namespace Nodex::Filter;
+
+  const auto n_samples{static_cast<Index>(x.size())};
+
+  py::array_t<double, py::array::c_style> y_out{
+      out ? *out : py::array_t<double, py::array::c_style>(x.size())};
+  if (y_out.size() != x.size())
+    throw std::runtime_error("out must have the same length as x");
+
+  Eigen::Map<const ArrayXd> x_map(x.data(), n_samples);
+  Eigen::Map<ArrayXd>       y_map(y_out.mutable_data(), n_samples);
+
+  filter.process(x_map, y_map);
+
+  return y_out;
+}
+
+py::array_t<double> stft_process(
+    Nodex::Filter::Stft&                                           stft,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x) {
+  using namespace Nodex::Filter;
+
+  if (x.ndim() > 2)
+    throw std::runtime_error("x must be 1D or 2D (channels, samples)");
+
+  const Index n_channels{x.ndim() == 2 ? static_cast<Index>(x.shape(0)) : 1};
+  const Index n_samples{x.ndim() == 2 ? static_cast<Index>(x.shape(1))
+                                      : static_cast<Index>(x.size())};
+  Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
+
+  Index n_frames{0};
+  {
+    const py::gil_scoped_release release{};
+    n_frames = stft.process(x_map);
+  }
+
+  py::array_t<double> frames({static_cast<py::ssize_t>(n_frames),
+                              static_cast<py::ssize_t>(stft.channels()),
+                              static_cast<py::ssize_t>(stft.bins())});
+  Eigen::Map<RowMajorMatrixXd>(frames.mutable_data(),
+                               n_frames * stft.channels(), stft.bins()) =
+      stft.frames();
+
+  return frames;
+}
+
+std::tuple<py::array_t<double>, py::array_t<double>> sliding_dft_process(
+    Nodex::Filter::SlidingDft&                                     tracker,
+    py::array_t<double, py::array::c_style | py::array::forcecast> x) {
+  using namespace Nodex::Filter;
+
+  if (x.ndim() > 2)
+    throw std::runtime_error("x must be 1D or 2D (channels, samples)");
+
+  const Index n_channels{x.ndim() == 2 ? static_cast<Index>(x.shape(0)) : 1};
+  const Index n_samples{x.ndim() == 2 ? static_cast<Index>(x.shape(1))
+                                      : static_cast<Index>(x.size())};
+  const Index n_lanes{n_channels * tracker.frequencies()};
+  Eigen::Map<const RowMajorMatrixXd> x_map(x.data(), n_channels, n_samples);
+
+  const auto          rows{static_cast<py::ssize_t>(n_channels)};
+  const auto          bins{static_cast<py::ssize_t>(tracker.frequencies())};
+  const auto          cols{static_cast<py::ssize_t>(n_samples)};
+  py::array_t<double> amplitude({rows, bins, cols});
+  py::array_t<double> phase({rows, bins, cols});
+
+  Eigen::Map<RowMajorMatrixXd> amplitude_map(amplitude.mutable_data(),
+                                             n_lanes, n_samples);
+  Eigen::Map<RowMajorMatrixXd> phase_map(phase.mutable_data(), n_lanes,
+                                         n_samples);
+
+  {
+    const py::gil_scoped_release release{};
+    tracker.process(x_map, amplitude_map, phase_map);
+  }
+
+  return {amplitude, phase};
+}
+
+py::array_t<double> to_array(const Nodex::Filter::RowMajorMatrixXd& m) {
+  using namespace Nodex::Filter;
+
+  py::array_t<double> out({static_cast<py::ssize_t>(m.rows()),
+                           static_cast<py::ssize_t>(m.cols())});
+  Eigen::Map<RowMajorMatrixXd>(out.mutable_data(), m.rows(), m.cols()) = m;
+
+  return out;
+}
+
+Eigen::Map<const Nodex::Filter::RowMajorMatrixXd>
+channel_rows(const ChannelArray& x) {
+  using namespace Nodex::Filter;
+
+  if (x.ndim() > 2)
+    throw std::runtime_error("x must be 1D or 2D (channels, samples)");
+
+  const Index n_channels{x.ndim() == 2 ? static_cast<Index>(x.shape(0)) : 1};
+  const Index n_samples{x.ndim() == 2 ? static_cast<Index>(x.shape(1))
+                                      : static_cast<Index>(x.size())};
+  return {x.data(), n_channels, n_samples};
+}
+
+py::array_t<double> shaped_like(const ChannelArray&        x,
+                                const Nodex::Filter::Index samples) {
+  if (x.ndim() == 2)
+    return py::array_t<double>(
+        {static_cast<py::ssize_t>(x.shape(0)),
+         static_cast<py::ssize_t>(samples)});
+
+  return py::array_t<double>(static_cast<py::ssize_t>(samples));
+}
+
+template <typename Smoother>
+py::array_t<double> smooth(Smoother& smoother, ChannelArray x) {
+  using namespace Nodex::Filter;
+
+  const auto          x_map{channel_rows(x)};
+  py::array_t<double> y_out{shaped_like(x, x_map.cols())};
+  Eigen::Map<RowMajorMatrixXd> y_map(y_out.mutable_data(), x_map.rows(),
+                                     x_map.cols());
+
+  {
+    const py::gil_scoped_release release{};
+    smoother.process(x_map, y_map);
+  }
+
+  return y_out;
+}
+
+py::array_t<double> cic_process(Nodex::Filter::CicDecimator& cic,
+                                ChannelArray                 x) {
+  using namespace Nodex::Filter;
+
+  const auto       x_map{channel_rows(x)};
+  RowMajorMatrixXd y{};
+  {
+    const py::gil_scoped_release release{};
+    y = cic.process(x_map);
+  }
+
+  py::array_t<double> y_out{shaped_like(x, y.cols())};
+  Eigen::Map<RowMajorMatrixXd>(y_out.mutable_data(), y.rows(), y.cols()) = y;
+
+  return y_out;
+}
+
+StatsTuple running_stats_process(Nodex::Filter::RunningStats& stats,
+                                 ChannelArray                 x) {
+  using namespace Nodex::Filter;
+
+  const auto          x_map{channel_rows(x)};
+  py::array_t<double> mean{shaped_like(x, x_map.cols())};
+  py::array_t<double> variance{shaped_like(x, x_map.cols())};
+  py::array_t<double> rms{shaped_like(x, x_map.cols())};
+
+  const auto map{[&](py::array_t<double>& a) {
+    return Eigen::Map<RowMajorMatrixXd>(a.mutable_data(), x_map.rows(),
+                                        x_map.cols());
+  }};
+  auto mean_map{map(mean)};
+  auto variance_map{map(variance)};
+  auto rms_map{map(rms)};
+
+  {
+    const py::gil_scoped_release release{};
+    stats.process(x_map, mean_map, variance_map, rms_map);
+  }
+
+  return {mean, variance, rms};
+}
+
+template <typename Sample>
+void bind_fixed_sos(py::module_& m, const char* name) {
+  using Filter = Nodex::Filter::FixedSosFilter<Sample>;
+  using Array  = py::array_t<Sample, py::array::c_style>;
+
+  py::class_<Filter>(m, name)
+      .def(py::init([](const Nodex::Filter::SOS& sos, const int coeff_bits,
+                       const Nodex::Filter::FixedPointFormat::Rounding rounding,
+                       const bool saturate) {
+             return Filter{sos_array(sos), {coeff_bits, rounding, saturate}};
+           }),
+           py::arg("sos"), py::arg("coeff_bits") = -1,
+           py::arg("rounding") = Nodex::Filter::FixedPointFormat::nearest,
+           py::arg("saturate") = true)
+      // Integer samples are filtered as they are, without conversion
+      .def(
+          "process",
+          [](Filter& self, Array x) {
+            Array y(x.size());
+            {
+              const py::gil_scoped_release release{};
+              self.process(x.data(), y.mutable_data(), x.size());
+            }
+            return y;
+          },
+          py::arg("x").noconvert())
+      .def("reset", &Filter::reset)
+      .def_property_readonly(
+          "coeff_bits",
+          [](const Filter& self) { return self.quantization().coeffBits; });
+}
+
+ResponseTuple response_tuple(const Nodex::Filter::FrequencyResponse& r) {
+  const auto toVector{[](const auto& array) {
+    return std::vector<typename std::decay_t<decltype(array)>::Scalar>(
+        array.data(), array.data() + array.size());
+  }};
+
+  return {toVector(r.w), toVector(r.h), toVector(r.magnitude),
+          toVector(r.phase), toVector(r.groupDelay)};
+}
+
+void bind_order(py::module_& m, const char* name,
+                Nodex::Filter::OrderEstimate (*estimate)(
+                    const Nodex::Filter::FilterSpec&)) {
+  m.def(
+      name,
+      [estimate](const Nodex::Filter::Mode mode, const double fpass,
+                 const double fstop, const double fs, const double rp,
+                 const double rs, const double fpass2, const double fstop2) {
+        const auto result{
+            estimate({mode, fpass, fstop, fpass2, fstop2, fs, rp, rs})};
+        return std::make_tuple(result.order, result.fc, result.fc2);
+      },
+      py::arg("mode"), py::arg("fpass"), py::arg("fstop"), py::arg("fs"),
+      py::arg("rp") = 1.0, py::arg("rs") = 40.0, py::arg("fpass2") = 0.0,
+      py::arg("fstop2") = 0.0);
+}
+
+Nodex::Filter::SosArray sos_array(const Nodex::Filter::SOS& sos) {
+  using namespace Nodex::Filter;
+
+  SosArray array(static_cast<Index>(sos.size()), 6);
+  for (std::size_t i{0}; i < sos.size(); ++i) {
+    array.row(static_cast<Index>(i)) =
+        Eigen::Map<const Eigen::Array<double, 1, 6>>(sos[i].data());
+  }
+
+  return array;
+}
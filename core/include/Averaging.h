@@ -0,0 +1,203 @@
+#ifndef INCLUDE_INCLUDE_AVERAGING_H_
+#define INCLUDE_INCLUDE_AVERAGING_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * @file Averaging.h
+ * @brief Recursive smoothing and running statistics with O(1) cost per
+ * sample: moving average, exponential average, CIC decimation and sliding
+ * mean, variance and RMS.
+ */
+namespace Nodex::Filter {
+/**
+ * Moving average over a window of the last windowLength samples, for
+ * multichannel streams processed in chunks of any length. A running sum
+ * adds the newest sample and subtracts the one leaving the window, so the
+ * cost does not depend on the window length. The sum is recomputed from the
+ * window once per window length, so rounding does not accumulate. The output
+ * matches linearFilter with b = ones(windowLength) / windowLength (the
+ * window starts filled with zeros).
+ */
+class MovingAverage {
+public:
+  MovingAverage() = default;
+
+  /**
+   * Creates a moving average with an empty (zero) window.
+   * @param windowLength The samples in the window
+   * @param channels The number of channels
+   */
+  explicit MovingAverage(const Index windowLength, const Index channels = 1);
+
+  /**
+   * Averages the next chunk of the stream.
+   * @param x The input chunk, one row per channel
+   * @param y The output chunk, same shape as x (may alias x)
+   */
+  void process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+               Eigen::Ref<RowMajorMatrixXd>              y);
+
+  // Clears the window so the next chunk starts a new stream
+  void reset();
+
+  Index windowLength() const { return m_window.cols(); }
+  Index channels() const { return m_window.rows(); }
+
+private:
+  // Samples in the window, one column per sample (a ring starting at m_pos)
+  Eigen::MatrixXd m_window{};
+  Index           m_pos{0};
+
+  ArrayXd m_sum{};
+  ArrayXd m_sample{};
+};
+
+/**
+ * Exponential moving average y(n) = y(n - 1) + alpha (x(n) - y(n - 1)), for
+ * multichannel streams processed in chunks of any length. The state starts
+ * at zero, as linearFilter with b = {alpha} and a = {1, alpha - 1}.
+ */
+class ExponentialAverage {
+public:
+  ExponentialAverage() = default;
+
+  /**
+   * Creates an exponential average with zero state.
+   * @param alpha The smoothing factor, in (0, 1]
+   * @param channels The number of channels
+   */
+  explicit ExponentialAverage(const double alpha, const Index channels = 1);
+
+  /**
+   * Averages the next chunk of the stream.
+   * @param x The input chunk, one row per channel
+   * @param y The output chunk, same shape as x (may alias x)
+   */
+  void process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+               Eigen::Ref<RowMajorMatrixXd>              y);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset() { m_state.setZero(); }
+
+  /**
+   * Smoothing factor of an average with the given time constant (the time
+   * for a step response to reach 1 - 1/e).
+   * @param tau The time constant, in the units of 1 / fs
+   * @param fs The sampling frequency
+   * @return The smoothing factor
+   */
+  static double alphaFromTimeConstant(const double tau, const double fs);
+
+  double alpha() const { return m_alpha; }
+  Index  channels() const { return m_state.size(); }
+
+private:
+  double  m_alpha{1.0};
+  ArrayXd m_state{};
+};
+
+/**
+ * Cascaded integrator-comb decimator: stages cascaded moving sums of
+ * decimation * delay samples, keeping every decimation-th output (from the
+ * first), normalised to unit DC gain. Each integrator and the comb of its
+ * stage run as one running sum, since floating-point integrators would grow
+ * without bound and lose precision; the response is that of the CIC, and
+ * the cost per input sample is O(stages).
+ */
+class CicDecimator {
+public:
+  CicDecimator() = default;
+
+  /**
+   * Creates a decimator with zero state.
+   * @param decimation The decimation factor
+   * @param stages The number of integrator-comb stages
+   * @param delay The differential delay of the combs
+   * @param channels The number of channels
+   */
+  CicDecimator(const Index decimation, const Index stages,
+               const Index delay = 1, const Index channels = 1);
+
+  /**
+   * Decimates the next chunk of the stream.
+   * @param x The input chunk, one row per channel
+   * @return The output samples the chunk completes, one row per channel
+   */
+  RowMajorMatrixXd process(const Eigen::Ref<const RowMajorMatrixXd>& x);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset();
+
+  Index decimation() const { return m_decimation; }
+  Index stages() const { return static_cast<Index>(m_stages.size()); }
+  Index channels() const { return m_channels; }
+
+private:
+  std::vector<MovingAverage> m_stages{};
+  Index                      m_decimation{1};
+  Index                      m_channels{0};
+
+  // Input samples until the next kept output
+  Index m_skip{0};
+
+  RowMajorMatrixXd m_work{};
+};
+
+/**
+ * Sliding mean, variance (population, over the window) and RMS of the last
+ * windowLength samples, for multichannel streams processed in chunks of any
+ * length. The mean and the sum of squared deviations are updated together
+ * as a sample enters and one leaves the window (Welford's update for a
+ * sliding window), which avoids the cancellation of a running sum of
+ * squares; both are recomputed from the window once per window length. The
+ * window starts filled with zeros.
+ */
+class RunningStats {
+public:
+  RunningStats() = default;
+
+  /**
+   * Creates running statistics with an empty (zero) window.
+   * @param windowLength The samples in the window
+   * @param channels The number of channels
+   */
+  explicit RunningStats(const Index windowLength, const Index channels = 1);
+
+  /**
+   * Feeds the next chunk of the stream, writing the statistics of the window
+   * after each sample. Outputs have the shape of x.
+   * @param x The input chunk, one row per channel
+   * @param mean The means
+   * @param variance The variances
+   * @param rms The root mean squares
+   */
+  void process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+               Eigen::Ref<RowMajorMatrixXd>              mean,
+               Eigen::Ref<RowMajorMatrixXd>              variance,
+               Eigen::Ref<RowMajorMatrixXd>              rms);
+
+  // Clears the window so the next chunk starts a new stream
+  void reset();
+
+  Index windowLength() const { return m_window.cols(); }
+  Index channels() const { return m_window.rows(); }
+
+private:
+  // Exact mean and sum of squared deviations of the window
+  void resync();
+
+  Eigen::MatrixXd m_window{};
+  Index           m_pos{0};
+
+  ArrayXd m_mean{};
+  ArrayXd m_m2{};
+  ArrayXd m_sample{};
+  ArrayXd m_oldMean{};
+  ArrayXd m_variance{};
+};
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_AVERAGING_H_
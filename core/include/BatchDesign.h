@@ -0,0 +1,50 @@
+#ifndef INCLUDE_INCLUDE_BATCHDESIGN_H_
+#define INCLUDE_INCLUDE_BATCHDESIGN_H_
+
+#include "DesignCache.h"
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * @file BatchDesign.h
+ * @brief IIR design of many filters at once, into packed arrays.
+ */
+namespace Nodex::Filter {
+/**
+ * Digital designs of a batch, one design per row. Rows are padded to the
+ * largest design: roots past counts(i) are zero and sections past
+ * sections(i) pass their input through, so sos can be handed directly to
+ * sosFilterMultichannel.
+ */
+struct DesignBatch {
+  using ComplexRows =
+      Eigen::Array<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using Counts = Eigen::Array<Index, Eigen::Dynamic, 1>;
+
+  // Zeros and poles of design i in the first counts(i) columns of row i (a
+  // digital design has as many zeros as poles)
+  ComplexRows zeros{};
+  ComplexRows poles{};
+  Counts      counts{};
+  ArrayXd     gains{};
+
+  // Sections of design i in row i: b0, b1, b2, a0, a1, a2 of each section
+  RowMajorMatrixXd sos{};
+  Counts           sections{};
+
+  Index size() const { return gains.size(); }
+};
+
+/**
+ * Designs every filter of a batch, as designFilter would one at a time. The
+ * designs run in parallel, each writing its roots and sections straight into
+ * its row of the packed result, with the intermediate roots in a workspace
+ * allocated once per thread.
+ * @param keys The design parameters
+ * @return The designs in zero-pole-gain and SOS form
+ */
+DesignBatch iirFilterBatch(const std::vector<DesignKey>& keys);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_BATCHDESIGN_H_
@@ -0,0 +1,208 @@
+#ifndef INCLUDE_INCLUDE_CONVOLUTION_H_
+#define INCLUDE_INCLUDE_CONVOLUTION_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+
+/**
+ * @file Convolution.h
+ * @brief Streaming FFT-based convolution engines.
+ */
+namespace Nodex::Filter {
+using Eigen::VectorXcd;
+using Eigen::VectorXd;
+
+/**
+ * Overlap-save FFT convolver. The spectrum of the impulse response is computed
+ * once at construction; the input can then be processed in one call or in
+ * chunks of any length, with the output identical to the direct convolution
+ * truncated to the input length.
+ */
+class FftConvolver {
+public:
+  FftConvolver() = default;
+
+  /**
+   * Creates a convolver for the given impulse response.
+   * @param ir The impulse response
+   * @param fftSize The FFT size (0 picks a cache-friendly size from the
+   * impulse response length)
+   */
+  explicit FftConvolver(const Eigen::Ref<const ArrayXd>& ir,
+                        const Index                      fftSize = 0);
+
+  /**
+   * Creates a convolver for the effective impulse response of a filter.
+   * @param filter The filter coefficients (b and a)
+   * @param epsilon The tolerance for the effective impulse response
+   * @param maxLength The maximum length of the effective impulse response
+   * @param fftSize The FFT size (0 picks it from the impulse response length)
+   */
+  FftConvolver(const EigenCoeffs& filter, const double epsilon = 1e-12,
+               const Index maxLength = 10000, const Index fftSize = 0);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  ArrayXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response,
+   * writing into a caller-provided buffer without allocating.
+   * @param x The input chunk
+   * @param y The output chunk (same length as x, may alias x)
+   */
+  void process(const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  Signal process(const Signal& x);
+
+  // Clears the input history so the next chunk starts a new stream
+  void reset();
+
+  // The last irLength - 1 input samples, which carry the stream between chunks
+  ArrayXd history() const;
+  void    setHistory(const Eigen::Ref<const ArrayXd>& history);
+
+  Index irLength() const { return m_irLength; }
+  Index fftSize() const { return m_fftSize; }
+  Index blockLength() const { return m_fftSize - m_irLength + 1; }
+
+private:
+  void processBlock(const double* x, double* y, const Index length);
+
+  Index m_irLength{0};
+  Index m_fftSize{0};
+
+  VectorXcd m_irSpectrum{};
+
+  // Last m_irLength - 1 input samples, followed by the current block
+  VectorXd  m_frame{};
+  VectorXcd m_spectrum{};
+  VectorXd  m_output{};
+};
+
+/**
+ * Uniformly partitioned frequency-domain convolver for streaming long impulse
+ * responses. The response is split into partitions of blockSize taps whose
+ * spectra are multiplied with a frequency-domain delay line of past input
+ * blocks, so the work per block does not grow with the FFT of the whole
+ * response. Each call returns the output for its input immediately (the
+ * current partial block is convolved with the first partition on the fly), so
+ * feeding blocks of about blockSize samples gives block-size latency.
+ *
+ * Optionally the response can be partitioned non-uniformly: the first
+ * tailBlockSize taps use blockSize partitions, and the rest uses
+ * tailBlockSize partitions that are computed once per tail block, one block
+ * ahead of when they are needed.
+ */
+class PartitionedConvolver {
+public:
+  PartitionedConvolver() = default;
+
+  /**
+   * Creates a convolver for the given impulse response.
+   * @param ir The impulse response
+   * @param blockSize The partition (and block) size of the head
+   * @param tailBlockSize The partition size beyond the first tailBlockSize
+   * taps (0 for a uniform partition)
+   */
+  explicit PartitionedConvolver(const Eigen::Ref<const ArrayXd>& ir,
+                                const Index blockSize     = 64,
+                                const Index tailBlockSize = 0);
+
+  /**
+   * Creates a convolver for the effective impulse response of a filter.
+   * @param filter The filter coefficients (b and a)
+   * @param epsilon The tolerance for the effective impulse response
+   * @param maxLength The maximum length of the effective impulse response
+   * @param blockSize The partition (and block) size of the head
+   * @param tailBlockSize The partition size beyond the first tailBlockSize
+   * taps (0 for a uniform partition)
+   */
+  PartitionedConvolver(const EigenCoeffs& filter, const double epsilon = 1e-12,
+                       const Index maxLength     = 10000,
+                       const Index blockSize     = 64,
+                       const Index tailBlockSize = 0);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  ArrayXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response,
+   * writing into a caller-provided buffer without allocating.
+   * @param x The input chunk
+   * @param y The output chunk (same length as x, may alias x)
+   */
+  void process(const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y);
+
+  /**
+   * Convolves the next chunk of the input stream with the impulse response.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  Signal process(const Signal& x);
+
+  // Clears the delay lines so the next chunk starts a new stream
+  void reset();
+
+  Index irLength() const { return m_irLength; }
+  Index blockSize() const { return m_head.blockSize; }
+  Index tailBlockSize() const { return m_tail.blockSize; }
+
+private:
+  // Uniformly partitioned overlap-save stage
+  struct Stage {
+    Index blockSize{0};
+    Index partitions{0};
+
+    Eigen::MatrixXcd spectra{};   // One partition spectrum per column
+    Eigen::MatrixXcd delayLine{}; // One input frame spectrum per column
+    Index            newest{0};   // Column of the newest frame in delayLine
+
+    VectorXd  frame{}; // Previous block followed by the current block
+    Index     fill{0}; // Samples of the current block received so far
+    VectorXcd spectrum{};
+    VectorXcd accumulator{};
+    VectorXd  output{};
+
+    // Head: sum over the partitions of the past blocks
+    // Tail: output of the current block, computed one block ahead
+    VectorXcd past{};
+    VectorXd  ahead{};
+
+    void init(const Eigen::Ref<const ArrayXd>& taps, const Index size);
+    void reset();
+    void pushFrame();
+    void accumulate(const Index first);
+    void processHead(const double* x, double* y, const Index length);
+    void processTail(const double* x, double* y, const Index length);
+  };
+
+  Index    m_irLength{0};
+  Stage    m_head{};
+  Stage    m_tail{};
+  VectorXd m_input{}; // Copy of the current step, as y may alias x
+};
+
+/**
+ * Chooses an overlap-save FFT size for an impulse response of the given
+ * length: about four times the response (so that most of each frame is new
+ * input), as long as the frame stays small enough to be cache resident.
+ * @param irLength The impulse response length
+ * @return The FFT size (a power of two)
+ */
+Index overlapSaveFftSize(const Index irLength);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_CONVOLUTION_H_
@@ -0,0 +1,100 @@
+#ifndef INCLUDE_INCLUDE_DESIGNCACHE_H_
+#define INCLUDE_INCLUDE_DESIGNCACHE_H_
+
+#include "FilterEigen.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @file DesignCache.h
+ * @brief Memoization of IIR filter designs.
+ */
+namespace Nodex::Filter {
+/**
+ * Parameters of an IIR design, as passed to iirFilter. fc2 is only used by
+ * the bandpass and bandstop modes, ripple only by the Chebyshev and elliptic
+ * types and attenuation only by the elliptic type; the cache ignores them
+ * otherwise.
+ */
+struct DesignKey {
+  Type   type{butter};
+  Mode   mode{lowpass};
+  int    order{1};
+  double fc{0.0};
+  double fc2{0.0};
+  double fs{1.0};
+  double ripple{5.0};
+  double attenuation{40.0};
+
+  bool operator==(const DesignKey&) const = default;
+};
+
+/**
+ * An IIR design in the three representations the filters consume.
+ */
+struct Design {
+  ZPK         zpk{};
+  EigenCoeffs tf{};
+  SosArray    sos{};
+};
+
+/**
+ * Designs the filter described by key, bypassing any cache.
+ * @param key The design parameters
+ * @return The design in zero-pole-gain, transfer function and SOS form
+ */
+Design designFilter(const DesignKey& key);
+
+/**
+ * Thread-safe least-recently-used cache of IIR designs. Designs are shared
+ * and immutable, so a returned pointer stays valid after it is evicted.
+ */
+class DesignCache {
+public:
+  /**
+   * Creates an empty cache.
+   * @param capacity The maximum number of designs kept
+   */
+  explicit DesignCache(const std::size_t capacity = 64);
+
+  /**
+   * Returns the design for key, designing and caching it on a miss.
+   * @param key The design parameters
+   * @return The shared design
+   */
+  std::shared_ptr<const Design> get(const DesignKey& key);
+
+  // Drops every design and resets the counters
+  void clear();
+
+  std::size_t hits() const;
+  std::size_t misses() const;
+  std::size_t size() const;
+  std::size_t capacity() const { return m_capacity; }
+
+  // Process-wide cache used by the nodes and the bindings
+  static DesignCache& global();
+
+private:
+  struct KeyHash {
+    std::size_t operator()(const DesignKey& key) const;
+  };
+
+  using Entry = std::pair<DesignKey, std::shared_ptr<const Design>>;
+
+  std::size_t m_capacity{0};
+  std::size_t m_hits{0};
+  std::size_t m_misses{0};
+
+  // Most recently used first
+  std::list<Entry> m_entries{};
+  std::unordered_map<DesignKey, std::list<Entry>::iterator, KeyHash> m_index{};
+
+  mutable std::mutex m_mutex{};
+};
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_DESIGNCACHE_H_
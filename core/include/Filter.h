@@ -2,7 +2,9 @@
 #define INCLUDE_CORE_FILTER_H_
 
 #include "Utils.h"
+#include <array>
 #include <cstddef>
+#include <span>
 #include <vector>
 
 /**
@@ -37,6 +39,12 @@ struct ZPK {
  */
 std::ostream& operator<<(std::ostream& os, const ZPK& zpk);
 
+// Second-order section (biquad) coefficients: b0, b1, b2, a0, a1, a2
+using Section = std::array<double, 6>;
+
+// Cascade of second-order sections representation
+using SOS = std::vector<Section>;
+
 /**
  * Applies a linear filter to the input signal x using the given filter
  * coefficients and state.
@@ -56,6 +64,85 @@ Signal linearFilter(const Coeffs& filter, const Signal& x, Signal& si);
  */
 Signal linearFilter(const Coeffs& filter, const Signal& x);
 
+/**
+ * Applies a linear filter to the input signal x, writing the output into a
+ * caller-provided buffer. The coefficients are used in place, so the call
+ * makes no heap allocation for filters of order up to 8 or with as many b as
+ * a coefficients.
+ * @param filter The filter coefficients
+ * @param x The input signal
+ * @param y The output signal (same length as x, may alias x)
+ * @param si The filter state (should be maintained between calls)
+ */
+void linearFilter(const Coeffs& filter, std::span<const double> x,
+                  std::span<double> y, std::span<double> si);
+
+/**
+ * Applies a linear filter to a long signal, filtering blocks of it
+ * concurrently and fixing up the state at the block boundaries. The output
+ * matches linearFilter up to rounding.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param blocks The number of blocks (0 uses one block per OpenMP thread)
+ * @return The filtered output signal
+ */
+Signal parallelLinearFilter(const Coeffs& filter, const Signal& x,
+                            const std::size_t blocks = 0);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x using the
+ * given state. Each section runs in transposed direct form II.
+ * @param sos The second-order sections
+ * @param x The input signal
+ * @param si The filter state, two values per section (should be maintained
+ * between calls)
+ * @return The filtered output signal
+ */
+Signal sosFilter(const SOS& sos, const Signal& x, Signal& si);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x. No state
+ * version.
+ * @param sos The second-order sections
+ * @param x The input signal
+ * @return The filtered output signal
+ */
+Signal sosFilter(const SOS& sos, const Signal& x);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x, writing
+ * the output into a caller-provided buffer.
+ * @param sos The second-order sections
+ * @param x The input signal
+ * @param y The output signal (same length as x, may alias x)
+ * @param si The filter state, two values per section
+ */
+void sosFilter(const SOS& sos, std::span<const double> x, std::span<double> y,
+               std::span<double> si);
+
+/**
+ * Applies a filter forwards and backwards for zero phase distortion, with odd
+ * extension at the edges and steady-state initial conditions.
+ * @param filter The filter coefficients
+ * @param x The input signal (longer than the padding)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the number of coefficients)
+ * @return The filtered signal
+ */
+Signal filtFilt(const Coeffs& filter, const Signal& x,
+                const int padLength = -1);
+
+/**
+ * Applies a cascade of second-order sections forwards and backwards for zero
+ * phase distortion.
+ * @param sos The second-order sections
+ * @param x The input signal (longer than the padding)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the order plus one)
+ * @return The filtered signal
+ */
+Signal filtFilt(const SOS& sos, const Signal& x, const int padLength = -1);
+
 /**
  * Computes the effective impulse response of a filter given its coefficients.
  * @param filter The filter coefficients
@@ -81,6 +168,16 @@ Signal fftFilter(const Coeffs& filter, const Signal& x,
 // Zeros-poles-gain to transfer function coefficients conversion
 Coeffs zpk2tf(const ZPK& zpk);
 
+/**
+ * Converts zeros-poles-gain representation to second-order sections. Poles are
+ * paired with their nearest zeros and the sections are ordered so that the
+ * poles closest to the unit circle come last; the gain goes into the first
+ * section.
+ * @param zpk The zeros-poles-gain representation
+ * @return The second-order sections
+ */
+SOS zpk2sos(const ZPK& zpk);
+
 // Standard filter modes
 enum Mode {
   lowpass,
@@ -95,6 +192,7 @@ enum Type {
   butter,
   cheb1,
   cheb2,
+  ellip,
   maxType,
 };
 
@@ -215,10 +313,12 @@ ZPK iirFilter(const int n, double fc, double fs, const double param) {
  * @param type The filter type (butterworth, chebyshev, etc.)
  * @param mode The filter mode (lowpass, highpass, etc.)
  * @param param Additional parameter for the prototype function (e.g., ripple)
+ * @param attenuation Stopband attenuation in dB (elliptic filters only)
  * @return The designed digital filter in zero-pole-gain representation
  */
 ZPK iirFilter(const int n, double fc, double fs, const Type type = butter,
-              const Mode mode = lowpass, const double param = 5.0);
+              const Mode mode = lowpass, const double param = 5.0,
+              const double attenuation = 40.0);
 
 /**
  * Designs a bandpass IIR filter using the given type.
@@ -228,11 +328,12 @@ ZPK iirFilter(const int n, double fc, double fs, const Type type = butter,
  * @param fs The sampling frequency
  * @param type The filter type (butterworth, chebyshev, etc.)
  * @param param Additional parameter for the prototype function (e.g., ripple)
+ * @param attenuation Stopband attenuation in dB (elliptic filters only)
  * @return The designed digital filter in zero-pole-gain representation
  */
 ZPK iirFilter(const int n, double fLow, double fHigh, double fs,
               const Type type = butter, const Mode mode = bandpass,
-              const double param = 5.0);
+              const double param = 5.0, const double attenuation = 40.0);
 
 /**
  * Analogue Butterworth lowpass filter prototype.
@@ -257,6 +358,30 @@ ZPK cheb1ap(const int n, const double rp);
  */
 ZPK cheb2ap(const int n, const double rs);
 
+/**
+ * Analogue elliptic (Cauer) lowpass filter prototype. For a given order it
+ * has the steepest transition band of the prototypes.
+ * @param n Filter order
+ * @param rp Passband ripple in dB
+ * @param rs Stopband attenuation in dB
+ * @return The filter in zero-pole-gain representation
+ */
+ZPK ellipap(const int n, const double rp, const double rs);
+
+/**
+ * Complete elliptic integral of the first kind K(m).
+ * @param m The parameter (0 <= m < 1)
+ * @return K(m)
+ */
+double ellipk(const double m);
+
+/**
+ * Complete elliptic integral of the first kind K(1 - p), accurate for small p.
+ * @param p The complementary parameter (0 < p <= 1)
+ * @return K(1 - p)
+ */
+double ellipkm1(const double p);
+
 } // namespace Nodex::Filter
 
 #endif // INCLUDE_CORE_FILTER_H_
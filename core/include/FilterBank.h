@@ -0,0 +1,110 @@
+#ifndef INCLUDE_INCLUDE_FILTERBANK_H_
+#define INCLUDE_INCLUDE_FILTERBANK_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * @file FilterBank.h
+ * @brief Many filters applied to one input in a single pass.
+ */
+namespace Nodex::Filter {
+/**
+ * Streaming bank of IIR filters sharing one input. The bands are filtered
+ * together, one per SIMD lane, and the input is consumed block by block so
+ * that each block is read from memory once and stays in L1 cache while every
+ * band runs over it. The output has one row per band.
+ *
+ * Each band is a cascade of stages of a common order: second-order sections
+ * (shorter cascades are padded with pass-through sections) or one transfer
+ * function (lower orders are zero-padded).
+ */
+class FilterBank {
+public:
+  FilterBank() = default;
+
+  /**
+   * Creates a bank of cascades of second-order sections, with zero state.
+   * @param bands The second-order sections of each band (one per row)
+   */
+  explicit FilterBank(const std::vector<SosArray>& bands);
+
+  /**
+   * Creates a bank of transfer functions, with zero state.
+   * @param bands The coefficients of each band (b and a)
+   */
+  explicit FilterBank(const std::vector<EigenCoeffs>& bands);
+
+  /**
+   * Filters the next chunk of the input with every band.
+   * @param x The input chunk
+   * @return The output chunk (one band per row)
+   */
+  RowMajorMatrixXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Filters the next chunk of the input with every band, writing into a
+   * caller-provided buffer.
+   * @param x The input chunk
+   * @param y The output chunk (one band per row, as many columns as x)
+   */
+  void process(const Eigen::Ref<const ArrayXd>& x,
+               Eigen::Ref<RowMajorMatrixXd>     y);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset();
+
+  Index bands() const { return m_bands; }
+  Index stages() const { return m_stages; }
+  Index order() const { return m_order; }
+
+private:
+  // Bands filtered together, one per lane of a 64-byte SIMD register
+  static constexpr Index kLanes{8};
+  using Lanes = Eigen::Array<double, kLanes, Eigen::Dynamic>;
+
+  void init(const Index bands, const Index stages, const Index order);
+
+  // Stages of order up to 8 run on kernels unrolled at compile time
+  // (FixedOrder > 0)
+  void runGroup(const Index group, const double* x, const Index length);
+  template <int FixedOrder>
+  void runGroup(const Index group, const double* x, const Index length);
+
+  Index m_bands{0};
+  Index m_stages{0};
+  Index m_order{0};
+
+  // Per group of kLanes bands: for every stage, b0..bN then a1..aN
+  // (normalised by a0), one band per row
+  std::vector<Lanes> m_coeffs{};
+
+  // Per group: the order state values of every stage
+  std::vector<Lanes> m_state{};
+
+  // Per group: the output of the current block, one band per row
+  std::vector<Lanes> m_block{};
+};
+
+/**
+ * Applies several cascades of second-order sections to one signal in a single
+ * pass.
+ * @param bands The second-order sections of each band (one per row)
+ * @param x The input signal
+ * @return The filtered signals (one band per row)
+ */
+RowMajorMatrixXd filterBank(const std::vector<SosArray>&     bands,
+                            const Eigen::Ref<const ArrayXd>& x);
+
+/**
+ * Applies several transfer functions to one signal in a single pass.
+ * @param bands The coefficients of each band (b and a)
+ * @param x The input signal
+ * @return The filtered signals (one band per row)
+ */
+RowMajorMatrixXd filterBank(const std::vector<EigenCoeffs>&  bands,
+                            const Eigen::Ref<const ArrayXd>& x);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FILTERBANK_H_
@@ -0,0 +1,156 @@
+#ifndef INCLUDE_INCLUDE_FILTERDISPATCH_H_
+#define INCLUDE_INCLUDE_FILTERDISPATCH_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+
+/**
+ * @file FilterDispatch.h
+ * @brief Automatic choice between time-domain and FFT filtering.
+ */
+namespace Nodex::Filter {
+// How a filter is applied to a signal
+enum FilterStrategy {
+  timeDomain,    // Recursion (linearFilter or sosFilter)
+  fftConvolution // Overlap-save convolution with the effective IR
+};
+
+/**
+ * Per-operation costs, in nanoseconds, from which the run time of each
+ * strategy is predicted. The defaults were measured on an AVX-512 desktop;
+ * calibrateFilterCostModel() replaces them with measurements of the host.
+ */
+struct FilterCostModel {
+  double sampleCost{2.2};  // linearFilter, per sample
+  double stateCost{0.9};   // linearFilter, per sample and state
+  double sectionCost{6.8}; // sosFilter, per sample and section
+  double fftCost{2.5};     // Overlap-save, per n log2 n of each n-point frame
+
+  /**
+   * Predicts the cost of linearFilter.
+   * @param filter The filter coefficients (b and a)
+   * @param length The signal length
+   * @return The predicted cost in nanoseconds
+   */
+  double timeDomainCost(const EigenCoeffs& filter, const Index length) const;
+
+  /**
+   * Predicts the cost of sosFilter.
+   * @param sections The number of second-order sections
+   * @param length The signal length
+   * @return The predicted cost in nanoseconds
+   */
+  double sosCost(const Index sections, const Index length) const;
+
+  /**
+   * Predicts the cost of overlap-save convolution, including the transform of
+   * the impulse response.
+   * @param irLength The impulse response length
+   * @param length The signal length
+   * @return The predicted cost in nanoseconds
+   */
+  double convolutionCost(const Index irLength, const Index length) const;
+};
+
+/**
+ * The strategy chosen for a filter and signal length, with the predictions
+ * it was chosen from.
+ */
+struct FilterPlan {
+  FilterStrategy strategy{timeDomain};
+  Index          irLength{0}; // Estimated effective IR (0 if not needed)
+  double         timeCost{0.0};
+  double         fftCost{0.0};
+};
+
+/**
+ * Returns the cost model used by filter().
+ * @return A copy of the process-wide cost model
+ */
+FilterCostModel filterCostModel();
+
+/**
+ * Replaces the cost model used by filter().
+ * @param model The new cost model
+ */
+void setFilterCostModel(const FilterCostModel& model);
+
+/**
+ * Measures the cost model on this host with a short microbenchmark (a few
+ * milliseconds) and installs it for filter().
+ * @param length The number of samples filtered by each measurement
+ * @return The measured cost model
+ */
+FilterCostModel calibrateFilterCostModel(const Index length = 1 << 15);
+
+/**
+ * Chooses how to apply a filter to a signal of the given length. The FFT
+ * path is only considered when the recursion could be slower than the
+ * cheapest convolution, and never for filters whose impulse response does
+ * not decay below epsilon within maxLength samples, which the convolution
+ * would truncate.
+ * @param filter The filter coefficients (b and a)
+ * @param length The signal length
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @param model The cost model
+ * @return The chosen strategy and the predicted costs
+ */
+FilterPlan planFilter(const EigenCoeffs& filter, const Index length,
+                      const double epsilon = 1e-12,
+                      const Index  maxLength = 10000,
+                      const FilterCostModel& model = filterCostModel());
+
+/**
+ * Chooses how to apply a cascade of second-order sections to a signal of the
+ * given length.
+ * @param sos The second-order sections (one per row)
+ * @param length The signal length
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @param model The cost model
+ * @return The chosen strategy and the predicted costs
+ */
+FilterPlan planFilter(const Eigen::Ref<const SosArray>& sos, const Index length,
+                      const double epsilon = 1e-12,
+                      const Index  maxLength = 10000,
+                      const FilterCostModel& model = filterCostModel());
+
+/**
+ * Applies a filter with linearFilter or fftFilter, whichever the cost model
+ * predicts to be faster.
+ * @param coeffs The filter coefficients (b and a)
+ * @param x The input signal
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The filtered output signal
+ */
+ArrayXd filter(const EigenCoeffs& coeffs, const Eigen::Ref<const ArrayXd>& x,
+               const double epsilon = 1e-12, const Index maxLength = 10000);
+
+/**
+ * Applies a cascade of second-order sections with sosFilter or with FFT
+ * convolution, whichever the cost model predicts to be faster.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signal
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The filtered output signal
+ */
+ArrayXd filter(const Eigen::Ref<const SosArray>& sos,
+               const Eigen::Ref<const ArrayXd>& x, const double epsilon = 1e-12,
+               const Index maxLength = 10000);
+
+/**
+ * Applies a filter with the faster of linearFilter and fftFilter.
+ * @param coeffs The filter coefficients (b and a)
+ * @param x The input signal
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The filtered output signal
+ */
+Signal filter(const Coeffs& coeffs, const Signal& x,
+              const double epsilon = 1e-12, const Index maxLength = 10000);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FILTERDISPATCH_H_
@@ -11,31 +11,52 @@
 namespace Nodex::Filter {
 using Eigen::ArrayXcd;
 using Eigen::ArrayXd;
+using Eigen::ArrayXf;
 using Eigen::Index;
 
 using RowMajorMatrixXd =
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using RowMajorMatrixXf =
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// One second-order section per row: b0, b1, b2, a0, a1, a2
+using SosArray = Eigen::Array<double, Eigen::Dynamic, 6, Eigen::RowMajor>;
 
 /**
- * Eigen-based filter coefficients representation.
+ * Eigen-based filter coefficients representation, in double (EigenCoeffs) or
+ * single (EigenCoeffsF) precision.
  */
-struct EigenCoeffs {
-  ArrayXd b{};
-  ArrayXd a{};
+template <typename Scalar>
+struct BasicEigenCoeffs {
+  using Array = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+
+  Array b{};
+  Array a{};
 
-  EigenCoeffs() = default;
+  BasicEigenCoeffs() = default;
 
-  EigenCoeffs(const Eigen::Ref<const ArrayXd>& bCoeffs,
-              const Eigen::Ref<const ArrayXd>& aCoeffs)
+  BasicEigenCoeffs(const Eigen::Ref<const Array>& bCoeffs,
+                   const Eigen::Ref<const Array>& aCoeffs)
       : b{bCoeffs}, a{aCoeffs} {};
 
-  EigenCoeffs(Coeffs& coeffs)
+  BasicEigenCoeffs(Coeffs& coeffs)
       : b{Eigen::Map<ArrayXd>{coeffs.b.data(),
-                               static_cast<Index>(coeffs.b.size())}},
+                               static_cast<Index>(coeffs.b.size())}
+              .template cast<Scalar>()},
         a{Eigen::Map<ArrayXd>{coeffs.a.data(),
-                               static_cast<Index>(coeffs.a.size())}} {}
+                               static_cast<Index>(coeffs.a.size())}
+              .template cast<Scalar>()} {}
+
+  // Converts the coefficients to another precision
+  template <typename Other>
+  explicit BasicEigenCoeffs(const BasicEigenCoeffs<Other>& other)
+      : b{other.b.template cast<Scalar>()},
+        a{other.a.template cast<Scalar>()} {}
 };
 
+using EigenCoeffs  = BasicEigenCoeffs<double>;
+using EigenCoeffsF = BasicEigenCoeffs<float>;
+
 /**
  * Eigen-based zero-pole-gain representation.
  */
@@ -70,6 +91,65 @@ RowMajorMatrixXd linearFilter(const EigenCoeffs&&                       filter,
                               const Eigen::Ref<const RowMajorMatrixXd>& x,
                               Eigen::Ref<RowMajorMatrixXd>              state);
 
+/**
+ * Applies a linear filter to the input signal x, writing the output into a
+ * caller-provided buffer. Matrix version.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param y The output signal (same shape as x, may alias x)
+ * @param state The filter state (should be maintained between calls)
+ */
+void linearFilter(const EigenCoeffs&&                       filter,
+                  const Eigen::Ref<const RowMajorMatrixXd>& x,
+                  Eigen::Ref<RowMajorMatrixXd>              y,
+                  Eigen::Ref<RowMajorMatrixXd>              state);
+
+/**
+ * Applies a different linear filter to every channel of the input signal x,
+ * all channels in one pass. Matrix version with per-channel coefficients.
+ * @param b The numerator coefficients (one row per channel)
+ * @param a The denominator coefficients (one row per channel; b and a of
+ * each row are divided by its a(0))
+ * @param x The input signal (one row per channel)
+ * @param state The filter state (one row per channel, should be maintained
+ * between calls)
+ * @return The filtered output signal
+ */
+RowMajorMatrixXd linearFilter(const Eigen::Ref<const RowMajorMatrixXd>& b,
+                              const Eigen::Ref<const RowMajorMatrixXd>& a,
+                              const Eigen::Ref<const RowMajorMatrixXd>& x,
+                              Eigen::Ref<RowMajorMatrixXd>              state);
+
+/**
+ * Applies a different linear filter to every channel of the input signal x,
+ * writing the output into a caller-provided buffer. Matrix version with
+ * per-channel coefficients.
+ * @param b The numerator coefficients (one row per channel)
+ * @param a The denominator coefficients (one row per channel; b and a of
+ * each row are divided by its a(0))
+ * @param x The input signal (one row per channel)
+ * @param y The output signal (same shape as x, may alias x)
+ * @param state The filter state (one row per channel)
+ */
+void linearFilter(const Eigen::Ref<const RowMajorMatrixXd>& b,
+                  const Eigen::Ref<const RowMajorMatrixXd>& a,
+                  const Eigen::Ref<const RowMajorMatrixXd>& x,
+                  Eigen::Ref<RowMajorMatrixXd>              y,
+                  Eigen::Ref<RowMajorMatrixXd>              state);
+
+/**
+ * Applies a linear filter to the input signal x using the given filter
+ * coefficients and state. Single precision matrix version, filtering twice as
+ * many channels per SIMD register as the double version.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param state The filter state (should be maintained between calls)
+ * @return The filtered output signal
+ */
+RowMajorMatrixXf linearFilter(const EigenCoeffsF&&                      filter,
+                              const Eigen::Ref<const RowMajorMatrixXf>& x,
+                              Eigen::Ref<RowMajorMatrixXf>              state);
+
 /**
  * Applies a linear filter to the input signal x using the given filter
  * coefficients and state.
@@ -77,6 +157,8 @@ RowMajorMatrixXd linearFilter(const EigenCoeffs&&                       filter,
  * @param x The input signal
  * @param state The filter state (should be maintained between calls)
  * @return The filtered output signal
+ * @throws std::runtime_error if the state holds fewer values than the filter
+ * has delays
  */
 ArrayXd linearFilter(const EigenCoeffs&               filter,
                      const Eigen::Ref<const ArrayXd>& x,
@@ -92,17 +174,352 @@ ArrayXd linearFilter(const EigenCoeffs&               filter,
 ArrayXd linearFilter(const EigenCoeffs&               filter,
                      const Eigen::Ref<const ArrayXd>& x);
 
+/**
+ * Applies a linear filter to the input signal x, writing the output into a
+ * caller-provided buffer. Filters of order up to 8, or with as many b as a
+ * coefficients, run without any heap allocation.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param y The output signal (same length as x, may alias x)
+ * @param state The filter state (should be maintained between calls)
+ */
+void linearFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
+                  Eigen::Ref<ArrayXd> y, Eigen::Ref<ArrayXd> state);
+
+/**
+ * Applies a linear filter to the input signal x in single precision, for
+ * float32 data that should not be converted. Samples, coefficients and state
+ * are all float, so the recurrence runs at twice the SIMD width of double.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param state The filter state (should be maintained between calls)
+ * @return The filtered output signal
+ */
+ArrayXf linearFilter(const EigenCoeffsF&              filter,
+                     const Eigen::Ref<const ArrayXf>& x,
+                     Eigen::Ref<ArrayXf>              state);
+
+/**
+ * Applies a linear filter to the input signal x in single precision. No state
+ * version.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @return The filtered output signal
+ */
+ArrayXf linearFilter(const EigenCoeffsF&              filter,
+                     const Eigen::Ref<const ArrayXf>& x);
+
+/**
+ * Applies a linear filter to a single precision signal, accumulating in double
+ * precision: the input and output are float, while the coefficients, the
+ * state and the recurrence are double. Suited to high-order or narrow-band
+ * filters whose poles are too close to the unit circle for float.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param state The filter state (should be maintained between calls)
+ * @return The filtered output signal
+ */
+ArrayXf linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXf>& x,
+                     Eigen::Ref<ArrayXd>              state);
+
+/**
+ * Applies a linear filter to a single precision signal, accumulating in double
+ * precision. No state version.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @return The filtered output signal
+ */
+ArrayXf linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXf>& x);
+
+/**
+ * Applies a linear filter to a long signal using several threads. The signal
+ * is split into blocks that are filtered concurrently from rest; the state at
+ * each block boundary is then recovered by propagating the previous block's
+ * state through the state transition matrix (A^L), and each block is corrected
+ * with the response to that state. The output matches the serial filter up to
+ * rounding.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param state The filter state (should be maintained between calls)
+ * @param blocks The number of blocks (0 uses one block per OpenMP thread)
+ * @return The filtered output signal
+ */
+ArrayXd parallelLinearFilter(const EigenCoeffs&               filter,
+                             const Eigen::Ref<const ArrayXd>& x,
+                             Eigen::Ref<ArrayXd> state, Index blocks = 0);
+
+/**
+ * Applies a linear filter to a long signal using several threads. No state
+ * version.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param blocks The number of blocks (0 uses one block per OpenMP thread)
+ * @return The filtered output signal
+ */
+ArrayXd parallelLinearFilter(const EigenCoeffs&               filter,
+                             const Eigen::Ref<const ArrayXd>& x,
+                             const Index                      blocks = 0);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x using the
+ * given state.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signal
+ * @param state The filter state, two values per section (should be maintained
+ * between calls)
+ * @return The filtered output signal
+ */
+ArrayXd sosFilter(const Eigen::Ref<const SosArray>& sos,
+                  const Eigen::Ref<const ArrayXd>&  x,
+                  Eigen::Ref<ArrayXd>               state);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x. No state
+ * version.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signal
+ * @return The filtered output signal
+ */
+ArrayXd sosFilter(const Eigen::Ref<const SosArray>& sos,
+                  const Eigen::Ref<const ArrayXd>&  x);
+
+/**
+ * Applies a cascade of second-order sections to the input signal x, writing
+ * the output into a caller-provided buffer.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signal
+ * @param y The output signal (same length as x, may alias x)
+ * @param state The filter state, two values per section
+ */
+void sosFilter(const Eigen::Ref<const SosArray>& sos,
+               const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y,
+               Eigen::Ref<ArrayXd> state);
+
+/**
+ * Applies a different cascade of second-order sections to every channel of
+ * the input signal x, all channels in one pass.
+ * @param sos The sections of every channel, one channel per row: b0, b1, b2,
+ * a0, a1, a2 of the first section, then of the second, ...
+ * @param x The input signal (one row per channel)
+ * @param state The filter state, two values per section (one row per channel,
+ * should be maintained between calls)
+ * @return The filtered output signal
+ */
+RowMajorMatrixXd
+sosFilterMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& sos,
+                      const Eigen::Ref<const RowMajorMatrixXd>& x,
+                      Eigen::Ref<RowMajorMatrixXd>              state);
+
+/**
+ * Applies a different cascade of second-order sections to every channel of
+ * the input signal x, writing the output into a caller-provided buffer.
+ * @param sos The sections of every channel (one channel per row, six
+ * coefficients per section)
+ * @param x The input signal (one row per channel)
+ * @param y The output signal (same shape as x, may alias x)
+ * @param state The filter state, two values per section (one row per channel)
+ */
+void sosFilterMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& sos,
+                           const Eigen::Ref<const RowMajorMatrixXd>& x,
+                           Eigen::Ref<RowMajorMatrixXd>              y,
+                           Eigen::Ref<RowMajorMatrixXd>              state);
+
+/**
+ * Computes the initial state of linearFilter for the steady state of a unit
+ * step input (as scipy's lfilter_zi). Scaling it by the first input sample
+ * avoids the start-up transient of a signal with an offset.
+ * @param filter The filter coefficients (b and a)
+ * @return The initial state (max(b.size(), a.size()) - 1 values)
+ */
+ArrayXd linearFilterZi(const EigenCoeffs& filter);
+
+/**
+ * Computes the initial state of sosFilter for the steady state of a unit step
+ * input (as scipy's sosfilt_zi).
+ * @param sos The second-order sections (one per row)
+ * @return The initial state (two values per section)
+ */
+ArrayXd sosFilterZi(const Eigen::Ref<const SosArray>& sos);
+
+/**
+ * Applies a filter forwards and backwards for zero phase distortion. The
+ * signal is extended at both ends by odd reflection, and each pass starts from
+ * the steady state for its first sample, so the edges have no transient.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal (longer than the padding)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the number of coefficients)
+ * @return The filtered output signal
+ */
+ArrayXd filtFilt(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
+                 const Index padLength = -1);
+
+/**
+ * Applies a cascade of second-order sections forwards and backwards for zero
+ * phase distortion.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signal (longer than the padding)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the order plus one)
+ * @return The filtered output signal
+ */
+ArrayXd filtFilt(const Eigen::Ref<const SosArray>& sos,
+                 const Eigen::Ref<const ArrayXd>&  x,
+                 const Index                       padLength = -1);
+
+/**
+ * Applies a filter forwards and backwards to every row of x, with the rows
+ * processed in parallel.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signals (one channel per row)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the number of coefficients)
+ * @return The filtered output signals
+ */
+RowMajorMatrixXd
+filtFiltMultichannel(const EigenCoeffs&                        filter,
+                     const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Index                               padLength = -1);
+
+/**
+ * Applies a cascade of second-order sections forwards and backwards to every
+ * row of x, with the rows processed in parallel. Matrix version.
+ * @param sos The second-order sections (one per row)
+ * @param x The input signals (one channel per row)
+ * @param padLength The number of samples to extend at each end (-1 uses three
+ * times the order plus one)
+ * @return The filtered output signals
+ */
+RowMajorMatrixXd
+filtFiltMultichannel(const Eigen::Ref<const SosArray>&         sos,
+                     const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Index                               padLength = -1);
+
+/**
+ * Estimates how many samples the impulse response of a filter takes to decay
+ * below epsilon, from the radius of its dominant pole (with a safety margin).
+ * Unstable or marginally stable filters return maxLength.
+ * @param filter The filter coefficients (b and a)
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The estimated effective impulse response length
+ */
+Index estimateIRLength(const EigenCoeffs& filter, const double epsilon,
+                       const Index maxLength);
+
+/**
+ * Estimates how many samples the impulse response of a filter takes to decay
+ * below epsilon, from the radius of its dominant pole (with a safety margin).
+ * @param filter The filter zeros, poles and gain
+ * @param epsilon The tolerance for the effective impulse response
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The estimated effective impulse response length
+ */
+Index estimateIRLength(const EigenZPK& filter, const double epsilon,
+                       const Index maxLength);
+
+/**
+ * Computes the effective impulse response of a filter given its coefficients.
+ * Only the samples estimated from the dominant pole radius are simulated, and
+ * the simulation is extended while the tail still exceeds epsilon.
+ * @param filter The filter coefficients (b and a)
+ * @param epsilon The tolerance for the effective impulse response calculation
+ * @param maxLength The maximum length of the effective impulse response
+ * @return The effective impulse response
+ */
+ArrayXd findEffectiveIR(const EigenCoeffs& filter, const double epsilon,
+                        const Index maxLength);
+
 /**
  * Applies an FFT-based filter to the input signal x using the given filter
- * coefficients.
+ * coefficients. The effective impulse response is convolved with the input by
+ * overlap-save; use FftConvolver directly to reuse the impulse response
+ * spectrum across calls.
  * @param filter The filter coefficients (b and a)
  * @param x The input signal
  * @param epsilon Small constant to account for approximation error
- * @param maxLength Maximum length for FFT (zero-padded if necessary)
+ * @param maxLength Maximum length of the effective impulse response
  * @return The filtered output signal
  */
 ArrayXd fftFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
-                  const double epsilon, const std::size_t maxLength);
+                  const double epsilon, const Index maxLength);
+
+/**
+ * Applies an FFT-based filter to a single precision signal. The impulse
+ * response and the transforms are computed in double precision, converting
+ * the signal one overlap-save block at a time so that no double copy of the
+ * whole signal is made.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param epsilon Small constant to account for approximation error
+ * @param maxLength Maximum length of the effective impulse response
+ * @return The filtered output signal
+ */
+ArrayXf fftFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXf>& x,
+                  const double epsilon, const Index maxLength);
+
+/**
+ * Applies an FFT-based filter to a single precision signal with single
+ * precision coefficients.
+ * @param filter The filter coefficients (b and a)
+ * @param x The input signal
+ * @param epsilon Small constant to account for approximation error
+ * @param maxLength Maximum length of the effective impulse response
+ * @return The filtered output signal
+ */
+ArrayXf fftFilter(const EigenCoeffsF&              filter,
+                  const Eigen::Ref<const ArrayXf>& x, const double epsilon,
+                  const Index maxLength);
+
+/**
+ * Frequency response of a filter on a grid of normalised frequencies.
+ */
+struct FrequencyResponse {
+  ArrayXd  w{};          // Frequencies in rad/sample
+  ArrayXcd h{};          // Complex response
+  ArrayXd  magnitude{};  // |h|
+  ArrayXd  phase{};      // arg(h) in rad, wrapped to [-pi, pi]
+  ArrayXd  groupDelay{}; // -d phase / dw in samples
+};
+
+/**
+ * Computes the frequency response of a digital filter given in zero-pole-gain
+ * form.
+ * @param digitalFilter The digital filter in zero-pole-gain representation
+ * @param w The frequencies in rad/sample
+ * @return The complex frequency response
+ */
+ArrayXcd freqz(const EigenZPK&                  digitalFilter,
+               const Eigen::Ref<const ArrayXd>& w);
+
+/**
+ * Computes the frequency response of a filter on n uniformly spaced
+ * frequencies, w = pi k / n (or 2 pi k / n for the whole circle). Short
+ * filters (b and a together with at most 3 log2(nfft) taps, nfft = 2n, or n
+ * for the whole circle) are evaluated directly with Horner's scheme, in
+ * O(n taps). Longer ones use four zero-padded real FFTs of b and a and of
+ * their coefficients weighted by the tap index (for the group delay), in
+ * O(n log n).
+ * @param filter The filter coefficients (b and a)
+ * @param n The number of frequencies
+ * @param whole Whether the grid covers [0, 2 pi) instead of [0, pi)
+ * @return The response, magnitude, phase and group delay
+ */
+FrequencyResponse freqz(const EigenCoeffs& filter, const Index n = 512,
+                        const bool whole = false);
+
+/**
+ * Computes the frequency response of a filter on arbitrary frequencies. b and
+ * a are evaluated with Horner's scheme over blocks of frequencies, which are
+ * vectorised across the block and spread over threads.
+ * @param filter The filter coefficients (b and a)
+ * @param w The frequencies in rad/sample
+ * @return The response, magnitude, phase and group delay
+ */
+FrequencyResponse freqz(const EigenCoeffs&               filter,
+                        const Eigen::Ref<const ArrayXd>& w);
 
 /**
  * Converts zero-pole-gain representation to transfer function coefficients.
@@ -111,6 +528,13 @@ ArrayXd fftFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
  */
 EigenCoeffs zpk2tf(const EigenZPK& zpk);
 
+/**
+ * Converts zero-pole-gain representation to second-order sections.
+ * @param zpk The zero-pole-gain representation
+ * @return The second-order sections (one per row)
+ */
+SosArray zpk2sos(const EigenZPK& zpk);
+
 /**
  * Converts transfer function coefficients to zero-pole-gain representation.
  * @param tf The transfer function coefficients (b and a)
@@ -0,0 +1,90 @@
+#ifndef INCLUDE_INCLUDE_FILTERORDER_H_
+#define INCLUDE_INCLUDE_FILTERORDER_H_
+
+#include "DesignCache.h"
+#include "Filter.h"
+
+/**
+ * @file FilterOrder.h
+ * @brief Minimum-order IIR designs from passband and stopband specifications.
+ */
+namespace Nodex::Filter {
+/**
+ * Passband and stopband requirements of a digital filter. Frequencies are in
+ * the units of fs. The band edges must be ordered as the mode implies:
+ * passFreq < stopFreq (lowpass), stopFreq < passFreq (highpass),
+ * stopFreq < passFreq < passFreq2 < stopFreq2 (bandpass) and
+ * passFreq < stopFreq < stopFreq2 < passFreq2 (bandstop).
+ */
+struct FilterSpec {
+  Mode   mode{lowpass};
+  double passFreq{0.0};
+  double stopFreq{0.0};
+
+  // Upper edges, for the bandpass and bandstop modes
+  double passFreq2{0.0};
+  double stopFreq2{0.0};
+
+  double fs{1.0};
+
+  // Maximum loss in the passband and minimum attenuation in the stopband (dB)
+  double passRipple{1.0};
+  double stopAttenuation{40.0};
+
+  bool operator==(const FilterSpec&) const = default;
+};
+
+/**
+ * Lowest order of a filter family that meets a specification, and the
+ * cutoff frequencies to design it with (fc2 only for bandpass and bandstop).
+ */
+struct OrderEstimate {
+  int    order{0};
+  double fc{0.0};
+  double fc2{0.0};
+};
+
+/**
+ * Lowest order of a Butterworth filter that meets the specification, with the
+ * cutoff (-3 dB) frequencies that match the passband edges exactly.
+ * @param spec The passband and stopband requirements
+ * @return The order and the cutoff frequencies
+ */
+OrderEstimate buttord(const FilterSpec& spec);
+
+/**
+ * Lowest order of a Chebyshev type I filter that meets the specification. The
+ * cutoff frequencies are the passband edges (ripple = spec.passRipple).
+ * @param spec The passband and stopband requirements
+ * @return The order and the cutoff frequencies
+ */
+OrderEstimate cheb1ord(const FilterSpec& spec);
+
+/**
+ * Lowest order of a Chebyshev type II filter that meets the specification.
+ * The cutoff frequencies are the stopband edges of the design
+ * (attenuation = spec.stopAttenuation).
+ * @param spec The passband and stopband requirements
+ * @return The order and the cutoff frequencies
+ */
+OrderEstimate cheb2ord(const FilterSpec& spec);
+
+/**
+ * Lowest order of an elliptic filter that meets the specification. The cutoff
+ * frequencies are the passband edges.
+ * @param spec The passband and stopband requirements
+ * @return The order and the cutoff frequencies
+ */
+OrderEstimate ellipord(const FilterSpec& spec);
+
+/**
+ * Picks the cheapest design meeting the specification: the family needing
+ * the fewest second-order sections, the earliest of butter, cheb1, cheb2 and
+ * ellip on ties (the flattest passband).
+ * @param spec The passband and stopband requirements
+ * @return The design parameters (for designFilter or the design cache)
+ */
+DesignKey designFromSpec(const FilterSpec& spec);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FILTERORDER_H_
@@ -0,0 +1,186 @@
+#ifndef INCLUDE_INCLUDE_FIR_H_
+#define INCLUDE_INCLUDE_FIR_H_
+
+#include "Convolution.h"
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * @file Fir.h
+ * @brief FIR filter design and application.
+ */
+namespace Nodex::Filter {
+// Window functions for windowed FIR design
+enum Window {
+  rectangular,
+  hann,
+  hamming,
+  blackman,
+  kaiser,
+  maxWindow
+};
+
+/**
+ * Computes a symmetric window.
+ * @param type The window type
+ * @param n The window length
+ * @param beta The shape parameter of the Kaiser window
+ * @return The window samples
+ */
+ArrayXd getWindow(const Window type, const Index n, const double beta = 8.6);
+
+/**
+ * Designs a linear phase lowpass or highpass FIR filter with the window
+ * method. The taps are scaled for unit gain at DC (lowpass) or at the Nyquist
+ * frequency (highpass).
+ * @param numtaps The number of taps (odd for a highpass)
+ * @param fc The cutoff frequency
+ * @param fs The sampling frequency
+ * @param mode The filter mode (lowpass or highpass)
+ * @param window The window type
+ * @param beta The shape parameter of the Kaiser window
+ * @return The filter taps
+ */
+ArrayXd firwin(const Index numtaps, const double fc, const double fs,
+               const Mode mode = lowpass, const Window window = hamming,
+               const double beta = 8.6);
+
+/**
+ * Designs a linear phase bandpass or bandstop FIR filter with the window
+ * method. The taps are scaled for unit gain at the centre of the passband
+ * (bandpass) or at DC (bandstop).
+ * @param numtaps The number of taps (odd for a bandstop)
+ * @param fLow The lower cutoff frequency
+ * @param fHigh The upper cutoff frequency
+ * @param fs The sampling frequency
+ * @param mode The filter mode (bandpass or bandstop)
+ * @param window The window type
+ * @param beta The shape parameter of the Kaiser window
+ * @return The filter taps
+ */
+ArrayXd firwin(const Index numtaps, const double fLow, const double fHigh,
+               const double fs, const Mode mode = bandpass,
+               const Window window = hamming, const double beta = 8.6);
+
+/**
+ * Designs a linear phase FIR filter with the Parks-McClellan (Remez exchange)
+ * algorithm, minimising the maximum weighted error from a piecewise constant
+ * response.
+ * @param numtaps The number of taps
+ * @param bands The band edges, in increasing pairs between 0 and fs / 2
+ * @param desired The desired gain of each band
+ * @param weights The weight of each band (empty for equal weights)
+ * @param fs The sampling frequency
+ * @param maxIterations The maximum number of exchange iterations
+ * @return The filter taps
+ */
+ArrayXd remez(const Index numtaps, const std::vector<double>& bands,
+              const std::vector<double>& desired,
+              const std::vector<double>& weights = {}, const double fs = 1.0,
+              const int maxIterations = 40);
+
+/**
+ * Streaming FIR filter. Short filters run a direct-form kernel that
+ * accumulates one tap at a time over blocks of samples, which vectorises
+ * across the samples; long filters switch to overlap-save FFT convolution.
+ * Several channels can be filtered at once, one per row, each with its own
+ * state.
+ */
+class FirFilter {
+public:
+  // How the filter is applied
+  enum Method { automatic, direct, fft };
+
+  FirFilter() = default;
+
+  /**
+   * Creates a filter with zero initial state.
+   * @param taps The filter taps
+   * @param channels The number of channels
+   * @param method The kernel to use (automatic picks it from the length)
+   */
+  explicit FirFilter(const Eigen::Ref<const ArrayXd>& taps,
+                     const Index channels = 1, const Method method = automatic);
+
+  /**
+   * Filters the next chunk of a single channel stream.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  ArrayXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Filters the next chunk of a single channel stream, writing into a
+   * caller-provided buffer.
+   * @param x The input chunk
+   * @param y The output chunk (same length as x, may alias x)
+   */
+  void process(const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y);
+
+  /**
+   * Filters the next chunk of a single channel stream.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  Signal process(const Signal& x);
+
+  /**
+   * Filters the next chunk of a multichannel stream.
+   * @param x The input chunk (one channel per row)
+   * @return The output chunk (one channel per row)
+   */
+  RowMajorMatrixXd
+  processMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset();
+
+  Index numTaps() const { return m_taps.size(); }
+  Index channels() const { return m_channels; }
+  bool  usesFft() const { return !m_convolvers.empty(); }
+
+private:
+  void processChannel(const Index channel, const double* x, double* y,
+                      const Index length);
+
+  ArrayXd m_taps{};
+  Index   m_channels{0};
+
+  // Direct form: per channel, the last numTaps - 1 inputs, then a block
+  RowMajorMatrixXd m_buffer{};
+
+  // FFT: one convolver per channel
+  std::vector<FftConvolver> m_convolvers{};
+};
+
+/**
+ * Filters a signal with an FIR filter, picking the direct or FFT kernel from
+ * the number of taps.
+ * @param taps The filter taps
+ * @param x The input signal
+ * @return The filtered signal
+ */
+ArrayXd firFilter(const Eigen::Ref<const ArrayXd>& taps,
+                  const Eigen::Ref<const ArrayXd>& x);
+
+/**
+ * Filters a signal with an FIR filter.
+ * @param taps The filter taps
+ * @param x The input signal
+ * @return The filtered signal
+ */
+Signal firFilter(const std::vector<double>& taps, const Signal& x);
+
+/**
+ * Filters several channels with the same FIR filter, in parallel.
+ * @param taps The filter taps
+ * @param x The input signals (one channel per row)
+ * @return The filtered signals (one channel per row)
+ */
+RowMajorMatrixXd
+firFilterMultichannel(const Eigen::Ref<const ArrayXd>&          taps,
+                      const Eigen::Ref<const RowMajorMatrixXd>& x);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FIR_H_
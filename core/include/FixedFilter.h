@@ -0,0 +1,110 @@
+#ifndef INCLUDE_INCLUDE_FIXEDFILTER_H_
+#define INCLUDE_INCLUDE_FIXEDFILTER_H_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+/**
+ * @file FixedFilter.h
+ * @brief Linear filters with a compile-time number of coefficients.
+ */
+namespace Nodex::Filter {
+/**
+ * Transposed direct form II filter with NB numerator and NA denominator
+ * coefficients fixed at compile time. Coefficients and state live in
+ * std::array members and the per-sample state update is unrolled, so the
+ * whole recurrence stays in registers. The denominator is assumed to be
+ * normalised (a[0] == 1), as in linearFilter. The recurrence runs in Scalar
+ * precision whatever the sample type.
+ */
+template <int NB, int NA, typename Scalar = double>
+class FixedFilter {
+  static_assert(NB > 0 && NA > 0, "A filter needs at least one coefficient");
+
+public:
+  static constexpr int kStates{std::max(NB, NA) - 1};
+
+  FixedFilter() = default;
+
+  /**
+   * Creates a filter with zero initial state.
+   * @param b The NB numerator coefficients
+   * @param a The NA denominator coefficients
+   */
+  FixedFilter(const Scalar* b, const Scalar* a) {
+    std::copy_n(b, NB, m_b.begin());
+    std::copy_n(a, NA, m_a.begin());
+  }
+
+  /**
+   * Filters n samples, carrying the state across calls. x and y may alias.
+   * @param x The input samples
+   * @param y The output samples
+   * @param n The number of samples
+   */
+  template <typename Sample>
+  void process(const Sample* x, Sample* y, const Eigen::Index n) {
+    std::array<Scalar, kStates> s{m_state};
+
+    for (Eigen::Index k{0}; k < n; ++k) {
+      const Scalar xk{static_cast<Scalar>(x[k])};
+      const Scalar yk{next<-1>(s) + m_b[0] * xk};
+
+      update(s, xk, yk, std::make_integer_sequence<int, kStates>{});
+      y[k] = static_cast<Sample>(yk);
+    }
+
+    m_state = s;
+  }
+
+  // Copies the state from (to) kStates values
+  void loadState(const Scalar* state) {
+    std::copy_n(state, kStates, m_state.begin());
+  }
+  void storeState(Scalar* state) const {
+    std::copy_n(m_state.begin(), kStates, state);
+  }
+
+private:
+  template <int J>
+  Scalar bTerm(const Scalar xk) const {
+    if constexpr (J < NB)
+      return m_b[J] * xk;
+    else
+      return Scalar{0};
+  }
+
+  template <int J>
+  Scalar aTerm(const Scalar yk) const {
+    if constexpr (J < NA)
+      return m_a[J] * yk;
+    else
+      return Scalar{0};
+  }
+
+  // s[J + 1], or zero past the last state
+  template <int J>
+  static Scalar next(const std::array<Scalar, kStates>& s) {
+    if constexpr (J + 1 < kStates)
+      return s[J + 1];
+    else
+      return Scalar{0};
+  }
+
+  // s[j] = s[j + 1] + b[j + 1] x - a[j + 1] y, expanded in increasing j so
+  // that each state is read before it is overwritten
+  template <int... J>
+  void update(std::array<Scalar, kStates>& s, const Scalar xk, const Scalar yk,
+              std::integer_sequence<int, J...>) const {
+    ((s[J] = next<J>(s) + bTerm<J + 1>(xk) - aTerm<J + 1>(yk)), ...);
+  }
+
+  std::array<Scalar, NB>      m_b{};
+  std::array<Scalar, NA>      m_a{};
+  std::array<Scalar, kStates> m_state{};
+};
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FIXEDFILTER_H_
@@ -0,0 +1,156 @@
+#ifndef INCLUDE_INCLUDE_FIXEDPOINT_H_
+#define INCLUDE_INCLUDE_FIXEDPOINT_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file FixedPoint.h
+ * @brief Fixed-point (Q15/Q31) second-order section filtering.
+ */
+namespace Nodex::Filter {
+/**
+ * Integer arithmetic of a fixed-point filter: how the coefficients are
+ * quantized and how the accumulator is brought back to the sample format.
+ */
+struct FixedPointFormat {
+  // Rounding of the accumulator when it is shifted back to a sample
+  enum Rounding { truncate, nearest };
+
+  // Fractional bits of the coefficients (-1 picks the most that fit)
+  int      coeffBits{-1};
+  Rounding rounding{nearest};
+
+  // Clamp out-of-range outputs to the sample range instead of wrapping
+  bool saturate{true};
+};
+
+// Quantized second-order sections and the frequency response error they cause
+struct SosQuantization {
+  // One section per row: b0, b1, b2, a1, a2 scaled by 2^coeffBits
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 5, Eigen::RowMajor> coeffs{};
+  int                                                           coeffBits{0};
+
+  // The sections the integer coefficients represent (a0 == 1)
+  SosArray sos{};
+
+  // Largest |H_quantized - H| over the frequency grid, in linear units and in
+  // dB relative to the peak of |H|
+  double maxError{0.0};
+  double maxErrorDb{0.0};
+};
+
+/**
+ * Quantizes second-order sections to integer coefficients, normalising each
+ * section by a0, and compares the frequency response of the quantized
+ * sections with the original one (freqz over n frequencies).
+ * @param sos The second-order sections (one per row)
+ * @param wordBits The width of a coefficient (16 for Q15, 32 for Q31)
+ * @param coeffBits The fractional bits (-1 picks the most that fit)
+ * @param n The number of frequencies of the comparison
+ * @return The quantized sections and their response error
+ */
+SosQuantization quantizeSos(const Eigen::Ref<const SosArray>& sos,
+                            const int wordBits, const int coeffBits = -1,
+                            const Index n = 512);
+
+/**
+ * Cascade of second-order sections in integer arithmetic, for int16 (Q15) or
+ * int32 (Q31) samples. Each section runs in direct form I, as fixed-point
+ * firmware does: products of samples and coefficients are summed in a 64-bit
+ * accumulator, which is shifted back by the coefficient fractional bits
+ * (rounded or truncated) and saturated or wrapped to the sample range.
+ *
+ * The accumulator must not overflow for any samples, so the sum of the
+ * absolute integer coefficients of a section times 2^31 (Q31) must stay below
+ * 2^63. Picked fractional bits are reduced until it does; explicit ones that
+ * do not fit are rejected.
+ *
+ * Samples are processed in blocks: the feed-forward part of each section is
+ * vectorised over the block and only the feedback recursion runs sample by
+ * sample. The output is bit-identical whatever the chunking of the stream.
+ */
+template <typename Sample>
+class FixedSosFilter {
+public:
+  using Accumulator = std::int64_t;
+
+  FixedSosFilter() = default;
+
+  /**
+   * Creates a filter with zero initial state.
+   * @param sos The second-order sections (one per row)
+   * @param format The coefficient format, rounding and overflow handling
+   * @throws std::runtime_error if the coefficients do not fit the word, or
+   * could overflow the accumulator with the requested fractional bits
+   */
+  explicit FixedSosFilter(const Eigen::Ref<const SosArray>& sos,
+                          const FixedPointFormat&           format = {});
+
+  /**
+   * Filters the next n samples of the stream.
+   * @param x The input samples
+   * @param y The output samples (may alias x)
+   * @param n The number of samples
+   */
+  void process(const Sample* x, Sample* y, const Index n);
+
+  /**
+   * Filters the next chunk of the stream.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  std::vector<Sample> process(const std::vector<Sample>& x);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset();
+
+  const SosQuantization&  quantization() const { return m_quantization; }
+  const FixedPointFormat& format() const { return m_format; }
+
+private:
+  template <bool Saturate>
+  void runSection(const Index section, Sample* data, const Index length);
+
+  SosQuantization  m_quantization{};
+  FixedPointFormat m_format{};
+
+  // Per section: x[n-1], x[n-2], y[n-1], y[n-2]
+  Eigen::Array<Sample, Eigen::Dynamic, 4, Eigen::RowMajor> m_state{};
+
+  // Block scratch: two past inputs then the block, and the accumulators
+  std::vector<Sample>      m_input{};
+  std::vector<Accumulator> m_accumulator{};
+};
+
+using SosFilterQ15 = FixedSosFilter<std::int16_t>;
+using SosFilterQ31 = FixedSosFilter<std::int32_t>;
+
+/**
+ * Applies a cascade of second-order sections to int16 samples in Q15
+ * arithmetic.
+ * @param sos The second-order sections (one per row)
+ * @param x The input samples
+ * @param format The coefficient format, rounding and overflow handling
+ * @return The output samples
+ */
+std::vector<std::int16_t> sosFilterQ15(const Eigen::Ref<const SosArray>& sos,
+                                       const std::vector<std::int16_t>&  x,
+                                       const FixedPointFormat& format = {});
+
+/**
+ * Applies a cascade of second-order sections to int32 samples in Q31
+ * arithmetic.
+ * @param sos The second-order sections (one per row)
+ * @param x The input samples
+ * @param format The coefficient format, rounding and overflow handling
+ * @return The output samples
+ */
+std::vector<std::int32_t> sosFilterQ31(const Eigen::Ref<const SosArray>& sos,
+                                       const std::vector<std::int32_t>&  x,
+                                       const FixedPointFormat& format = {});
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_FIXEDPOINT_H_
@@ -0,0 +1,164 @@
+#ifndef INCLUDE_INCLUDE_RESAMPLE_H_
+#define INCLUDE_INCLUDE_RESAMPLE_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+
+/**
+ * @file Resample.h
+ * @brief Polyphase rational resampling.
+ */
+namespace Nodex::Filter {
+/**
+ * Streaming polyphase upsample-filter-downsample engine. Conceptually the input
+ * is upsampled by up (zero stuffing), filtered with h and downsampled by down,
+ * but only the outputs that are kept are computed, and each of them only
+ * touches the taps of h that meet non-zero input samples: h is split into up
+ * phases of ceil(len(h) / up) taps, and every output is one dot product with
+ * a single phase.
+ *
+ * The input can be processed in chunks of any length; the outputs are the
+ * same as for the whole signal. Several channels can be resampled at once,
+ * one per row, each with its own history.
+ */
+class PolyphaseResampler {
+public:
+  PolyphaseResampler() = default;
+
+  /**
+   * Creates a resampler with the given filter.
+   * @param up The upsampling factor
+   * @param down The downsampling factor
+   * @param h The filter, running at up times the input rate
+   * @param delay Upsampled samples dropped at the start of the output, e.g.
+   * (len(h) - 1) / 2 to compensate the delay of a linear phase filter
+   * @param channels The number of channels
+   */
+  PolyphaseResampler(const Index up, const Index down,
+                     const Eigen::Ref<const ArrayXd>& h, const Index delay = 0,
+                     const Index channels = 1);
+
+  /**
+   * Creates a resampler with the anti-aliasing filter of resampleFilter,
+   * compensating its delay.
+   * @param up The upsampling factor
+   * @param down The downsampling factor
+   * @param channels The number of channels
+   */
+  PolyphaseResampler(const Index up, const Index down,
+                     const Index channels = 1);
+
+  /**
+   * Resamples the next chunk of a single channel stream.
+   * @param x The input chunk
+   * @return The outputs that became available (outputLength(x.size()))
+   */
+  ArrayXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Resamples the next chunk of a single channel stream.
+   * @param x The input chunk
+   * @return The outputs that became available (outputLength(x.size()))
+   */
+  Signal process(const Signal& x);
+
+  /**
+   * Resamples the next chunk of a multichannel stream.
+   * @param x The input chunk (one channel per row)
+   * @return The outputs that became available, one channel per row
+   */
+  RowMajorMatrixXd
+  processMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x);
+
+  /**
+   * Number of outputs that the next chunk of the given length produces.
+   * @param inputLength The length of the next input chunk
+   * @return The number of outputs
+   */
+  Index outputLength(const Index inputLength) const;
+
+  // Clears the input history so the next chunk starts a new stream
+  void reset();
+
+  Index up() const { return m_up; }
+  Index down() const { return m_down; }
+  Index channels() const { return m_buffer.rows(); }
+  Index tapsPerPhase() const { return m_taps; }
+
+private:
+  void run(const Index length, Eigen::Ref<RowMajorMatrixXd> y);
+
+  Index m_up{1};
+  Index m_down{1};
+  Index m_delay{0};
+  Index m_taps{1};
+
+  // One phase per row, time reversed so that each output is a dot product
+  // with a contiguous run of input samples
+  RowMajorMatrixXd m_phases{};
+
+  // Upsampled position of the next output, from the start of the next chunk
+  Index m_next{0};
+
+  // Per channel: the last m_taps - 1 input samples, then the current chunk
+  RowMajorMatrixXd m_buffer{};
+};
+
+/**
+ * Designs the anti-aliasing lowpass filter for resampling by up / down: a
+ * Kaiser windowed sinc (beta 5) with 10 max(up, down) taps on each side of
+ * the centre, cutoff at the lower of the two Nyquist frequencies and a gain
+ * of up to make up for the zero stuffing.
+ * @param up The upsampling factor
+ * @param down The downsampling factor
+ * @return The filter taps (odd length, linear phase)
+ */
+ArrayXd resampleFilter(const Index up, const Index down);
+
+/**
+ * Upsamples, filters and downsamples a signal. The output is the full
+ * convolution of the upsampled signal with h, downsampled.
+ * @param h The filter, running at up times the input rate
+ * @param x The input signal
+ * @param up The upsampling factor
+ * @param down The downsampling factor
+ * @return The output, ((len(x) - 1) up + len(h) - 1) / down + 1 samples
+ */
+ArrayXd upfirdn(const Eigen::Ref<const ArrayXd>& h,
+                const Eigen::Ref<const ArrayXd>& x, const Index up,
+                const Index down);
+
+/**
+ * Resamples a signal by the rational factor up / down with the filter of
+ * resampleFilter, compensating its delay so that the output is aligned with
+ * the input.
+ * @param x The input signal
+ * @param up The upsampling factor
+ * @param down The downsampling factor
+ * @return The output, ceil(len(x) up / down) samples
+ */
+ArrayXd resamplePoly(const Eigen::Ref<const ArrayXd>& x, const Index up,
+                     const Index down);
+
+/**
+ * Resamples a signal by the rational factor up / down.
+ * @param x The input signal
+ * @param up The upsampling factor
+ * @param down The downsampling factor
+ * @return The output, ceil(len(x) up / down) samples
+ */
+Signal resamplePoly(const Signal& x, const Index up, const Index down);
+
+/**
+ * Resamples several channels by the rational factor up / down, in parallel.
+ * @param x The input signals (one channel per row)
+ * @param up The upsampling factor
+ * @param down The downsampling factor
+ * @return The outputs (one channel per row)
+ */
+RowMajorMatrixXd
+resamplePolyMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                         const Index up, const Index down);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_RESAMPLE_H_
@@ -0,0 +1,122 @@
+#ifndef INCLUDE_INCLUDE_ROOTLIST_H_
+#define INCLUDE_INCLUDE_ROOTLIST_H_
+
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <algorithm>
+#include <span>
+
+/**
+ * @file RootList.h
+ * @brief IIR design steps on roots held in caller-owned buffers. The ZPK
+ * design functions of Filter.h and the batch designer both run on them, so
+ * the two produce the same designs.
+ */
+namespace Nodex::Filter {
+/**
+ * Roots in a fixed-capacity buffer owned by the caller (a vector, a row of a
+ * batch or a per-thread workspace). Each step states how many roots it may
+ * add; the caller provides the room.
+ */
+struct RootList {
+  Complex* data{nullptr};
+  Index    size{0};
+
+  void push(const Complex& r) { data[size++] = r; }
+
+  // Removes the root at i, keeping the order of the others
+  void erase(const Index i) {
+    std::copy(data + i + 1, data + size, data + i);
+    --size;
+  }
+
+  // Product of (offset + sign r) over the roots
+  Complex product(const Complex& offset, const double sign) const {
+    Complex result{1.0};
+    for (Index i{0}; i < size; ++i)
+      result *= offset + sign * data[i];
+    return result;
+  }
+
+  std::span<const Complex> roots() const {
+    return {data, static_cast<std::size_t>(size)};
+  }
+};
+
+/**
+ * Analogue prototypes of order n, written into empty lists with room for n
+ * zeros and n poles.
+ * @return The gain
+ */
+double buttap(const int n, RootList& z, RootList& p);
+double cheb1ap(const int n, const double rp, RootList& z, RootList& p);
+double cheb2ap(const int n, const double rs, RootList& z, RootList& p);
+double ellipap(const int n, const double rp, const double rs, RootList& z,
+               RootList& p);
+
+/**
+ * Analogue prototype of the given type, as iirFilter picks it.
+ * @param type The filter type
+ * @param n The filter order
+ * @param param The ripple (Chebyshev and elliptic types)
+ * @param attenuation The stopband attenuation (elliptic type)
+ * @param z The zeros (empty, room for n)
+ * @param p The poles (empty, room for n)
+ * @return The gain
+ */
+double analogPrototype(const Type type, const int n, const double param,
+                       const double attenuation, RootList& z, RootList& p);
+
+/**
+ * Frequency transformations of a lowpass prototype with gain k, in place.
+ * lp2hp needs room for as many zeros as poles; lp2bp and lp2bs for twice as
+ * many roots as the prototype has poles.
+ * @return The transformed gain
+ */
+double lp2lp(RootList& z, RootList& p, const double k, const double wc);
+double lp2hp(RootList& z, RootList& p, const double k, const double wc);
+double lp2bp(RootList& z, RootList& p, const double k, const double wc,
+             const double bw);
+double lp2bs(RootList& z, RootList& p, const double k, const double wc,
+             const double bw);
+
+/**
+ * Bilinear transform in place, with the zeros at infinity mapped to -1 (room
+ * for as many zeros as poles).
+ * @return The digital gain
+ */
+double bilinearTransform(RootList& z, RootList& p, const double k,
+                         const double fs);
+
+/**
+ * Transforms an analogue prototype to a digital lowpass or highpass filter in
+ * place, as analog2digital does on a ZPK.
+ * @return The digital gain
+ */
+double analog2digital(RootList& z, RootList& p, const double k, double fc,
+                      double fs, const Mode mode);
+
+/**
+ * Transforms an analogue prototype to a digital bandpass or bandstop filter
+ * in place, as analog2digital does on a ZPK.
+ * @return The digital gain
+ */
+double analog2digital(RootList& z, RootList& p, const double k, double fLow,
+                      double fHigh, double fs, const Mode mode);
+
+/**
+ * Pairs roots into second-order sections as zpk2sos does.
+ * @param zeros The zeros
+ * @param poles The poles
+ * @param k The gain, put into the first section
+ * @param zWork Workspace with room for max(zeros, poles) + 1 roots
+ * @param pWork Workspace with room for max(zeros, poles) + 1 roots
+ * @param sos The sections, six coefficients each, (max(zeros, poles) + 1) / 2
+ * of them (one if there are no roots)
+ * @return The number of sections
+ */
+Index zpk2sos(std::span<const Complex> zeros, std::span<const Complex> poles,
+              const double k, RootList& zWork, RootList& pWork, double* sos);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_ROOTLIST_H_
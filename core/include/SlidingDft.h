@@ -0,0 +1,130 @@
+#ifndef INCLUDE_INCLUDE_SLIDINGDFT_H_
+#define INCLUDE_INCLUDE_SLIDINGDFT_H_
+
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+
+/**
+ * @file SlidingDft.h
+ * @brief DFT bins at a few frequencies: Goertzel and sliding DFT tracking.
+ */
+namespace Nodex::Filter {
+using RowMajorMatrixXcd =
+    Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+ * DFT of a signal at arbitrary frequencies by the Goertzel recursion, with
+ * the phase referenced to the first sample: X(f) = sum x(n) e^(-j 2 pi f n /
+ * fs). Each frequency costs one multiply-add per sample.
+ * @param x The input signal
+ * @param frequencies The frequencies to evaluate, in the units of fs
+ * @param fs The sampling frequency
+ * @return One bin per frequency
+ */
+ArrayXcd goertzel(const Eigen::Ref<const ArrayXd>& x,
+                  const Eigen::Ref<const ArrayXd>& frequencies,
+                  const double                     fs);
+
+/**
+ * Goertzel DFT of every channel. The recursions of all channels and
+ * frequencies run side by side, so they vectorise.
+ * @param x The input signals, one row per channel
+ * @param frequencies The frequencies to evaluate, in the units of fs
+ * @param fs The sampling frequency
+ * @return One row per channel, one column per frequency
+ */
+RowMajorMatrixXcd
+goertzelMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Eigen::Ref<const ArrayXd>&          frequencies,
+                     const double                              fs);
+
+/**
+ * Tracks the amplitude and phase of a few frequencies over a sliding window,
+ * for streams processed in chunks of any length. Each bin is the DFT of the
+ * last windowLength samples, updated in O(1) per sample by adding the
+ * newest term and subtracting the one leaving the window:
+ *
+ *   Y(n) = Y(n - 1) + x(n) e^(-j w n) - x(n - N) e^(-j w (n - N))
+ *
+ * The terms keep the phase of absolute time, so the frequencies need not be
+ * multiples of fs / windowLength and a steady tone A cos(w n + phi) reads
+ * amplitude A and phase phi (for windows spanning whole periods; otherwise
+ * up to the leakage of its negative frequency). A bin at 0 reads the mean of
+ * the window. The window starts filled with zeros. The sum is recomputed from
+ * the window once per window length, so rounding does not accumulate.
+ *
+ * Only the raw samples of the window are kept (channels * windowLength
+ * values); the leaving term is rebuilt from the current rotator as
+ * x(n - N) e^(-j w n) e^(j w N). All channels and frequencies update together
+ * as vectors (lane channel * frequencies + bin).
+ */
+class SlidingDft {
+public:
+  SlidingDft() = default;
+
+  /**
+   * Creates a tracker with an empty window.
+   * @param frequencies The frequencies to track, in the units of fs
+   * @param fs The sampling frequency
+   * @param windowLength The samples in the window
+   * @param channels The number of channels
+   */
+  SlidingDft(const Eigen::Ref<const ArrayXd>& frequencies, const double fs,
+             const Index windowLength, const Index channels = 1);
+
+  /**
+   * Feeds the next chunk of the stream, writing the amplitude and phase of
+   * every bin after each sample.
+   * @param x The input chunk, one row per channel
+   * @param amplitude The amplitudes, one row per channel and frequency (row
+   * c * frequencies + k), x.cols() columns
+   * @param phase The phases in radians, laid out as the amplitudes
+   */
+  void process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+               Eigen::Ref<RowMajorMatrixXd>              amplitude,
+               Eigen::Ref<RowMajorMatrixXd>              phase);
+
+  /**
+   * The DFT of the current window of every lane, scaled so that the
+   * magnitude is the amplitude of a tone (the mean for a bin at 0).
+   */
+  ArrayXcd bins() const;
+
+  // Empties the window and restarts the time reference
+  void reset();
+
+  Index frequencies() const { return m_frequencies.size(); }
+  Index channels() const { return m_channels; }
+  Index windowLength() const { return m_samples.cols(); }
+
+private:
+  // Exact rotators for the current time, and the sum of the window's terms
+  void resync();
+
+  ArrayXd m_frequencies{};
+  double  m_fs{1.0};
+  Index   m_channels{0};
+
+  // Per lane: the rotator e^(-j w n), its step e^(-j w), e^(j w N) from the
+  // rotator to that of the leaving sample, the output scale and the running
+  // sum
+  ArrayXcd m_rotator{};
+  ArrayXcd m_step{};
+  ArrayXcd m_leave{};
+  ArrayXd  m_scale{};
+  ArrayXcd m_sum{};
+
+  // Samples in the window, one column per sample (a ring starting at m_pos)
+  RowMajorMatrixXd m_samples{};
+  Index            m_pos{0};
+
+  // Samples since the reset
+  long long m_time{0};
+
+  // Lane workspace: the newest and the leaving sample
+  ArrayXcd m_sample{};
+  ArrayXcd m_oldest{};
+};
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_SLIDINGDFT_H_
@@ -0,0 +1,136 @@
+#ifndef INCLUDE_INCLUDE_STFT_H_
+#define INCLUDE_INCLUDE_STFT_H_
+
+#include "FilterEigen.h"
+#include "Fir.h"
+#include <Eigen/Dense>
+
+/**
+ * @file Stft.h
+ * @brief Short-time Fourier transform of streams: spectrograms and Welch PSDs.
+ */
+namespace Nodex::Filter {
+/**
+ * Short-time Fourier transform of a multichannel stream processed in chunks
+ * of any length. Samples are buffered until a segment is complete; every
+ * complete segment (a frame) is windowed, transformed and turned into a
+ * one-sided power spectral density (units^2 / Hz, as scipy's spectrogram and
+ * welch with scaling='density' and no detrending). The frames are also
+ * accumulated into a Welch average, so a PSD of everything seen so far is
+ * available at any time.
+ *
+ * Frames do not depend on how the stream is split into chunks. The FFTs run
+ * on the calling thread's cached plans (see Utils::rfft), and the buffers
+ * are allocated at construction, so only the frames output grows with the
+ * chunk size.
+ */
+class Stft {
+public:
+  Stft() = default;
+
+  /**
+   * Creates a transform with an empty buffer.
+   * @param window The window type (periodic, as for spectral analysis)
+   * @param windowLength The samples per segment
+   * @param hop The samples between the starts of consecutive segments (at
+   * most windowLength)
+   * @param nfft The FFT size, at least windowLength (-1 uses windowLength)
+   * @param channels The number of channels
+   * @param fs The sampling frequency
+   */
+  Stft(const Window window, const Index windowLength, const Index hop,
+       const Index nfft = -1, const Index channels = 1, const double fs = 1.0);
+
+  /**
+   * Feeds the next chunk of the stream and computes the frames it completes.
+   * @param x The input chunk, one row per channel
+   * @return The number of new frames (see frames())
+   */
+  Index process(const Eigen::Ref<const RowMajorMatrixXd>& x);
+
+  /**
+   * The PSDs of the frames completed by the last call to process, one row
+   * per frame and channel (row f * channels() + c), bins() columns.
+   */
+  const RowMajorMatrixXd& frames() const { return m_frames; }
+
+  /**
+   * Welch PSD: the average of every frame since construction or the last
+   * reset, one row per channel (zero before the first frame).
+   */
+  RowMajorMatrixXd psd() const;
+
+  // Frames in the Welch average
+  Index averaged() const { return m_averaged; }
+
+  // Frequencies of the bins, in the units of fs
+  ArrayXd frequencies() const;
+
+  // Clears the buffered samples, the last frames and the Welch average
+  void reset();
+
+  Index windowLength() const { return m_window.size(); }
+  Index hop() const { return m_hop; }
+  Index nfft() const { return m_nfft; }
+  Index bins() const { return m_nfft / 2 + 1; }
+  Index channels() const { return m_pending.rows(); }
+  double fs() const { return m_fs; }
+
+private:
+  // Computes the frame of every channel from the start of the buffer
+  void computeFrame(const Index frame);
+
+  ArrayXd m_window{};
+  Index   m_hop{1};
+  Index   m_nfft{0};
+  double  m_fs{1.0};
+
+  // Density scaling of |X|^2, and the bins doubled for the one-sided PSD
+  double m_scale{1.0};
+  Index  m_lastDoubled{0};
+
+  // Samples of the incomplete segment (windowLength columns), of which the
+  // first m_count are filled
+  RowMajorMatrixXd m_pending{};
+  Index            m_count{0};
+
+  RowMajorMatrixXd m_frames{};
+  RowMajorMatrixXd m_sum{};
+  Index            m_averaged{0};
+
+  // FFT workspace
+  Eigen::VectorXd  m_segment{};
+  Eigen::VectorXcd m_spectrum{};
+};
+
+/**
+ * Spectrogram of a signal: the PSD of every segment.
+ * @param x The input signal
+ * @param window The window type
+ * @param windowLength The samples per segment
+ * @param hop The samples between the starts of consecutive segments
+ * @param nfft The FFT size (-1 uses windowLength)
+ * @param fs The sampling frequency
+ * @return One row per segment, nfft / 2 + 1 columns
+ */
+RowMajorMatrixXd spectrogram(const Eigen::Ref<const ArrayXd>& x,
+                             const Window window, const Index windowLength,
+                             const Index hop, const Index nfft = -1,
+                             const double fs = 1.0);
+
+/**
+ * Welch PSD of a signal: the average of the PSDs of its segments.
+ * @param x The input signal
+ * @param window The window type
+ * @param windowLength The samples per segment
+ * @param hop The samples between the starts of consecutive segments
+ * @param nfft The FFT size (-1 uses windowLength)
+ * @param fs The sampling frequency
+ * @return The PSD (nfft / 2 + 1 bins)
+ */
+ArrayXd welch(const Eigen::Ref<const ArrayXd>& x, const Window window,
+              const Index windowLength, const Index hop,
+              const Index nfft = -1, const double fs = 1.0);
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_STFT_H_
@@ -0,0 +1,106 @@
+#ifndef INCLUDE_INCLUDE_STREAMINGFILTER_H_
+#define INCLUDE_INCLUDE_STREAMINGFILTER_H_
+
+#include "Convolution.h"
+#include "FilterEigen.h"
+#include <Eigen/Dense>
+
+/**
+ * @file StreamingFilter.h
+ * @brief Stateful IIR filtering of a stream processed in chunks.
+ */
+namespace Nodex::Filter {
+/**
+ * IIR filter that owns its state, for streams processed in chunks of any
+ * length. The output is identical to filtering the whole stream at once (up
+ * to rounding for the FFT back-end). The state is allocated at construction,
+ * so processing into a caller-provided buffer never allocates.
+ *
+ * The filter runs as a transfer function (linearFilter), as a cascade of
+ * second-order sections (sosFilter) or as an overlap-save convolution with
+ * its truncated impulse response (FftConvolver).
+ */
+class StreamingFilter {
+public:
+  // How the filter is applied
+  enum Backend { tf, sos, fft };
+
+  StreamingFilter() = default;
+
+  /**
+   * Creates a transfer function filter with zero initial state. The
+   * coefficients are normalised by a(0).
+   * @param filter The filter coefficients (b and a)
+   */
+  explicit StreamingFilter(const EigenCoeffs& filter);
+
+  /**
+   * Creates a cascade of second-order sections with zero initial state.
+   * @param sos The second-order sections (one per row)
+   */
+  explicit StreamingFilter(const Eigen::Ref<const SosArray>& sos);
+
+  /**
+   * Creates an FFT convolution filter with zero initial state.
+   * @param convolver The convolver of the impulse response of the filter
+   */
+  explicit StreamingFilter(const FftConvolver& convolver);
+
+  /**
+   * Filters the next chunk of the stream.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  ArrayXd process(const Eigen::Ref<const ArrayXd>& x);
+
+  /**
+   * Filters the next chunk of the stream, writing into a caller-provided
+   * buffer without allocating.
+   * @param x The input chunk
+   * @param y The output chunk (same length as x, may alias x)
+   */
+  void process(const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y);
+
+  /**
+   * Filters the next chunk of the stream.
+   * @param x The input chunk
+   * @return The output chunk (same length as x)
+   */
+  Signal process(const Signal& x);
+
+  // Clears the state so the next chunk starts a new stream
+  void reset();
+
+  /**
+   * Copies the state, to resume the stream from this point with restore().
+   * @return The state (stateSize() values)
+   */
+  ArrayXd snapshot() const;
+
+  /**
+   * Replaces the state with one taken by snapshot().
+   * @param state The state (stateSize() values)
+   */
+  void restore(const Eigen::Ref<const ArrayXd>& state);
+
+  Backend backend() const { return m_backend; }
+
+  // Delays of the transfer function, two per section, or the input history of
+  // the convolution
+  Index stateSize() const;
+
+private:
+  Backend m_backend{tf};
+
+  // Transfer function, zero-padded so that b and a have the same length
+  EigenCoeffs m_filter{};
+  SosArray    m_sos{};
+
+  // State of the transfer function or of the sections
+  ArrayXd m_state{};
+
+  FftConvolver m_convolver{};
+};
+} // namespace Nodex::Filter
+
+#endif // INCLUDE_INCLUDE_STREAMINGFILTER_H_
@@ -82,9 +82,33 @@ void saveCsvData(const std::string& filePath, const CsvData& data,
                  int precision = 6);
 
 /**
- * Computes the Fast Fourier Transform (FFT) of a real-valued signal.
+ * Computes the FFT of a real-valued signal, returning only the non-negative
+ * frequency bins (the rest of the spectrum is their complex conjugate).
+ * Transforms run on an FFT engine owned by the calling thread, which keeps the
+ * plans (twiddle factors) of every size and direction it has computed, so
+ * repeated transforms of the same size skip the setup.
  * @param signal Input real-valued signal
- * @return Complex-valued FFT of the input signal
+ * @param spectrum Output half spectrum (nfft / 2 + 1 bins)
+ * @param nfft FFT size; the signal is zero-padded or truncated to it (-1 uses
+ * the signal length)
+ */
+void rfft(const Eigen::Ref<const Eigen::VectorXd>& signal,
+          Eigen::VectorXcd& spectrum, Eigen::Index nfft = -1);
+
+/**
+ * Computes the inverse FFT of a half spectrum of a real-valued signal, as
+ * returned by rfft. Uses the calling thread's cached plans.
+ * @param spectrum Input half spectrum (nfft / 2 + 1 bins)
+ * @param signal Output real-valued signal (nfft samples)
+ * @param nfft FFT size
+ */
+void irfft(const Eigen::Ref<const Eigen::VectorXcd>& spectrum,
+           Eigen::VectorXd& signal, const Eigen::Index nfft);
+
+/**
+ * Computes the magnitude spectrum of a real-valued signal.
+ * @param signal Input real-valued signal
+ * @return Magnitude of the non-negative frequency bins (length / 2 + 1)
  */
 Eigen::ArrayXd computeFFT(const Eigen::Ref<const Eigen::VectorXd>& signal);
 
@@ -104,6 +128,16 @@ Eigen::ArrayXd generateTimeVector(const Eigen::Index length, const double fs);
  */
 Eigen::ArrayXd generateFrequencyVector(const Eigen::Index length,
                                        const double       fs);
+
+/**
+ * Generates the frequency vector of the half spectrum returned by rfft and
+ * computeFFT for a signal of the given length.
+ * @param length Length of the signal in samples
+ * @param fs Sampling frequency in Hz
+ * @return Frequency vector (length / 2 + 1 bins) as an Eigen array
+ */
+Eigen::ArrayXd generateRfftFrequencyVector(const Eigen::Index length,
+                                           const double       fs);
 } // namespace Nodex::Utils
 
 #endif // INCLUDE_INCLUDE_UTILS_H_
@@ -0,0 +1,174 @@
+#include "Averaging.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+static void checkShape(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                       const Eigen::Ref<RowMajorMatrixXd>& y,
+                       const Index                         channels) {
+  if (x.rows() != channels)
+    throw std::runtime_error("Input must have one row per channel");
+  if (y.rows() != x.rows() || y.cols() != x.cols())
+    throw std::runtime_error("Output must have the shape of the input");
+}
+
+// MovingAverage
+MovingAverage::MovingAverage(const Index windowLength, const Index channels) {
+  if (windowLength < 1 || channels < 1)
+    throw std::runtime_error("Window length and channels must be positive");
+
+  m_window.resize(channels, windowLength);
+  m_sum.resize(channels);
+  m_sample.resize(channels);
+  reset();
+}
+
+void MovingAverage::process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                            Eigen::Ref<RowMajorMatrixXd>              y) {
+  checkShape(x, y, channels());
+
+  const double scale{1.0 / static_cast<double>(windowLength())};
+  for (Index j{0}; j < x.cols(); ++j) {
+    // Newest sample in, the one it replaces in the ring out
+    m_sample = x.col(j);
+    m_sum += m_sample - m_window.col(m_pos).array();
+    m_window.col(m_pos) = m_sample;
+
+    if (++m_pos == windowLength()) {
+      m_pos = 0;
+      m_sum = m_window.rowwise().sum().array();
+    }
+
+    y.col(j) = m_sum * scale;
+  }
+}
+
+void MovingAverage::reset() {
+  m_window.setZero();
+  m_pos = 0;
+  m_sum.setZero();
+}
+
+// ExponentialAverage
+ExponentialAverage::ExponentialAverage(const double alpha,
+                                       const Index  channels)
+    : m_alpha{alpha}, m_state{ArrayXd::Zero(channels)} {
+  if (!(alpha > 0 && alpha <= 1) || channels < 1)
+    throw std::runtime_error("Alpha must be in (0, 1] and channels positive");
+}
+
+void ExponentialAverage::process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                                 Eigen::Ref<RowMajorMatrixXd> y) {
+  checkShape(x, y, channels());
+
+  for (Index j{0}; j < x.cols(); ++j) {
+    m_state += m_alpha * (x.col(j).array() - m_state);
+    y.col(j) = m_state;
+  }
+}
+
+double ExponentialAverage::alphaFromTimeConstant(const double tau,
+                                                 const double fs) {
+  if (tau <= 0 || fs <= 0)
+    throw std::runtime_error("Time constant and sampling frequency must be "
+                             "positive");
+
+  return 1.0 - std::exp(-1.0 / (tau * fs));
+}
+
+// CicDecimator
+CicDecimator::CicDecimator(const Index decimation, const Index stages,
+                           const Index delay, const Index channels)
+    : m_decimation{decimation}, m_channels{channels} {
+  if (decimation < 1 || stages < 1 || delay < 1)
+    throw std::runtime_error("Decimation, stages and delay must be positive");
+
+  m_stages.assign(static_cast<std::size_t>(stages),
+                  MovingAverage{decimation * delay, channels});
+}
+
+RowMajorMatrixXd
+CicDecimator::process(const Eigen::Ref<const RowMajorMatrixXd>& x) {
+  if (x.rows() != m_channels)
+    throw std::runtime_error("Input must have one row per channel");
+
+  // Every stage runs over the chunk in place
+  const Index n{x.cols()};
+  m_work = x;
+  for (auto& stage : m_stages)
+    stage.process(m_work, m_work);
+
+  const Index count{n > m_skip ? (n - 1 - m_skip) / m_decimation + 1 : 0};
+  RowMajorMatrixXd y(m_channels, count);
+  for (Index i{0}; i < count; ++i)
+    y.col(i) = m_work.col(m_skip + i * m_decimation);
+
+  m_skip = count > 0 ? m_skip + count * m_decimation - n : m_skip - n;
+
+  return y;
+}
+
+void CicDecimator::reset() {
+  for (auto& stage : m_stages)
+    stage.reset();
+  m_skip = 0;
+}
+
+// RunningStats
+RunningStats::RunningStats(const Index windowLength, const Index channels) {
+  if (windowLength < 1 || channels < 1)
+    throw std::runtime_error("Window length and channels must be positive");
+
+  m_window.resize(channels, windowLength);
+  m_mean.resize(channels);
+  m_m2.resize(channels);
+  m_sample.resize(channels);
+  m_oldMean.resize(channels);
+  m_variance.resize(channels);
+  reset();
+}
+
+void RunningStats::resync() {
+  m_mean = m_window.rowwise().mean().array();
+  m_m2   = (m_window.array().colwise() - m_mean).square().rowwise().sum();
+}
+
+void RunningStats::process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                           Eigen::Ref<RowMajorMatrixXd>              mean,
+                           Eigen::Ref<RowMajorMatrixXd>              variance,
+                           Eigen::Ref<RowMajorMatrixXd>              rms) {
+  checkShape(x, mean, channels());
+  checkShape(x, variance, channels());
+  checkShape(x, rms, channels());
+
+  const double n{static_cast<double>(windowLength())};
+  for (Index j{0}; j < x.cols(); ++j) {
+    m_sample = x.col(j);
+    auto oldest{m_window.col(m_pos).array()};
+
+    // Replace the oldest sample: the mean moves by the difference, and the
+    // squared deviations by (new - old)(new - mean' + old - mean)
+    m_oldMean = m_mean;
+    m_mean += (m_sample - oldest) / n;
+    m_m2 += (m_sample - oldest) * (m_sample - m_mean + oldest - m_oldMean);
+    oldest = m_sample;
+
+    if (++m_pos == windowLength()) {
+      m_pos = 0;
+      resync();
+    }
+
+    m_variance      = m_m2.max(0.0) / n;
+    mean.col(j)     = m_mean;
+    variance.col(j) = m_variance;
+    rms.col(j)      = (m_mean.square() + m_variance).sqrt();
+  }
+}
+
+void RunningStats::reset() {
+  m_window.setZero();
+  m_pos = 0;
+  m_mean.setZero();
+  m_m2.setZero();
+}
+} // namespace Nodex::Filter
@@ -0,0 +1,108 @@
+#include "BatchDesign.h"
+#include "RootList.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace Nodex::Filter {
+// Roots of the digital design: bandpass and bandstop double the order
+static Index digitalOrder(const DesignKey& key) {
+  return key.mode == bandpass || key.mode == bandstop ? 2 * key.order
+                                                      : key.order;
+}
+
+// Rejects parameters that have no valid design, before the parallel region
+static void checkKey(const DesignKey& key) {
+  if (key.order < 1)
+    throw std::runtime_error("Filter order must be at least 1");
+  if (key.type < butter || key.type >= maxType || key.mode < lowpass ||
+      key.mode >= maxMode)
+    throw std::runtime_error("Unknown filter type or mode");
+  if (key.type != butter && !(key.ripple > 0))
+    throw std::runtime_error("Ripple must be positive");
+  if (key.type == ellip && !(key.attenuation > 0))
+    throw std::runtime_error("Stopband attenuation must be positive");
+
+  const double nyquist{key.fs / 2};
+  if (!(key.fc > 0 && key.fc < nyquist))
+    throw std::runtime_error("Cutoff frequency must be between 0 and the "
+                             "Nyquist frequency");
+  if ((key.mode == bandpass || key.mode == bandstop) &&
+      !(key.fc2 > key.fc && key.fc2 < nyquist))
+    throw std::runtime_error("Upper cutoff frequency must be between the "
+                             "lower one and the Nyquist frequency");
+}
+
+DesignBatch iirFilterBatch(const std::vector<DesignKey>& keys) {
+  const Index nDesigns{static_cast<Index>(keys.size())};
+
+  Index maxRoots{0};
+  for (const auto& key : keys) {
+    checkKey(key);
+    maxRoots = std::max(maxRoots, digitalOrder(key));
+  }
+  const Index maxSections{(maxRoots + 1) / 2};
+
+  // The result is the arena: every design writes into its own rows
+  DesignBatch batch{};
+  batch.zeros    = DesignBatch::ComplexRows::Zero(nDesigns, maxRoots);
+  batch.poles    = DesignBatch::ComplexRows::Zero(nDesigns, maxRoots);
+  batch.counts   = DesignBatch::Counts::Zero(nDesigns);
+  batch.gains    = ArrayXd::Zero(nDesigns);
+  batch.sos      = RowMajorMatrixXd::Zero(nDesigns, 6 * maxSections);
+  batch.sections = DesignBatch::Counts::Zero(nDesigns);
+
+  for (Index s{0}; s < maxSections; ++s) {
+    batch.sos.col(6 * s).setOnes();
+    batch.sos.col(6 * s + 3).setOnes();
+  }
+
+  // An exception must not leave the parallel region (it would terminate the
+  // process), so each design keeps its own and the first is rethrown after
+  std::vector<std::exception_ptr> errors(keys.size());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    // Conjugate halves of the roots, padded by one to an even count
+    ArrayXcd zHalf(maxRoots + 1);
+    ArrayXcd pHalf(maxRoots + 1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (Index i = 0; i < nDesigns; ++i) {
+      const DesignKey& key{keys[static_cast<std::size_t>(i)]};
+
+      try {
+        RootList z{&batch.zeros(i, 0), 0};
+        RootList p{&batch.poles(i, 0), 0};
+
+        double k{analogPrototype(key.type, key.order, key.ripple,
+                                 key.attenuation, z, p)};
+        k = key.mode == bandpass || key.mode == bandstop
+                ? analog2digital(z, p, k, key.fc, key.fc2, key.fs, key.mode)
+                : analog2digital(z, p, k, key.fc, key.fs, key.mode);
+        batch.counts(i) = p.size;
+        batch.gains(i)  = k;
+
+        RootList zWork{zHalf.data(), 0};
+        RootList pWork{pHalf.data(), 0};
+        batch.sections(i) =
+            zpk2sos(z.roots(), p.roots(), k, zWork, pWork, &batch.sos(i, 0));
+      } catch (...) {
+        errors[static_cast<std::size_t>(i)] = std::current_exception();
+      }
+    }
+  }
+
+  for (const auto& error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  return batch;
+}
+} // namespace Nodex::Filter
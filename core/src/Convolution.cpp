@@ -0,0 +1,280 @@
+#include "Convolution.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+template <typename T>
+using EigenMap = Eigen::Map<T>;
+
+// FFT size bounds for the automatic overlap-save block size. Frames of up to
+// 2^15 samples keep the real frame and its half spectrum within L2 cache.
+constexpr Index kMinOverlapSaveFftSize{256};
+constexpr Index kMaxOverlapSaveFftSize{1 << 15};
+
+Index overlapSaveFftSize(const Index irLength) {
+  const Index target{std::clamp(4 * irLength, kMinOverlapSaveFftSize,
+                                kMaxOverlapSaveFftSize)};
+
+  Index n{1};
+  while (n < target || n < 2 * irLength - 1)
+    n <<= 1;
+
+  return n;
+}
+
+// FftConvolver implementation
+FftConvolver::FftConvolver(const Eigen::Ref<const ArrayXd>& ir,
+                           const Index                      fftSize)
+    : m_irLength{std::max<Index>(ir.size(), 1)},
+      m_fftSize{fftSize > 0 ? fftSize : overlapSaveFftSize(m_irLength)} {
+  if (m_fftSize < m_irLength)
+    throw std::runtime_error("FFT size must not be shorter than the impulse "
+                             "response");
+
+  Utils::rfft(ir.matrix(), m_irSpectrum, m_fftSize);
+
+  m_frame = VectorXd::Zero(m_fftSize);
+}
+
+FftConvolver::FftConvolver(const EigenCoeffs& filter, const double epsilon,
+                           const Index maxLength, const Index fftSize)
+    : FftConvolver{findEffectiveIR(filter, epsilon, maxLength), fftSize} {}
+
+void FftConvolver::reset() { m_frame.setZero(); }
+
+ArrayXd FftConvolver::history() const {
+  return m_frame.head(std::max<Index>(m_irLength - 1, 0)).array();
+}
+
+void FftConvolver::setHistory(const Eigen::Ref<const ArrayXd>& history) {
+  const Index length{std::max<Index>(m_irLength - 1, 0)};
+  if (history.size() != length)
+    throw std::runtime_error("History must hold the last irLength - 1 input "
+                             "samples");
+
+  m_frame.head(length) = history.matrix();
+}
+
+void FftConvolver::processBlock(const double* x, double* y,
+                                const Index length) {
+  const Index history{m_irLength - 1};
+
+  m_frame.segment(history, length) = EigenMap<const VectorXd>(x, length);
+  m_frame.tail(m_fftSize - history - length).setZero();
+
+  Utils::rfft(m_frame, m_spectrum);
+  m_spectrum.array() *= m_irSpectrum.array();
+  Utils::irfft(m_spectrum, m_output, m_fftSize);
+
+  // The first `history` samples of the circular convolution wrap around
+  EigenMap<VectorXd>(y, length) = m_output.segment(history, length);
+
+  // Keep the most recent `history` input samples for the next block
+  std::copy(m_frame.data() + length, m_frame.data() + length + history,
+            m_frame.data());
+}
+
+void FftConvolver::process(const Eigen::Ref<const ArrayXd>& x,
+                           Eigen::Ref<ArrayXd>              y) {
+  if (y.size() != x.size())
+    throw std::runtime_error("Output must have the same length as the input");
+
+  if (m_fftSize == 0) {
+    y.setZero();
+    return;
+  }
+
+  // Each block is copied into the frame before its output is written
+  const Index hop{blockLength()};
+  for (Index start{0}; start < x.size(); start += hop) {
+    const Index len{std::min(hop, x.size() - start)};
+    processBlock(x.data() + start, y.data() + start, len);
+  }
+}
+
+ArrayXd FftConvolver::process(const Eigen::Ref<const ArrayXd>& x) {
+  ArrayXd y(x.size());
+  process(x, y);
+
+  return y;
+}
+
+Signal FftConvolver::process(const Signal& x) {
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  Signal            y(x.size());
+  EigenMap<ArrayXd> yMap(y.data(), static_cast<Index>(y.size()));
+  process(xMap, yMap);
+
+  return y;
+}
+
+// PartitionedConvolver implementation
+void PartitionedConvolver::Stage::init(const Eigen::Ref<const ArrayXd>& taps,
+                                       const Index                      size) {
+  blockSize  = size;
+  partitions = std::max<Index>((taps.size() + size - 1) / size, 1);
+
+  spectra.resize(size + 1, partitions);
+  for (Index p{0}; p < partitions; ++p) {
+    const Index len{std::min(size, taps.size() - p * size)};
+
+    Utils::rfft(taps.segment(p * size, len).matrix(), spectrum, 2 * size);
+    spectra.col(p) = spectrum;
+  }
+
+  reset();
+}
+
+void PartitionedConvolver::Stage::reset() {
+  delayLine = Eigen::MatrixXcd::Zero(blockSize + 1, partitions);
+  newest    = 0;
+  frame     = VectorXd::Zero(2 * blockSize);
+  fill      = 0;
+  past      = VectorXcd::Zero(blockSize + 1);
+  ahead     = VectorXd::Zero(blockSize);
+
+  // Sized here so that processing never allocates
+  spectrum.setZero(blockSize + 1);
+  accumulator.setZero(blockSize + 1);
+  output.setZero(2 * blockSize);
+}
+
+// Moves the spectrum of the completed frame into the delay line and slides
+// the frame by one block
+void PartitionedConvolver::Stage::pushFrame() {
+  newest                = (newest + 1) % partitions;
+  delayLine.col(newest) = spectrum;
+  frame.head(blockSize) = frame.tail(blockSize);
+  frame.tail(blockSize).setZero();
+  fill = 0;
+}
+
+// Sums the products of the partitions from `first` on with the delay line,
+// pairing partition `first` with the newest frame
+void PartitionedConvolver::Stage::accumulate(const Index first) {
+  accumulator.setZero(blockSize + 1);
+
+  for (Index p{first}; p < partitions; ++p) {
+    const Index age{p - first};
+    const Index col{(newest - age + partitions) % partitions};
+
+    accumulator.array() += delayLine.col(col).array() * spectra.col(p).array();
+  }
+}
+
+void PartitionedConvolver::Stage::processHead(const double* x, double* y,
+                                              const Index length) {
+  frame.segment(blockSize + fill, length) = EigenMap<const VectorXd>(x, length);
+
+  // The rest of the current block is still zero, and does not affect the
+  // outputs of the samples received so far
+  Utils::rfft(frame, spectrum);
+  accumulator = spectrum.cwiseProduct(spectra.col(0)) + past;
+  Utils::irfft(accumulator, output, 2 * blockSize);
+
+  EigenMap<VectorXd>(y, length) = output.segment(blockSize + fill, length);
+
+  fill += length;
+  if (fill == blockSize) {
+    pushFrame();
+    accumulate(1);
+    past = accumulator;
+  }
+}
+
+void PartitionedConvolver::Stage::processTail(const double* x, double* y,
+                                              const Index length) {
+  EigenMap<VectorXd>(y, length) += ahead.segment(fill, length);
+
+  frame.segment(blockSize + fill, length) = EigenMap<const VectorXd>(x, length);
+
+  fill += length;
+  if (fill == blockSize) {
+    Utils::rfft(frame, spectrum);
+    pushFrame();
+    accumulate(0);
+    Utils::irfft(accumulator, output, 2 * blockSize);
+    ahead = output.tail(blockSize);
+  }
+}
+
+PartitionedConvolver::PartitionedConvolver(const Eigen::Ref<const ArrayXd>& ir,
+                                           const Index blockSize,
+                                           const Index tailBlockSize)
+    : m_irLength{std::max<Index>(ir.size(), 1)} {
+  if (blockSize <= 0)
+    throw std::runtime_error("Partition size must be positive");
+
+  if (tailBlockSize > 0 && ir.size() > tailBlockSize) {
+    m_head.init(ir.head(tailBlockSize), blockSize);
+    m_tail.init(ir.tail(ir.size() - tailBlockSize), tailBlockSize);
+  } else {
+    m_head.init(ir, blockSize);
+  }
+
+  m_input = VectorXd::Zero(blockSize);
+}
+
+PartitionedConvolver::PartitionedConvolver(const EigenCoeffs& filter,
+                                           const double       epsilon,
+                                           const Index        maxLength,
+                                           const Index        blockSize,
+                                           const Index        tailBlockSize)
+    : PartitionedConvolver{findEffectiveIR(filter, epsilon, maxLength),
+                           blockSize, tailBlockSize} {}
+
+void PartitionedConvolver::reset() {
+  m_head.reset();
+  if (m_tail.blockSize > 0)
+    m_tail.reset();
+}
+
+void PartitionedConvolver::process(const Eigen::Ref<const ArrayXd>& x,
+                                   Eigen::Ref<ArrayXd>              y) {
+  if (y.size() != x.size())
+    throw std::runtime_error("Output must have the same length as the input");
+
+  if (m_head.blockSize == 0) {
+    y.setZero();
+    return;
+  }
+
+  // Advance both stages in steps that never cross a block boundary of either
+  for (Index start{0}; start < x.size();) {
+    Index len{std::min(x.size() - start, m_head.blockSize - m_head.fill)};
+    if (m_tail.blockSize > 0)
+      len = std::min(len, m_tail.blockSize - m_tail.fill);
+
+    // The tail reads its input after the head has written the output
+    const double* input{x.data() + start};
+    if (m_tail.blockSize > 0) {
+      m_input.head(len) = x.segment(start, len).matrix();
+      input             = m_input.data();
+    }
+
+    m_head.processHead(input, y.data() + start, len);
+    if (m_tail.blockSize > 0)
+      m_tail.processTail(input, y.data() + start, len);
+
+    start += len;
+  }
+}
+
+ArrayXd PartitionedConvolver::process(const Eigen::Ref<const ArrayXd>& x) {
+  ArrayXd y(x.size());
+  process(x, y);
+
+  return y;
+}
+
+Signal PartitionedConvolver::process(const Signal& x) {
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  Signal            y(x.size());
+  EigenMap<ArrayXd> yMap(y.data(), static_cast<Index>(y.size()));
+  process(xMap, yMap);
+
+  return y;
+}
+} // namespace Nodex::Filter
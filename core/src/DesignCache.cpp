@@ -0,0 +1,126 @@
+#include "DesignCache.h"
+#include <algorithm>
+#include <functional>
+
+namespace Nodex::Filter {
+// Clears the parameters the design does not depend on, so that they do not
+// split otherwise identical keys
+static DesignKey canonicalKey(DesignKey key) {
+  if (key.mode != bandpass && key.mode != bandstop)
+    key.fc2 = 0.0;
+  if (key.type == butter)
+    key.ripple = 0.0;
+  if (key.type != ellip)
+    key.attenuation = 0.0;
+
+  // Adding zero maps -0.0 to 0.0, which compares equal but hashes differently
+  key.fc += 0.0;
+  key.fc2 += 0.0;
+  key.fs += 0.0;
+  key.ripple += 0.0;
+  key.attenuation += 0.0;
+
+  return key;
+}
+
+Design designFilter(const DesignKey& key) {
+  Design design{};
+
+  if (key.mode == bandpass || key.mode == bandstop) {
+    design.zpk = iirFilter(key.order, key.fc, key.fc2, key.fs, key.type,
+                           key.mode, key.ripple, key.attenuation);
+  } else {
+    design.zpk = iirFilter(key.order, key.fc, key.fs, key.type, key.mode,
+                           key.ripple, key.attenuation);
+  }
+
+  const EigenZPK zpk{design.zpk};
+  design.tf  = zpk2tf(zpk);
+  design.sos = zpk2sos(zpk);
+
+  return design;
+}
+
+std::size_t DesignCache::KeyHash::operator()(const DesignKey& key) const {
+  std::size_t seed{0};
+  const auto  combine{[&seed](const std::size_t h) {
+    seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  }};
+
+  combine(std::hash<int>{}(key.type));
+  combine(std::hash<int>{}(key.mode));
+  combine(std::hash<int>{}(key.order));
+  combine(std::hash<double>{}(key.fc));
+  combine(std::hash<double>{}(key.fc2));
+  combine(std::hash<double>{}(key.fs));
+  combine(std::hash<double>{}(key.ripple));
+  combine(std::hash<double>{}(key.attenuation));
+
+  return seed;
+}
+
+DesignCache::DesignCache(const std::size_t capacity)
+    : m_capacity{std::max<std::size_t>(capacity, 1)} {}
+
+std::shared_ptr<const Design> DesignCache::get(const DesignKey& key) {
+  const DesignKey canonical{canonicalKey(key)};
+
+  {
+    std::lock_guard lock{m_mutex};
+    if (const auto it{m_index.find(canonical)}; it != m_index.end()) {
+      ++m_hits;
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return it->second->second;
+    }
+    ++m_misses;
+  }
+
+  // Design outside the lock so that other keys are not held up. If another
+  // thread designs the same key meanwhile, the first one stored wins.
+  auto design{std::make_shared<const Design>(designFilter(canonical))};
+
+  std::lock_guard lock{m_mutex};
+  if (const auto it{m_index.find(canonical)}; it != m_index.end()) {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->second;
+  }
+
+  m_entries.emplace_front(canonical, design);
+  m_index.emplace(canonical, m_entries.begin());
+
+  if (m_entries.size() > m_capacity) {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  return design;
+}
+
+void DesignCache::clear() {
+  std::lock_guard lock{m_mutex};
+  m_index.clear();
+  m_entries.clear();
+  m_hits   = 0;
+  m_misses = 0;
+}
+
+std::size_t DesignCache::hits() const {
+  std::lock_guard lock{m_mutex};
+  return m_hits;
+}
+
+std::size_t DesignCache::misses() const {
+  std::lock_guard lock{m_mutex};
+  return m_misses;
+}
+
+std::size_t DesignCache::size() const {
+  std::lock_guard lock{m_mutex};
+  return m_entries.size();
+}
+
+DesignCache& DesignCache::global() {
+  static DesignCache cache{};
+  return cache;
+}
+} // namespace Nodex::Filter
@@ -1,12 +1,21 @@
 #include "Filter.h"
+#include "Convolution.h"
 #include "FilterEigen.h"
+#include "FixedFilter.h"
+#include "RootList.h"
 #include "Utils.h"
 #include <Eigen/Dense>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <numbers>
 #include <ostream>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <unsupported/Eigen/FFT>
 #include <vector>
 
@@ -18,11 +27,9 @@ namespace Nodex {
 namespace Filter {
 using Eigen::ArrayXcd;
 using Eigen::ArrayXd;
-using Eigen::ArrayXi;
 using Eigen::Index;
 using Eigen::VectorXcd;
 using Eigen::VectorXd;
-using Utils::arange;
 
 template <typename T>
 using EigenMap = Eigen::Map<T>;
@@ -64,21 +71,53 @@ std::ostream& operator<<(std::ostream& os, const ZPK& zpk) {
   return os;
 }
 
-ZPK analog2digital(ZPK analog, double fc, double fs, Mode mode = lowpass) {
+// Runs an in-place design step on copies of the roots of input, in vectors
+// with room for `capacity` roots each
+template <typename Step>
+static ZPK transformed(const ZPK& input, std::size_t capacity, Step&& step) {
+  capacity = std::max({capacity, input.z.size(), input.p.size()});
+
+  std::vector<Complex> z(capacity);
+  std::vector<Complex> p(capacity);
+  std::ranges::copy(input.z, z.begin());
+  std::ranges::copy(input.p, p.begin());
+
+  RootList     zList{z.data(), static_cast<Index>(input.z.size())};
+  RootList     pList{p.data(), static_cast<Index>(input.p.size())};
+  const double k{step(zList, pList, input.k)};
+
+  z.resize(static_cast<std::size_t>(zList.size));
+  p.resize(static_cast<std::size_t>(pList.size));
+
+  return {std::move(z), std::move(p), k};
+}
+
+// Designs an analogue prototype of order n into vectors
+template <typename Prototype>
+static ZPK prototype(const int n, Prototype&& design) {
+  return transformed(ZPK{}, static_cast<std::size_t>(std::max(n, 0)),
+                     [&](RootList& z, RootList& p, double) {
+                       return design(z, p);
+                     });
+}
+
+double analog2digital(RootList& z, RootList& p, double k, double fc,
+                      double fs, const Mode mode) {
   fc /= (fs / 2);
   fs = 2.0;
   const double warped{2.0 * fs * std::tan(std::numbers::pi * fc / fs)};
 
   if (mode == Mode::lowpass)
-    analog = lp2lp(analog, warped);
+    k = lp2lp(z, p, k, warped);
   else if (mode == Mode::highpass) {
-    analog = lp2hp(analog, warped);
+    k = lp2hp(z, p, k, warped);
   }
 
-  return bilinearTransform(analog, fs);
+  return bilinearTransform(z, p, k, fs);
 }
 
-ZPK analog2digital(ZPK analog, double fl, double fh, double fs, Mode mode) {
+double analog2digital(RootList& z, RootList& p, double k, double fl,
+                      double fh, double fs, const Mode mode) {
   double fc{std::sqrt(fl * fh)};
   double bw{fh - fl};
 
@@ -89,170 +128,343 @@ ZPK analog2digital(ZPK analog, double fl, double fh, double fs, Mode mode) {
   const double bwWarped{2.0 * fs * std::tan(std::numbers::pi * bw / fs)};
 
   if (mode == Mode::bandpass) {
-    analog = lp2bp(analog, fcWarped, bwWarped);
+    k = lp2bp(z, p, k, fcWarped, bwWarped);
   } else if (mode == Mode::bandstop) {
-    analog = lp2bs(analog, fcWarped, bwWarped);
+    k = lp2bs(z, p, k, fcWarped, bwWarped);
   }
 
-  return bilinearTransform(analog, fs);
+  return bilinearTransform(z, p, k, fs);
 }
 
-ZPK cheb1ap(const int n, const double rp) {
+ZPK analog2digital(ZPK analog, double fc, double fs, Mode mode = lowpass) {
+  return transformed(analog, 0, [&](RootList& z, RootList& p, double k) {
+    return analog2digital(z, p, k, fc, fs, mode);
+  });
+}
+
+ZPK analog2digital(ZPK analog, double fl, double fh, double fs, Mode mode) {
+  // Bandpass and bandstop designs double the roots
+  const std::size_t capacity{2 * std::max(analog.z.size(), analog.p.size())};
+
+  return transformed(analog, capacity,
+                     [&](RootList& z, RootList& p, double k) {
+                       return analog2digital(z, p, k, fl, fh, fs, mode);
+                     });
+}
+
+double cheb1ap(const int n, const double rp, RootList&, RootList& p) {
   using namespace std::complex_literals;
 
   if (n == 0)
-    return {{}, {}, std::pow(10, -rp / 20.0)};
-
-  // Map the p vector memory
-  std::vector<Complex> pVec(static_cast<std::size_t>(n));
-  EigenMap<ArrayXcd>   p(pVec.data(), n);
+    return std::pow(10, -rp / 20.0);
 
   const double eps{std::sqrt(std::pow(10, 0.1 * rp) - 1)};
   const double mu{1.0 / n * std::asinh(1 / eps)};
 
-  const ArrayXd m{arange(-n + 1, n, 2).cast<double>()};
-  const ArrayXd theta{std::numbers::pi * m / (2 * n)};
-  p = -(mu + 1i * theta.cast<Complex>()).sinh();
+  for (int m{-n + 1}; m < n; m += 2)
+    p.push(-std::sinh(mu + 1i * (std::numbers::pi * m / (2 * n))));
 
-  double k{std::real((-p).prod())};
+  double k{std::real(p.product(0.0, -1.0))};
   if (n % 2 == 0)
     k /= std::sqrt(1 + eps * eps);
 
-  return {{}, pVec, k};
+  return k;
 }
 
-ZPK cheb2ap(const int n, const double rs) {
+ZPK cheb1ap(const int n, const double rp) {
+  return prototype(
+      n, [&](RootList& z, RootList& p) { return cheb1ap(n, rp, z, p); });
+}
+
+double cheb2ap(const int n, const double rs, RootList& z, RootList& p) {
   using namespace std::complex_literals;
+
   if (n == 0)
-    return {{}, {}, 1};
+    return 1.0;
 
   const double de{1.0 / std::sqrt(std::pow(10, 0.1 * rs) - 1)};
   const double mu{std::asinh(1.0 / de) / n};
 
-  ArrayXi m{};
-  if (n % 2) {
-    ArrayXi m1{arange(-n + 1, 0, 2)};
-    ArrayXi m2{arange(2, n, 2)};
-    m.conservativeResize(m1.size() + m2.size());
-    m << m1, m2;
-  } else {
-    m = arange(-n + 1, n, 2);
+  // Zeros for every m but 0, poles for every m
+  for (int m{-n + 1}; m < n; m += 2) {
+    if (m != 0)
+      z.push(-std::conj(1i / std::sin(std::numbers::pi * m / (2.0 * n))));
+
+    const Complex e{-std::exp(1i * (std::numbers::pi * m / (2 * n)))};
+    p.push(1.0 / (std::sinh(mu) * e.real() + 1i * std::cosh(mu) * e.imag()));
   }
 
-  const ArrayXcd z{
-      -(1i / (std::numbers::pi * m.cast<double>() / (2.0 * n)).sin())
-           .conjugate()};
+  return (p.product(0.0, -1.0) / z.product(0.0, -1.0)).real();
+}
 
-  ArrayXcd p{
-      -(1i * std::numbers::pi * arange(-n + 1, n, 2).cast<Complex>() / (2 * n))
-           .exp(),
-  };
-  p = std::sinh(mu) * p.real() + 1i * std::cosh(mu) * p.imag();
-  p = p.cwiseInverse();
+ZPK cheb2ap(const int n, const double rs) {
+  return prototype(
+      n, [&](RootList& z, RootList& p) { return cheb2ap(n, rs, z, p); });
+}
 
-  const double k{((-p).prod() / (-z).prod()).real()};
+double buttap(const int n, RootList&, RootList& p) {
+  using namespace std::complex_literals;
 
-  const std::vector<Complex> zVec(z.data(), z.data() + z.size());
-  const std::vector<Complex> pVec(p.data(), p.data() + p.size());
+  // No zeros
+  // p_k = wc * exp(j * (2k + n - 1) * pi / 2n)
+  // m = 2k + n - 1
+  // theta = pi * m / (2n)
+  // p_k = -exp(j * theta)
+  for (int m{-n + 1}; m < n; m += 2)
+    p.push(-std::exp(1i * (std::numbers::pi * m / (2 * n))));
 
-  return ZPK{zVec, pVec, k};
+  return 1.0;
 }
 
 ZPK buttap(const int n) {
+  return prototype(n,
+                   [&](RootList& z, RootList& p) { return buttap(n, z, p); });
+}
+
+// Arithmetic-geometric mean of a and b (zero if either is zero)
+static double agm(double a, double b) {
+  if (a == 0 || b == 0)
+    return 0.0;
+
+  while (std::abs(a - b) > 1e-15 * a) {
+    const double mean{(a + b) / 2};
+    b = std::sqrt(a * b);
+    a = mean;
+  }
+
+  return a;
+}
+
+double ellipk(const double m) {
+  return std::numbers::pi / (2 * agm(1.0, std::sqrt(1.0 - m)));
+}
+
+double ellipkm1(const double p) {
+  return std::numbers::pi / (2 * agm(1.0, std::sqrt(p)));
+}
+
+// Jacobi elliptic functions sn, cn, dn of u with parameter m (descending
+// Landen transformation, as Cephes' ellpj)
+static std::array<double, 3> ellipj(const double u, const double m) {
+  constexpr double eps{std::numeric_limits<double>::epsilon()};
+
+  if (m < 1e-9) {
+    const double t{std::sin(u)};
+    const double b{std::cos(u)};
+    const double ai{0.25 * m * (u - t * b)};
+    return {t - ai * b, b + ai * t, 1.0 - 0.5 * m * t * t};
+  }
+
+  if (m >= 0.9999999999) {
+    double       ai{0.25 * (1.0 - m)};
+    const double b{std::cosh(u)};
+    const double t{std::tanh(u)};
+    const double phi{1.0 / b};
+    const double twon{b * std::sinh(u)};
+
+    const double sn{t + ai * (twon - u) / (b * b)};
+    ai *= t * phi;
+    return {sn, phi - ai * (twon - u), phi + ai * (twon + u)};
+  }
+
+  std::array<double, 9> a{1.0};
+  std::array<double, 9> c{std::sqrt(m)};
+  double                b{std::sqrt(1.0 - m)};
+  double                twon{1.0};
+  std::size_t           i{0};
+
+  while (std::abs(c[i] / a[i]) > eps && i < 8) {
+    const double ai{a[i]};
+    ++i;
+    c[i] = (ai - b) / 2;
+    a[i] = (ai + b) / 2;
+    b    = std::sqrt(ai * b);
+    twon *= 2;
+  }
+
+  double phi{twon * a[i] * u};
+  double previous{phi};
+  for (; i > 0; --i) {
+    previous = phi;
+    phi      = (std::asin(c[i] * std::sin(phi) / a[i]) + phi) / 2;
+  }
+
+  const double cn{std::cos(phi)};
+  return {std::sin(phi), cn, cn / std::cos(previous - phi)};
+}
+
+// Modulus m of the elliptic function of order n whose complementary integral
+// ratio matches that of m1 (the degree equation, by its nome series)
+static double ellipdeg(const int n, const double m1) {
+  const double q1{std::exp(-std::numbers::pi * ellipkm1(m1) / ellipk(m1))};
+  const double q{std::pow(q1, 1.0 / n)};
+
+  double num{0.0};
+  double den{0.0};
+  for (int i{0}; i <= 7; ++i) {
+    num += std::pow(q, i * (i + 1));
+    den += std::pow(q, (i + 1) * (i + 1));
+  }
+
+  return 16 * q * std::pow(num / (1 + 2 * den), 4);
+}
+
+// Imaginary part of the inverse of sn at i w: the v with sc(v, 1 - m) = w
+// (Landen iteration on the complex argument)
+static double arcJacSc1(const double w, const double m) {
   using namespace std::complex_literals;
 
-  // no zeros
-  std::vector<Complex> zVec(0);
-  std::vector<Complex> pVec(static_cast<std::size_t>(n));
-  EigenMap<ArrayXcd>   z(zVec.data(), n);
-  EigenMap<ArrayXcd>   p(pVec.data(), n);
+  const auto complement{
+      [](const Complex& k) { return std::sqrt((1.0 - k) * (1.0 + k)); }};
+
+  // The moduli of at most ten iterations, on the stack
+  std::array<double, 11> ks{std::sqrt(m)};
+  std::size_t            count{1};
+  while (ks[count - 1] != 0) {
+    if (count > 10)
+      throw std::runtime_error("Landen iteration did not converge");
+    const double kp{std::real(complement(ks[count - 1]))};
+    ks[count++] = (1 - kp) / (1 + kp);
+  }
 
-  // p_k = wc * exp(j * (2k + n - 1) * pi / 2n)
-  // m = 2k + n - 1
-  // theta = pi * m / (2n)
-  // p_k = -exp(j * theta)
-  const ArrayXd m{arange(-n + 1, n, 2).cast<double>()};
-  const ArrayXd theta{std::numbers::pi * m / (2 * n)};
-  p = -(1i * theta).exp();
+  double capK{std::numbers::pi / 2};
+  for (std::size_t i{1}; i < count; ++i)
+    capK *= 1 + ks[i];
+
+  Complex wn{1i * w};
+  for (std::size_t i{0}; i + 1 < count; ++i)
+    wn = 2.0 * wn / ((1 + ks[i + 1]) * (1.0 + complement(ks[i] * wn)));
 
-  return ZPK{zVec, pVec, 1.0};
+  return std::imag(capK * 2 / std::numbers::pi * std::asin(wn));
 }
 
-ZPK iirFilter(const int n, double fc, double fs, const Type type,
-              const Mode mode, const double param) {
-  ZPK analogFilter{};
-  switch (type) {
-  case butter:
-    analogFilter = buttap(n);
-    break;
-  case cheb1:
-    analogFilter = cheb1ap(n, param);
-    break;
-  case cheb2:
-    analogFilter = cheb2ap(n, param);
-    break;
-  default:
-    break;
+double ellipap(const int n, const double rp, const double rs, RootList& z,
+               RootList& p) {
+  using namespace std::complex_literals;
+  constexpr double eps{std::numeric_limits<double>::epsilon()};
+
+  if (n == 0)
+    return std::pow(10, -rp / 20.0);
+
+  if (n == 1) {
+    const double p0{-std::sqrt(1.0 / (std::pow(10, 0.1 * rp) - 1.0))};
+    p.push(p0);
+    return -p0;
+  }
+
+  const double epsSq{std::pow(10, 0.1 * rp) - 1};
+  const double ck1Sq{epsSq / (std::pow(10, 0.1 * rs) - 1)};
+  if (ck1Sq == 0)
+    throw std::runtime_error("Cannot design an elliptic filter with this "
+                             "ripple and attenuation");
+
+  const double m{ellipdeg(n, ck1Sq)};
+  const double capK{ellipk(m)};
+
+  // Zeros on the imaginary axis, poles from sn, cn, dn at a shifted argument
+  const double v0{capK * arcJacSc1(1.0 / std::sqrt(epsSq), ck1Sq) /
+                  (n * ellipk(ck1Sq))};
+  const auto [sv, cv, dv]{ellipj(v0, 1 - m)};
+
+  for (int j{1 - n % 2}; j < n; j += 2) {
+    const auto [s, c, d]{ellipj(j * capK / n, m)};
+    if (std::abs(s) > eps)
+      z.push(1i / (std::sqrt(m) * s));
+    p.push(-(c * d * sv * cv + 1i * s * dv) / (1 - (d * sv) * (d * sv)));
   }
 
-  return analog2digital(analogFilter, fc, fs, mode);
+  // Conjugates, skipping the real pole of odd orders
+  const Index nz{z.size};
+  for (Index i{0}; i < nz; ++i)
+    z.push(std::conj(z.data[i]));
+
+  double norm{0.0};
+  for (Index i{0}; i < p.size; ++i)
+    norm += std::norm(p.data[i]);
+  const Index np{p.size};
+  for (Index i{0}; i < np; ++i) {
+    if (n % 2 == 0 || std::abs(p.data[i].imag()) > eps * std::sqrt(norm))
+      p.push(std::conj(p.data[i]));
+  }
+
+  double k{std::real(p.product(0.0, -1.0) / z.product(0.0, -1.0))};
+  if (n % 2 == 0)
+    k /= std::sqrt(1 + epsSq);
+
+  return k;
 }
 
-ZPK iirFilter(const int n, double fLow, double fHigh, double fs,
-              const Type type, const Mode mode, const double param) {
-  ZPK analogFilter{};
+ZPK ellipap(const int n, const double rp, const double rs) {
+  return prototype(n, [&](RootList& z, RootList& p) {
+    return ellipap(n, rp, rs, z, p);
+  });
+}
+
+double analogPrototype(const Type type, const int n, const double param,
+                       const double attenuation, RootList& z, RootList& p) {
   switch (type) {
   case butter:
-    analogFilter = buttap(n);
-    break;
+    return buttap(n, z, p);
   case cheb1:
-    analogFilter = cheb1ap(n, param);
-    break;
+    return cheb1ap(n, param, z, p);
   case cheb2:
-    analogFilter = cheb2ap(n, param);
-    break;
+    return cheb2ap(n, param, z, p);
+  case ellip:
+    return ellipap(n, param, attenuation, z, p);
   default:
-    break;
+    return 0.0;
   }
+}
 
-  return analog2digital(analogFilter, fLow, fHigh, fs, mode);
+ZPK iirFilter(const int n, double fc, double fs, const Type type,
+              const Mode mode, const double param, const double attenuation) {
+  return transformed(ZPK{}, static_cast<std::size_t>(std::max(n, 0)),
+                     [&](RootList& z, RootList& p, double) {
+                       const double k{analogPrototype(type, n, param,
+                                                      attenuation, z, p)};
+                       return analog2digital(z, p, k, fc, fs, mode);
+                     });
+}
+
+ZPK iirFilter(const int n, double fLow, double fHigh, double fs,
+              const Type type, const Mode mode, const double param,
+              const double attenuation) {
+  // Bandpass and bandstop designs double the roots
+  return transformed(ZPK{}, static_cast<std::size_t>(std::max(2 * n, 0)),
+                     [&](RootList& z, RootList& p, double) {
+                       const double k{analogPrototype(type, n, param,
+                                                      attenuation, z, p)};
+                       return analog2digital(z, p, k, fLow, fHigh, fs, mode);
+                     });
 }
 
 double warpFreq(const double fc, const double fs) {
   return std::tan(std::numbers::pi * fc / fs);
 }
 
-ZPK bilinearTransform(const ZPK& analog, const double fs) {
-  ZPK    digital{};
-  double fs2{2.0 * fs};
-
-  digital.z.resize(analog.z.size());
-  digital.p.resize(analog.p.size());
-
-  EigenMap<ArrayXcd> dz(digital.z.data(), static_cast<Index>(digital.z.size()));
-  EigenMap<ArrayXcd> dp(digital.p.data(), static_cast<Index>(digital.p.size()));
-
-  EigenMap<const ArrayXcd> az(analog.z.data(),
-                              static_cast<Index>(analog.z.size()));
-  EigenMap<const ArrayXcd> ap(analog.p.data(),
-                              static_cast<Index>(analog.p.size()));
-
-  // z = (2fs + s) / (2fs - s)
-  dz = (fs2 + az) / (fs2 - az);
-  dp = (fs2 + ap) / (fs2 - ap);
-
-  const auto degree{analog.p.size() - analog.z.size()};
-  for (std::size_t i{0}; i < degree; ++i) {
-    digital.z.push_back(-1.0);
-  }
+double bilinearTransform(RootList& z, RootList& p, const double k,
+                         const double fs) {
+  const double fs2{2.0 * fs};
 
   // Recalculate gain
   // k' = k * prod(2fs - z)/prod(2fs - p)
-  Complex num{(fs2 - az).prod()};
-  Complex den{(fs2 - ap).prod()};
-  digital.k = analog.k * std::real(num / den);
+  const double gain{k * std::real(z.product(fs2, -1.0) / p.product(fs2, -1.0))};
+
+  // z = (2fs + s) / (2fs - s), with the zeros at infinity mapped to -1
+  for (Index i{0}; i < z.size; ++i)
+    z.data[i] = (fs2 + z.data[i]) / (fs2 - z.data[i]);
+  for (Index i{0}; i < p.size; ++i)
+    p.data[i] = (fs2 + p.data[i]) / (fs2 - p.data[i]);
+  while (z.size < p.size)
+    z.push(-1.0);
 
-  return digital;
+  return gain;
+}
+
+ZPK bilinearTransform(const ZPK& analog, const double fs) {
+  return transformed(analog, 0, [&](RootList& z, RootList& p, double k) {
+    return bilinearTransform(z, p, k, fs);
+  });
 }
 
 ArrayXcd freqz(const EigenZPK&                  digitalFilter,
@@ -270,6 +482,128 @@ ArrayXcd freqz(const EigenZPK&                  digitalFilter,
   return h;
 }
 
+// Scale below which a polynomial is treated as zero when its group delay is
+// computed, relative to the sum of its absolute coefficients
+constexpr double kSingularResponse{10.0 *
+                                   std::numeric_limits<double>::epsilon()};
+
+// Frequencies per block of the arbitrary grid frequency response
+constexpr Index kFreqzBlock{256};
+
+// Taps (of b and a together) per log2 of the FFT size above which a uniform
+// grid frequency response is evaluated with FFTs
+constexpr double kFreqzFftTaps{3.0};
+
+// Group delay contribution Re(sum m c_m z^m / sum c_m z^m) of a polynomial,
+// set to zero where the polynomial vanishes
+static ArrayXd delayTerm(const ArrayXcd& p, const ArrayXcd& mp,
+                         const Eigen::Ref<const ArrayXd>& c) {
+  const double tiny{kSingularResponse * c.abs().sum()};
+
+  return (p.abs2() > tiny * tiny).select((mp / p).real(), 0.0);
+}
+
+static FrequencyResponse makeResponse(ArrayXd w, const ArrayXcd& b,
+                                      const ArrayXcd& mb, const ArrayXcd& a,
+                                      const ArrayXcd& ma,
+                                      const EigenCoeffs& filter) {
+  FrequencyResponse response{};
+  response.w = std::move(w);
+  response.h = b / a;
+  // sqrt(abs2) vectorises, unlike the overflow-safe hypot behind abs
+  response.magnitude  = response.h.abs2().sqrt();
+  response.phase      = response.h.arg();
+  response.groupDelay = delayTerm(b, mb, filter.b) - delayTerm(a, ma, filter.a);
+
+  return response;
+}
+
+// Evaluates sum_m c_m e^(-2 pi j k m / nfft) for the first count bins k with
+// a real FFT. Coefficients beyond nfft wrap around, which is exact as the
+// exponential is periodic, and bins past the half spectrum are conjugates.
+static ArrayXcd polyOnGrid(const Eigen::Ref<const ArrayXd>& c,
+                           const Index nfft, const Index count) {
+  VectorXd folded{VectorXd::Zero(nfft)};
+  for (Index m{0}; m < c.size(); ++m)
+    folded(m % nfft) += c(m);
+
+  VectorXcd spectrum;
+  Utils::rfft(folded, spectrum, nfft);
+
+  const Index half{spectrum.size()};
+  spectrum.conservativeResize(count);
+  for (Index k{half}; k < count; ++k)
+    spectrum(k) = std::conj(spectrum(nfft - k));
+
+  return spectrum.array();
+}
+
+// Evaluates p = sum_m c_m z^m and mp = sum_m m c_m z^m = z p'(z) with Horner's
+// scheme on p and its derivative, for every z of a block at once
+static void hornerBlock(const Eigen::Ref<const ArrayXd>& c, const ArrayXcd& z,
+                        Eigen::Ref<ArrayXcd> p, Eigen::Ref<ArrayXcd> mp) {
+  const Index last{c.size() - 1};
+
+  p.setConstant(c(last));
+  mp.setZero();
+  for (Index m{last - 1}; m >= 0; --m) {
+    mp = mp * z + p;
+    p  = p * z + c(m);
+  }
+  mp *= z;
+}
+
+FrequencyResponse freqz(const EigenCoeffs&               filter,
+                        const Eigen::Ref<const ArrayXd>& w) {
+  const Index n{w.size()};
+  const Index blocks{(n + kFreqzBlock - 1) / kFreqzBlock};
+
+  ArrayXcd b(n), mb(n), a(n), ma(n);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index block = 0; block < blocks; ++block) {
+    const Index start{block * kFreqzBlock};
+    const Index len{std::min(kFreqzBlock, n - start)};
+
+    // z = e^(-jw), so the polynomials in z are those in z^-1 of the filter
+    ArrayXcd z(len);
+    z.real() = w.segment(start, len).cos();
+    z.imag() = -w.segment(start, len).sin();
+
+    hornerBlock(filter.b, z, b.segment(start, len), mb.segment(start, len));
+    hornerBlock(filter.a, z, a.segment(start, len), ma.segment(start, len));
+  }
+
+  return makeResponse(w, b, mb, a, ma, filter);
+}
+
+FrequencyResponse freqz(const EigenCoeffs& filter, const Index n,
+                        const bool whole) {
+  if (n < 1)
+    throw std::runtime_error("Number of frequencies must be positive");
+
+  const Index   nfft{whole ? n : 2 * n};
+  const ArrayXd w{ArrayXd::LinSpaced(n, 0, static_cast<double>(n - 1)) * 2.0 *
+                  std::numbers::pi / static_cast<double>(nfft)};
+
+  // Four transforms cost about as much as evaluating 3 log2(nfft) taps per
+  // frequency, so short filters are cheaper to evaluate directly
+  const auto taps{static_cast<double>(filter.b.size() + filter.a.size())};
+  if (taps <= kFreqzFftTaps * std::log2(static_cast<double>(nfft)))
+    return freqz(filter, w);
+
+  const ArrayXd mb{filter.b * ArrayXd::LinSpaced(filter.b.size(), 0,
+                                                 filter.b.size() - 1)};
+  const ArrayXd ma{filter.a * ArrayXd::LinSpaced(filter.a.size(), 0,
+                                                 filter.a.size() - 1)};
+
+  return makeResponse(w, polyOnGrid(filter.b, nfft, n), polyOnGrid(mb, nfft, n),
+                      polyOnGrid(filter.a, nfft, n), polyOnGrid(ma, nfft, n),
+                      filter);
+}
+
 std::vector<Complex> freqz(const ZPK&                 digitalFilter,
                            const std::vector<double>& w) {
   std::vector<Complex> h;
@@ -287,137 +621,100 @@ std::vector<Complex> freqz(const ZPK&                 digitalFilter,
   return h;
 }
 
-ZPK lp2lp(const ZPK& input, const double wc) {
-  ZPK output{};
-  output.z.resize(input.z.size());
-  output.p.resize(input.p.size());
-
-  EigenMap<ArrayXcd> oz(output.z.data(), static_cast<Index>(output.z.size()));
-  EigenMap<ArrayXcd> op(output.p.data(), static_cast<Index>(output.p.size()));
-
-  EigenMap<const ArrayXcd> iz(input.z.data(),
-                              static_cast<Index>(input.z.size()));
-  EigenMap<const ArrayXcd> ip(input.p.data(),
-                              static_cast<Index>(input.p.size()));
+double lp2lp(RootList& z, RootList& p, const double k, const double wc) {
+  const Index degree{p.size - z.size};
 
   // Transformation
-  oz = iz * wc;
-  op = ip * wc;
+  for (Index i{0}; i < z.size; ++i)
+    z.data[i] *= wc;
+  for (Index i{0}; i < p.size; ++i)
+    p.data[i] *= wc;
 
   // Update gain
-  const auto degree{input.p.size() - input.z.size()};
-  output.k = input.k * std::pow(wc, degree);
-
-  return output;
+  return k * std::pow(wc, degree);
 }
 
-ZPK lp2hp(const ZPK& input, const double wc) {
-  const auto degree{input.p.size() - input.z.size()};
+ZPK lp2lp(const ZPK& input, const double wc) {
+  return transformed(input, 0, [&](RootList& z, RootList& p, double k) {
+    return lp2lp(z, p, k, wc);
+  });
+}
 
-  ZPK output{};
-  output.z.resize(input.z.size() + degree);
-  output.p.resize(input.p.size());
+double lp2hp(RootList& z, RootList& p, const double k, const double wc) {
+  const Index  degree{p.size - z.size};
+  const double gain{k * std::real(z.product(0.0, -1.0) / p.product(0.0, -1.0))};
 
-  EigenMap<ArrayXcd> oz(output.z.data(), static_cast<Index>(output.z.size()));
-  EigenMap<ArrayXcd> op(output.p.data(), static_cast<Index>(output.p.size()));
+  for (Index i{0}; i < z.size; ++i)
+    z.data[i] = wc / z.data[i];
+  for (Index i{0}; i < p.size; ++i)
+    p.data[i] = wc / p.data[i];
+  for (Index i{0}; i < degree; ++i)
+    z.push(0.0);
 
-  EigenMap<const ArrayXcd> iz(input.z.data(),
-                              static_cast<Index>(input.z.size()));
-  EigenMap<const ArrayXcd> ip(input.p.data(),
-                              static_cast<Index>(input.p.size()));
+  return gain;
+}
 
-  if (iz.size() > 0)
-    oz.head(iz.size()) = wc * iz.cwiseInverse();
-  if (ip.size() > 0)
-    op = wc * ip.cwiseInverse();
+ZPK lp2hp(const ZPK& input, const double wc) {
+  return transformed(input, 0, [&](RootList& z, RootList& p, double k) {
+    return lp2hp(z, p, k, wc);
+  });
+}
 
-  if (degree > 0) {
-    EigenMap<ArrayXcd>(output.z.data() + input.z.size(),
-                       static_cast<Index>(degree))
-        .setZero();
+// Maps each root r to t + sqrt(t^2 - wc^2) in the first half of the list and
+// t - sqrt(...) in the second, with t = r bw / 2 (bandpass) or bw / 2r
+// (bandstop). Filling from the end keeps the unread roots intact.
+static void splitRoots(RootList& roots, const double wc, const double bw,
+                       const bool stop) {
+  const Index n{roots.size};
+  for (Index i{n}; i-- > 0;) {
+    const Complex t{stop ? (bw / 2.0) / roots.data[i]
+                         : roots.data[i] * (bw / 2.0)};
+    const Complex term{Eigen::numext::sqrt(t * t - wc * wc)};
+    roots.data[i]     = t + term;
+    roots.data[n + i] = t - term;
   }
-
-  output.k = input.k * std::real((-iz).prod() / (-ip).prod());
-
-  return output;
+  roots.size = 2 * n;
 }
 
-ZPK lp2bp(const ZPK& input, const double wc, const double bw) {
-  const auto degree = input.p.size() - input.z.size();
-
-  ZPK output{};
-  output.z.resize(2 * input.z.size() + degree);
-  output.p.resize(2 * input.p.size());
-
-  EigenMap<ArrayXcd> oz(output.z.data(), static_cast<Index>(output.z.size()));
-  EigenMap<ArrayXcd> op(output.p.data(), static_cast<Index>(output.p.size()));
+double lp2bp(RootList& z, RootList& p, const double k, const double wc,
+             const double bw) {
+  const Index degree{p.size - z.size};
 
-  EigenMap<const ArrayXcd> iz(input.z.data(),
-                              static_cast<Index>(input.z.size()));
-  EigenMap<const ArrayXcd> ip(input.p.data(),
-                              static_cast<Index>(input.p.size()));
+  splitRoots(z, wc, bw, false);
+  splitRoots(p, wc, bw, false);
+  for (Index i{0}; i < degree; ++i)
+    z.push(0.0);
 
-  if (iz.size() > 0) {
-    ArrayXcd z_lp{iz * (bw / 2.0)};
-    ArrayXcd term{(z_lp.square() - (wc * wc)).sqrt()};
-    oz.head(iz.size())               = z_lp + term;
-    oz.segment(iz.size(), iz.size()) = z_lp - term;
-  }
+  return k * std::pow(bw, degree);
+}
 
-  if (degree > 0) {
-    oz.tail(degree).setZero();
-  }
+ZPK lp2bp(const ZPK& input, const double wc, const double bw) {
+  return transformed(input, 2 * std::max(input.z.size(), input.p.size()),
+                     [&](RootList& z, RootList& p, double k) {
+                       return lp2bp(z, p, k, wc, bw);
+                     });
+}
 
-  if (ip.size() > 0) {
-    ArrayXcd p_lp{ip * (bw / 2.0)};
-    ArrayXcd term{(p_lp.square() - (wc * wc)).sqrt()};
-    op.head(ip.size()) = p_lp + term;
-    op.tail(ip.size()) = p_lp - term;
-  }
+double lp2bs(RootList& z, RootList& p, const double k, const double wc,
+             const double bw) {
+  const Index  degree{p.size - z.size};
+  const double gain{k * std::real(z.product(0.0, -1.0) / p.product(0.0, -1.0))};
 
-  output.k = input.k * std::pow(bw, degree);
+  splitRoots(z, wc, bw, true);
+  splitRoots(p, wc, bw, true);
+  for (Index i{0}; i < degree; ++i)
+    z.push(Complex{0.0, wc});
+  for (Index i{0}; i < degree; ++i)
+    z.push(Complex{0.0, -wc});
 
-  return output;
+  return gain;
 }
 
 ZPK lp2bs(const ZPK& input, const double wc, const double bw) {
-  const auto degree{input.p.size() - input.z.size()};
-
-  ZPK output{};
-  output.z.resize(2 * input.z.size() + 2 * degree);
-  output.p.resize(2 * input.p.size());
-
-  EigenMap<ArrayXcd> oz(output.z.data(), static_cast<Index>(output.z.size()));
-  EigenMap<ArrayXcd> op(output.p.data(), static_cast<Index>(output.p.size()));
-
-  EigenMap<const ArrayXcd> iz(input.z.data(),
-                              static_cast<Index>(input.z.size()));
-  EigenMap<const ArrayXcd> ip(input.p.data(),
-                              static_cast<Index>(input.p.size()));
-
-  if (iz.size() > 0) {
-    ArrayXcd z_hp{(bw / 2.0) * iz.cwiseInverse()};
-    ArrayXcd term{(z_hp.square() - (wc * wc)).sqrt()};
-    oz.head(iz.size())               = z_hp + term;
-    oz.segment(iz.size(), iz.size()) = z_hp - term;
-  }
-
-  if (degree > 0) {
-    oz.segment(2 * static_cast<Index>(input.z.size()), degree)
-        .setConstant(std::complex<double>(0, wc));
-    oz.tail(degree).setConstant(std::complex<double>(0, -wc));
-  }
-
-  if (ip.size() > 0) {
-    ArrayXcd p_hp      = (bw / 2.0) * ip.cwiseInverse();
-    ArrayXcd term      = (p_hp.square() - (wc * wc)).sqrt();
-    op.head(ip.size()) = p_hp + term;
-    op.tail(ip.size()) = p_hp - term;
-  }
-
-  output.k = input.k * std::real((-iz).prod() / (-ip).prod());
-
-  return output;
+  return transformed(input, 2 * std::max(input.z.size(), input.p.size()),
+                     [&](RootList& z, RootList& p, double k) {
+                       return lp2bs(z, p, k, wc, bw);
+                     });
 }
 
 ArrayXd roots2poly(const Eigen::Ref<const ArrayXcd>& roots) {
@@ -461,167 +758,1254 @@ Coeffs zpk2tf(const ZPK& zpk) {
   return tf;
 }
 
-RowMajorMatrixXd linearFilter(const EigenCoeffs&&                       filter,
-                              const Eigen::Ref<const RowMajorMatrixXd>& x,
-                              Eigen::Ref<RowMajorMatrixXd>              state) {
-  const Index nRows{static_cast<Index>(x.rows())};
+// Which roots to consider when searching for the nearest one
+enum class RootKind { any, real, complex };
 
-  RowMajorMatrixXd y(nRows, x.cols());
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-  for (Index r = 0; r < nRows; ++r) {
-    y.row(r) = linearFilter(filter, Eigen::Ref<const ArrayXd>{x.row(r)},
-                            Eigen::Ref<ArrayXd>{state.row(r)});
-  }
+static bool isReal(const Complex& c) { return c.imag() == 0.0; }
 
-  return y;
+static Index countReal(const RootList& roots) {
+  return std::count_if(roots.data, roots.data + roots.size, isReal);
 }
 
-ArrayXd linearFilter(const EigenCoeffs&               filter,
-                     const Eigen::Ref<const ArrayXd>& x,
-                     Eigen::Ref<ArrayXd>              state) {
-  const Index nB{filter.b.size()};
-  const Index nA{filter.a.size()};
-  const Index nX{x.size()};
-  const Index nS{std::max(nB, nA) - 1};
+// Keeps the real roots (with the imaginary part snapped to zero) and one root
+// of each complex-conjugate pair (the one with positive imaginary part)
+static void conjugateHalf(std::span<const Complex> roots, RootList& half) {
+  constexpr double eps{std::numeric_limits<double>::epsilon()};
+
+  half.size = 0;
+  for (const auto& r : roots) {
+    if (std::abs(r.imag()) <= 100 * eps * std::abs(r))
+      half.push({r.real(), 0.0});
+    else if (r.imag() > 0)
+      half.push(r);
+  }
+}
 
-  if (state.size() < nS) {
-    ArrayXd newState = ArrayXd::Zero(nS);
-    if (state.size() > 0) {
-      newState.head(state.size()) = state;
+// Removes and returns the root of the given kind nearest to `to`, falling
+// back to any kind (or to the origin if no roots are left)
+static Complex popNearest(RootList& roots, const Complex& to,
+                          const RootKind kind) {
+  Index  best{-1};
+  double bestDist{std::numeric_limits<double>::infinity()};
+
+  for (Index i{0}; i < roots.size; ++i) {
+    if ((kind == RootKind::real && !isReal(roots.data[i])) ||
+        (kind == RootKind::complex && isReal(roots.data[i])))
+      continue;
+
+    const double dist{std::abs(roots.data[i] - to)};
+    if (dist < bestDist) {
+      bestDist = dist;
+      best     = i;
     }
-    state = newState;
   }
-  ArrayXd y(nX);
 
-  for (Index k{0}; k < nX; ++k) {
-    const double xk = x(k);
+  if (best < 0)
+    return kind == RootKind::any ? Complex{}
+                                 : popNearest(roots, to, RootKind::any);
 
-    y(k) = state(0) + filter.b(0) * xk;
+  const Complex r{roots.data[best]};
+  roots.erase(best);
 
-    if (nS > 1) {
-      state.head(nS - 1) = state.tail(nS - 1) +
-                           filter.b.segment(1, nS - 1) * xk -
-                           filter.a.segment(1, nS - 1) * y(k);
-    }
+  return r;
+}
+
+// Removes and returns the pole of the given kind closest to the unit circle
+static Complex popWorstPole(RootList&      poles,
+                            const RootKind kind = RootKind::any) {
+  Index  worst{0};
+  double worstDist{std::numeric_limits<double>::infinity()};
+
+  for (Index i{0}; i < poles.size; ++i) {
+    if (kind == RootKind::real && !isReal(poles.data[i]))
+      continue;
 
-    state(nS - 1) = filter.b(nB - 1) * xk - filter.a(nA - 1) * y(k);
+    const double dist{std::abs(1.0 - std::abs(poles.data[i]))};
+    if (dist < worstDist) {
+      worstDist = dist;
+      worst     = i;
+    }
   }
 
-  return y;
-}
+  const Complex p{poles.data[worst]};
+  poles.erase(worst);
 
-ArrayXd linearFilter(const EigenCoeffs&               filter,
-                     const Eigen::Ref<const ArrayXd>& x) {
-  const auto nS{std::max(filter.b.size(), filter.a.size()) - 1};
-  ArrayXd    state{ArrayXd::Zero(nS)};
+  return p;
+}
 
-  return linearFilter(filter, x, state);
+// Writes the section with the given roots and gain at sos[0..5]
+static void writeSection(double* sos, const Complex& z1, const Complex& z2,
+                         const Complex& p1, const Complex& p2,
+                         const double gain) {
+  sos[0] = gain;
+  sos[1] = -gain * std::real(z1 + z2);
+  sos[2] = gain * std::real(z1 * z2);
+  sos[3] = 1.0;
+  sos[4] = -std::real(p1 + p2);
+  sos[5] = std::real(p1 * p2);
 }
 
-Signal linearFilter(const Coeffs& filter, const Signal& x, Signal& si) {
-  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
-  EigenMap<ArrayXd>             siMap(si.data(), static_cast<Index>(si.size()));
+Index zpk2sos(std::span<const Complex> zeros, std::span<const Complex> poles,
+              const double k, RootList& z, RootList& p, double* sos) {
+  if (zeros.empty() && poles.empty()) {
+    std::fill_n(sos, 6, 0.0);
+    sos[0] = k;
+    sos[3] = 1.0;
+    return 1;
+  }
 
-  EigenCoeffs eigenFilter{
-      EigenMap<const ArrayXd>(filter.b.data(),
-                              static_cast<Index>(filter.b.size())),
-      EigenMap<const ArrayXd>(filter.a.data(),
-                              static_cast<Index>(filter.a.size()))};
+  conjugateHalf(zeros, z);
+  conjugateHalf(poles, p);
+
+  // Equal number of poles and zeros (padding at the origin), rounded up to an
+  // even number so that every section is second order
+  const auto nZeros{static_cast<Index>(zeros.size())};
+  const auto nPoles{static_cast<Index>(poles.size())};
+  Index      n{std::max(nZeros, nPoles)};
+  for (Index i{nZeros}; i < n; ++i)
+    z.push(0.0);
+  for (Index i{nPoles}; i < n; ++i)
+    p.push(0.0);
+  if (n % 2) {
+    z.push(0.0);
+    p.push(0.0);
+    ++n;
+  }
 
-  Eigen::Ref<const ArrayXd> xVec{xMap};
-  Eigen::Ref<ArrayXd>       siVec{siMap};
-  const ArrayXd             yMap{linearFilter(eigenFilter, xVec, siVec)};
-  Signal                    y(static_cast<std::size_t>(yMap.size()));
-  EigenMap<ArrayXd>(y.data(), static_cast<Index>(y.size())) = yMap;
+  // Pair the poles closest to the unit circle first, filling the cascade from
+  // the end
+  const Index nSections{n / 2};
+  for (Index si{nSections}; si-- > 0;) {
+    double*       section{sos + 6 * si};
+    const double  gain{si == 0 ? k : 1.0};
+    const Complex p1{popWorstPole(p)};
+
+    if (isReal(p1) && countReal(p) == 0) {
+      // Last remaining real pole
+      writeSection(section, popNearest(z, p1, RootKind::real), 0.0, p1, 0.0,
+                   gain);
+    } else if (p.size + 1 == z.size && !isReal(p1) && countReal(p) == 1 &&
+               countReal(z) == 1) {
+      // One real pole and one real zero left: pair with a complex zero
+      const Complex z1{popNearest(z, p1, RootKind::complex)};
+      writeSection(section, z1, std::conj(z1), p1, std::conj(p1), gain);
+    } else {
+      const Complex p2{isReal(p1) ? popWorstPole(p, RootKind::real)
+                                  : std::conj(p1)};
+
+      if (z.size == 0) {
+        writeSection(section, 0.0, 0.0, p1, p2, gain);
+        continue;
+      }
+
+      const Complex z1{popNearest(z, p1, RootKind::any)};
+      if (!isReal(z1))
+        writeSection(section, z1, std::conj(z1), p1, p2, gain);
+      else if (z.size > 0)
+        writeSection(section, z1, popNearest(z, p1, RootKind::real), p1, p2,
+                     gain);
+      else
+        writeSection(section, z1, 0.0, p1, p2, gain);
+    }
+  }
 
-  return y;
+  return nSections;
 }
 
-Signal linearFilter(const Coeffs& filter, const Signal& x) {
-  const auto nS{std::max(filter.b.size(), filter.a.size()) - 1};
-  Signal     si(nS, 0.0);
+SOS zpk2sos(const ZPK& zpk) {
+  const std::size_t    n{std::max(zpk.z.size(), zpk.p.size()) + 1};
+  std::vector<Complex> zWork(n);
+  std::vector<Complex> pWork(n);
+  RootList             z{zWork.data(), 0};
+  RootList             p{pWork.data(), 0};
 
-  return linearFilter(filter, x, si);
+  std::vector<double> flat(6 * std::max<std::size_t>(n / 2, 1));
+  const Index nSections{zpk2sos(zpk.z, zpk.p, zpk.k, z, p, flat.data())};
+
+  SOS sos(static_cast<std::size_t>(nSections));
+  for (std::size_t si{0}; si < sos.size(); ++si)
+    std::copy_n(flat.data() + 6 * si, 6, sos[si].begin());
+
+  return sos;
 }
 
-ArrayXd findEffectiveIR(const EigenCoeffs& filter, const double epsilon,
-                        const Index maxLength) {
-  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
-  ArrayXd     si{ArrayXd::Zero(nS)};
+SosArray zpk2sos(const EigenZPK& zpk) {
+  const Index n{std::max(zpk.z.size(), zpk.p.size()) + 1};
+  ArrayXcd    zWork(n);
+  ArrayXcd    pWork(n);
+  RootList    z{zWork.data(), 0};
+  RootList    p{pWork.data(), 0};
 
-  ArrayXd impulse{ArrayXd::Zero(maxLength)};
-  impulse(0) = 1.0;
-  Eigen::Ref<const ArrayXd> impulseRef{impulse};
-  Eigen::Ref<ArrayXd>       siRef{si};
-  ArrayXd                   ir{linearFilter(filter, impulseRef, siRef)};
+  SosArray sos(std::max<Index>(n / 2, 1), 6);
+  zpk2sos({zpk.z.data(), static_cast<std::size_t>(zpk.z.size())},
+          {zpk.p.data(), static_cast<std::size_t>(zpk.p.size())}, zpk.k, z, p,
+          sos.data());
 
-  // find effective length
-  Index irLength{ir.size()};
-  for (auto i{ir.size() - 1}; i > 0; --i) {
-    if (std::abs(ir(i)) >= epsilon) {
-      irLength = i + 1;
-      break;
+  return sos;
+}
+
+template <typename Scalar>
+using ArrayX = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+
+template <typename Scalar>
+using RowMajorMatrixX =
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// Number of channels filtered together, one per SIMD lane. 64 bytes of lanes
+// (8 doubles or 16 floats) fill one AVX-512 register or two AVX2 registers,
+// giving the out-of-order core enough independent recurrences to hide the
+// multiply-add latency.
+template <typename Scalar>
+constexpr Index kLanes{64 / static_cast<Index>(sizeof(Scalar))};
+
+// Number of samples transposed into the interleaved layout at a time, sized so
+// that the tile stays in L1 cache
+constexpr Index kTileLength{256};
+
+template <typename Scalar>
+using LaneArray = Eigen::Array<Scalar, kLanes<Scalar>, 1>;
+template <typename Scalar>
+using LaneBlock = Eigen::Array<Scalar, kLanes<Scalar>, Eigen::Dynamic>;
+
+// Filters up to kLanes channels starting at row r0, each with the
+// coefficients in its lane of b and a. The channels are interleaved tile by
+// tile (one column per time step, one row per lane) so that each time step
+// updates all lanes with a single vector operation.
+template <typename Scalar>
+static void
+linearFilterLanes(const LaneBlock<Scalar>& b, const LaneBlock<Scalar>& a,
+                  const Eigen::Ref<const RowMajorMatrixX<Scalar>>& x,
+                  Eigen::Ref<RowMajorMatrixX<Scalar>>              state,
+                  Eigen::Ref<RowMajorMatrixX<Scalar>> y, const Index r0,
+                  const Index lanes) {
+  const Index nS{b.cols() - 1};
+  const Index nX{x.cols()};
+
+  LaneBlock<Scalar> s{LaneBlock<Scalar>::Zero(kLanes<Scalar>, nS)};
+  s.topRows(lanes) = state.block(r0, 0, lanes, nS);
+
+  LaneBlock<Scalar> tile{LaneBlock<Scalar>::Zero(kLanes<Scalar>, kTileLength)};
+
+  for (Index t0{0}; t0 < nX; t0 += kTileLength) {
+    const Index len{std::min(kTileLength, nX - t0)};
+    tile.block(0, 0, lanes, len) = x.block(r0, t0, lanes, len);
+
+    for (Index k{0}; k < len; ++k) {
+      const LaneArray<Scalar> xk{tile.col(k)};
+      const LaneArray<Scalar> yk{s.col(0) + b.col(0) * xk};
+
+      for (Index j{0}; j < nS - 1; ++j) {
+        s.col(j) = s.col(j + 1) + b.col(j + 1) * xk - a.col(j + 1) * yk;
+      }
+      s.col(nS - 1) = b.col(nS) * xk - a.col(nS) * yk;
+
+      tile.col(k) = yk;
     }
+
+    y.block(r0, t0, lanes, len) = tile.block(0, 0, lanes, len);
   }
 
-  return ir.head(irLength);
+  state.block(r0, 0, lanes, nS) = s.topRows(lanes);
 }
 
-Signal findEffectiveIR(const Coeffs& filter, const double epsilon,
-                       const std::size_t maxLength) {
-  const std::size_t   nS{std::max(filter.b.size(), filter.a.size()) - 1};
-  std::vector<double> si(nS, 0.0);
+template <typename Scalar>
+static void
+linearFilterMultichannel(const BasicEigenCoeffs<Scalar>& filter,
+                         const Eigen::Ref<const RowMajorMatrixX<Scalar>>& x,
+                         Eigen::Ref<RowMajorMatrixX<Scalar>>              y,
+                         Eigen::Ref<RowMajorMatrixX<Scalar>> state) {
+  const Index nRows{static_cast<Index>(x.rows())};
+  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
 
-  Signal impulse(maxLength, 0.0);
-  impulse[0] = 1.0;
-  Signal ir{linearFilter(filter, impulse, si)};
+  if (state.rows() != nRows || state.cols() < nS)
+    throw std::runtime_error("Filter state must have one row per channel");
 
-  // find effective length
-  std::size_t irLength{ir.size()};
-  for (std::size_t i{ir.size() - 1}; i > 0; --i) {
-    if (std::abs(ir[i]) >= epsilon) {
-      irLength = i + 1;
-      break;
-    }
+  if (y.rows() != nRows || y.cols() != x.cols())
+    throw std::runtime_error("Output must have the same shape as the input");
+
+  if (nS == 0) {
+    y = (filter.b(0) / filter.a(0)) * x;
+    return;
+  }
+
+  // Normalise by a(0) and zero-pad the shorter polynomial so both have
+  // nS + 1 coefficients, the same in every lane
+  constexpr Index   lanes{kLanes<Scalar>};
+  LaneBlock<Scalar> b{LaneBlock<Scalar>::Zero(lanes, nS + 1)};
+  LaneBlock<Scalar> a{LaneBlock<Scalar>::Zero(lanes, nS + 1)};
+  b.leftCols(filter.b.size()) =
+      (filter.b / filter.a(0)).transpose().replicate(lanes, 1);
+  a.leftCols(filter.a.size()) =
+      (filter.a / filter.a(0)).transpose().replicate(lanes, 1);
+
+  const Index nBlocks{(nRows + lanes - 1) / lanes};
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index blk = 0; blk < nBlocks; ++blk) {
+    const Index r0{blk * lanes};
+    linearFilterLanes<Scalar>(b, a, x, state, y, r0,
+                              std::min(lanes, nRows - r0));
   }
+}
 
-  ir.resize(irLength);
+RowMajorMatrixXd linearFilter(const EigenCoeffs&&                       filter,
+                              const Eigen::Ref<const RowMajorMatrixXd>& x,
+                              Eigen::Ref<RowMajorMatrixXd>              state) {
+  RowMajorMatrixXd y(x.rows(), x.cols());
+  linearFilterMultichannel<double>(filter, x, y, state);
 
-  return ir;
+  return y;
 }
 
-ArrayXd fastConvolve(const Eigen::Ref<const ArrayXd>& f,
-                     const Eigen::Ref<const ArrayXd>& g) {
-  Eigen::FFT<double> fft;
+void linearFilter(const EigenCoeffs&&                       filter,
+                  const Eigen::Ref<const RowMajorMatrixXd>& x,
+                  Eigen::Ref<RowMajorMatrixXd>              y,
+                  Eigen::Ref<RowMajorMatrixXd>              state) {
+  linearFilterMultichannel<double>(filter, x, y, state);
+}
 
-  const std::size_t L{static_cast<std::size_t>(f.size())};
-  const std::size_t M{static_cast<std::size_t>(g.size())};
-  const auto        N = L + M - 1;
+RowMajorMatrixXf linearFilter(const EigenCoeffsF&&                      filter,
+                              const Eigen::Ref<const RowMajorMatrixXf>& x,
+                              Eigen::Ref<RowMajorMatrixXf>              state) {
+  RowMajorMatrixXf y(x.rows(), x.cols());
+  linearFilterMultichannel<float>(filter, x, y, state);
 
-  // Find the next power of 2 for FFT efficiency
-  int N_fft = 1;
-  while (static_cast<std::size_t>(N_fft) < N)
-    N_fft <<= 1;
+  return y;
+}
 
-  // Zero-pad both signals to N_fft
-  VectorXd fPadded{VectorXd::Zero(N_fft)};
-  VectorXd gPadded{VectorXd::Zero(N_fft)};
-  fPadded.head(static_cast<Index>(L)) = f;
-  gPadded.head(static_cast<Index>(M)) = g;
+void linearFilter(const Eigen::Ref<const RowMajorMatrixXd>& b,
+                  const Eigen::Ref<const RowMajorMatrixXd>& a,
+                  const Eigen::Ref<const RowMajorMatrixXd>& x,
+                  Eigen::Ref<RowMajorMatrixXd>              y,
+                  Eigen::Ref<RowMajorMatrixXd>              state) {
+  const Index nRows{x.rows()};
+  const Index nS{std::max(b.cols(), a.cols()) - 1};
 
-  VectorXcd F, G;
-  fft.fwd(F, fPadded);
-  fft.fwd(G, gPadded);
+  if (b.rows() != nRows || a.rows() != nRows)
+    throw std::runtime_error("Coefficients must have one row per channel");
 
-  VectorXcd FG{F.array() * G.array()};
+  if (state.rows() != nRows || state.cols() < nS)
+    throw std::runtime_error("Filter state must have one row per channel");
 
-  VectorXd yPad;
-  fft.inv(yPad, FG);
+  if (y.rows() != nRows || y.cols() != x.cols())
+    throw std::runtime_error("Output must have the same shape as the input");
 
-  return yPad.head(static_cast<Index>(N));
-}
+  if (nS == 0) {
+    y = (b.col(0).array() / a.col(0).array()).matrix().asDiagonal() * x;
+    return;
+  }
+
+  constexpr Index lanes{kLanes<double>};
+  const Index     nBlocks{(nRows + lanes - 1) / lanes};
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index blk = 0; blk < nBlocks; ++blk) {
+    const Index r0{blk * lanes};
+    const Index rows{std::min(lanes, nRows - r0)};
+
+    // The coefficients of each channel in its lane, normalised by its a(0)
+    // and zero-padded to nS + 1
+    LaneArray<double> a0{LaneArray<double>::Ones()};
+    a0.head(rows) = a.col(0).segment(r0, rows).array();
+    LaneBlock<double> bl{LaneBlock<double>::Zero(lanes, nS + 1)};
+    LaneBlock<double> al{LaneBlock<double>::Zero(lanes, nS + 1)};
+    bl.topLeftCorner(rows, b.cols()) = b.middleRows(r0, rows);
+    al.topLeftCorner(rows, a.cols()) = a.middleRows(r0, rows);
+    bl.colwise() /= a0;
+    al.colwise() /= a0;
+
+    linearFilterLanes<double>(bl, al, x, state, y, r0, rows);
+  }
+}
+
+RowMajorMatrixXd linearFilter(const Eigen::Ref<const RowMajorMatrixXd>& b,
+                              const Eigen::Ref<const RowMajorMatrixXd>& a,
+                              const Eigen::Ref<const RowMajorMatrixXd>& x,
+                              Eigen::Ref<RowMajorMatrixXd>              state) {
+  RowMajorMatrixXd y(x.rows(), x.cols());
+  linearFilter(b, a, x, y, state);
+
+  return y;
+}
+
+// Runs the sections of up to kLanes channels starting at row r0 (section i of
+// every lane in columns 6i..6i+5 of sos). Like linearFilterLanes, the channels
+// are interleaved tile by tile; each section runs over the tile in place, its
+// coefficients and state held in registers.
+static void sosFilterLanes(const Eigen::Ref<const RowMajorMatrixXd>& sos,
+                           const Eigen::Ref<const RowMajorMatrixXd>& x,
+                           Eigen::Ref<RowMajorMatrixXd>              state,
+                           Eigen::Ref<RowMajorMatrixXd> y, const Index r0,
+                           const Index lanes) {
+  using Lanes = LaneArray<double>;
+
+  const Index nSections{sos.cols() / 6};
+  const Index nX{x.cols()};
+
+  // b0, b1, b2, a1, a2 of every section normalised by a0; unused lanes pass
+  // their (zero) input through
+  LaneBlock<double> c{LaneBlock<double>::Zero(kLanes<double>, 5 * nSections)};
+  for (Index i{0}; i < nSections; ++i) {
+    const auto  section{sos.block(r0, 6 * i, lanes, 6).array()};
+    c.col(5 * i).setOnes();
+    for (Index j{0}; j < 3; ++j)
+      c.col(5 * i + j).head(lanes) = section.col(j) / section.col(3);
+    for (Index j{0}; j < 2; ++j)
+      c.col(5 * i + 3 + j).head(lanes) = section.col(4 + j) / section.col(3);
+  }
+
+  LaneBlock<double> s{LaneBlock<double>::Zero(kLanes<double>, 2 * nSections)};
+  s.topRows(lanes) = state.block(r0, 0, lanes, 2 * nSections);
+
+  LaneBlock<double> tile{LaneBlock<double>::Zero(kLanes<double>, kTileLength)};
+
+  for (Index t0{0}; t0 < nX; t0 += kTileLength) {
+    const Index len{std::min(kTileLength, nX - t0)};
+    tile.block(0, 0, lanes, len) = x.block(r0, t0, lanes, len);
+
+    for (Index i{0}; i < nSections; ++i) {
+      const Lanes b0{c.col(5 * i)};
+      const Lanes b1{c.col(5 * i + 1)};
+      const Lanes b2{c.col(5 * i + 2)};
+      const Lanes a1{c.col(5 * i + 3)};
+      const Lanes a2{c.col(5 * i + 4)};
+
+      Lanes s0{s.col(2 * i)};
+      Lanes s1{s.col(2 * i + 1)};
+      for (Index k{0}; k < len; ++k) {
+        const Lanes xk{tile.col(k)};
+        const Lanes yk{b0 * xk + s0};
+        s0          = b1 * xk - a1 * yk + s1;
+        s1          = b2 * xk - a2 * yk;
+        tile.col(k) = yk;
+      }
+
+      s.col(2 * i)     = s0;
+      s.col(2 * i + 1) = s1;
+    }
+
+    y.block(r0, t0, lanes, len) = tile.block(0, 0, lanes, len);
+  }
+
+  state.block(r0, 0, lanes, 2 * nSections) = s.topRows(lanes);
+}
+
+void sosFilterMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& sos,
+                           const Eigen::Ref<const RowMajorMatrixXd>& x,
+                           Eigen::Ref<RowMajorMatrixXd>              y,
+                           Eigen::Ref<RowMajorMatrixXd>              state) {
+  const Index nRows{x.rows()};
+
+  if (sos.rows() != nRows || sos.cols() % 6 != 0)
+    throw std::runtime_error("Sections must have one row per channel and six "
+                             "coefficients per section");
+
+  if (state.rows() != nRows || state.cols() < sos.cols() / 3)
+    throw std::runtime_error("SOS state must hold two values per section for "
+                             "every channel");
+
+  if (y.rows() != nRows || y.cols() != x.cols())
+    throw std::runtime_error("Output must have the same shape as the input");
+
+  constexpr Index lanes{kLanes<double>};
+  const Index     nBlocks{(nRows + lanes - 1) / lanes};
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index blk = 0; blk < nBlocks; ++blk) {
+    const Index r0{blk * lanes};
+    sosFilterLanes(sos, x, state, y, r0, std::min(lanes, nRows - r0));
+  }
+}
+
+RowMajorMatrixXd
+sosFilterMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& sos,
+                      const Eigen::Ref<const RowMajorMatrixXd>& x,
+                      Eigen::Ref<RowMajorMatrixXd>              state) {
+  RowMajorMatrixXd y(x.rows(), x.cols());
+  sosFilterMultichannel(sos, x, y, state);
+
+  return y;
+}
+
+// Highest filter order with a compile-time specialised kernel
+constexpr Index kMaxFixedOrder{8};
+
+template <int N, typename Sample, typename Scalar>
+static void linearFilterFixed(const Scalar* b, const Scalar* a,
+                              const Sample* x, Sample* y, const Index n,
+                              Scalar* state) {
+  FixedFilter<N + 1, N + 1, Scalar> filter{b, a};
+  filter.loadState(state);
+  filter.process(x, y, n);
+  filter.storeState(state);
+}
+
+// Filters n samples with b and a zero-padded to nS + 1 coefficients, running
+// the recurrence in Scalar precision. Orders up to kMaxFixedOrder run on a
+// kernel unrolled at compile time. x and y may alias.
+template <typename Sample, typename Scalar>
+static void linearFilterKernel(const Scalar* b, const Scalar* a,
+                               const Index nS, const Sample* x, Sample* y,
+                               const Index n, Scalar* state) {
+  switch (nS) {
+  case 0:
+    for (Index k{0}; k < n; ++k)
+      y[k] = static_cast<Sample>(b[0] * static_cast<Scalar>(x[k]));
+    return;
+  case 1: linearFilterFixed<1>(b, a, x, y, n, state); return;
+  case 2: linearFilterFixed<2>(b, a, x, y, n, state); return;
+  case 3: linearFilterFixed<3>(b, a, x, y, n, state); return;
+  case 4: linearFilterFixed<4>(b, a, x, y, n, state); return;
+  case 5: linearFilterFixed<5>(b, a, x, y, n, state); return;
+  case 6: linearFilterFixed<6>(b, a, x, y, n, state); return;
+  case 7: linearFilterFixed<7>(b, a, x, y, n, state); return;
+  case 8: linearFilterFixed<8>(b, a, x, y, n, state); return;
+  default: break;
+  }
+
+  const EigenMap<const ArrayX<Scalar>> bMap(b, nS + 1);
+  const EigenMap<const ArrayX<Scalar>> aMap(a, nS + 1);
+  EigenMap<ArrayX<Scalar>>             s(state, nS);
+
+  for (Index k{0}; k < n; ++k) {
+    const Scalar xk{static_cast<Scalar>(x[k])};
+    const Scalar yk{s(0) + b[0] * xk};
+
+    s.head(nS - 1) = s.tail(nS - 1) + bMap.segment(1, nS - 1) * xk -
+                     aMap.segment(1, nS - 1) * yk;
+    s(nS - 1) = b[nS] * xk - a[nS] * yk;
+
+    y[k] = static_cast<Sample>(yk);
+  }
+}
+
+// Calls kernel(b, a, nS) with the coefficients of the filter converted to
+// Scalar and zero-padded to nS + 1 values each. Orders with a fixed kernel are
+// padded on the stack.
+template <typename Scalar, typename Coefficients, typename Kernel>
+static void withPaddedCoeffs(const Coefficients& filter, Kernel&& kernel) {
+  const Index nB{filter.b.size()};
+  const Index nA{filter.a.size()};
+  const Index nS{std::max(nB, nA) - 1};
+
+  // Coefficients of the right type and length are used where they are
+  using Stored = typename std::decay_t<decltype(filter.b)>::Scalar;
+  if constexpr (std::is_same_v<Stored, Scalar>) {
+    if (nB == nA) {
+      kernel(filter.b.data(), filter.a.data(), nS);
+      return;
+    }
+  }
+
+  if (nS <= kMaxFixedOrder) {
+    std::array<Scalar, kMaxFixedOrder + 1> b{};
+    std::array<Scalar, kMaxFixedOrder + 1> a{};
+    EigenMap<ArrayX<Scalar>>(b.data(), nB) = filter.b.template cast<Scalar>();
+    EigenMap<ArrayX<Scalar>>(a.data(), nA) = filter.a.template cast<Scalar>();
+
+    kernel(b.data(), a.data(), nS);
+    return;
+  }
+
+  ArrayX<Scalar> b{ArrayX<Scalar>::Zero(nS + 1)};
+  ArrayX<Scalar> a{ArrayX<Scalar>::Zero(nS + 1)};
+  b.head(nB) = filter.b.template cast<Scalar>();
+  a.head(nA) = filter.a.template cast<Scalar>();
+
+  kernel(b.data(), a.data(), nS);
+}
+
+// Filters n samples of x into y (which may alias x), keeping the state (and
+// running the recurrence) in Scalar precision
+template <typename Sample, typename Scalar, typename Coefficients>
+static void linearFilterInto(const Coefficients& filter, const Sample* x,
+                             Sample* y, const Index n, Scalar* state) {
+  withPaddedCoeffs<Scalar>(
+      filter, [&](const Scalar* b, const Scalar* a, const Index order) {
+        linearFilterKernel(b, a, order, x, y, n, state);
+      });
+}
+
+// Checks the sizes of the output and state buffers of a linear filter
+template <typename Coefficients>
+static void checkBuffers(const Coefficients& filter, const Index nX,
+                         const Index nY, const Index nState) {
+  if (nY != nX)
+    throw std::runtime_error("Output must have the same length as the input");
+
+  if (nState < std::max(filter.b.size(), filter.a.size()) - 1)
+    throw std::runtime_error("Filter state must hold one value per delay");
+}
+
+template <typename Sample, typename Scalar, typename Coefficients>
+static ArrayX<Sample>
+linearFilterWithState(const Coefficients&                     filter,
+                      const Eigen::Ref<const ArrayX<Sample>>& x,
+                      Eigen::Ref<ArrayX<Scalar>>              state) {
+  checkBuffers(filter, x.size(), x.size(), state.size());
+
+  ArrayX<Sample> y(x.size());
+  linearFilterInto(filter, x.data(), y.data(), x.size(), state.data());
+
+  return y;
+}
+
+// Coefficients of a Coeffs mapped without copying
+struct CoeffsMap {
+  EigenMap<const ArrayXd> b;
+  EigenMap<const ArrayXd> a;
+
+  explicit CoeffsMap(const Coeffs& coeffs)
+      : b(coeffs.b.data(), static_cast<Index>(coeffs.b.size())),
+        a(coeffs.a.data(), static_cast<Index>(coeffs.a.size())) {}
+};
+
+void linearFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
+                  Eigen::Ref<ArrayXd> y, Eigen::Ref<ArrayXd> state) {
+  checkBuffers(filter, x.size(), y.size(), state.size());
+
+  linearFilterInto(filter, x.data(), y.data(), x.size(), state.data());
+}
+
+void linearFilter(const Coeffs& filter, std::span<const double> x,
+                  std::span<double> y, std::span<double> si) {
+  const CoeffsMap coeffs{filter};
+  checkBuffers(coeffs, static_cast<Index>(x.size()),
+               static_cast<Index>(y.size()), static_cast<Index>(si.size()));
+
+  linearFilterInto(coeffs, x.data(), y.data(), static_cast<Index>(x.size()),
+                   si.data());
+}
+
+ArrayXd linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXd>& x,
+                     Eigen::Ref<ArrayXd>              state) {
+  return linearFilterWithState<double, double>(filter, x, state);
+}
+
+ArrayXd linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXd>& x) {
+  const auto nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  ArrayXd    state{ArrayXd::Zero(nS)};
+
+  return linearFilter(filter, x, state);
+}
+
+ArrayXf linearFilter(const EigenCoeffsF&              filter,
+                     const Eigen::Ref<const ArrayXf>& x,
+                     Eigen::Ref<ArrayXf>              state) {
+  return linearFilterWithState<float, float>(filter, x, state);
+}
+
+ArrayXf linearFilter(const EigenCoeffsF&              filter,
+                     const Eigen::Ref<const ArrayXf>& x) {
+  ArrayXf state{ArrayXf::Zero(std::max(filter.b.size(), filter.a.size()) - 1)};
+
+  return linearFilter(filter, x, state);
+}
+
+ArrayXf linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXf>& x,
+                     Eigen::Ref<ArrayXd>              state) {
+  return linearFilterWithState<float, double>(filter, x, state);
+}
+
+ArrayXf linearFilter(const EigenCoeffs&               filter,
+                     const Eigen::Ref<const ArrayXf>& x) {
+  ArrayXd state{ArrayXd::Zero(std::max(filter.b.size(), filter.a.size()) - 1)};
+
+  return linearFilter(filter, x, state);
+}
+
+// State transition matrix of the transposed direct form II realisation of a
+// filter whose denominator has been padded to nS + 1 coefficients
+static Eigen::MatrixXd stateTransition(const ArrayXd& a) {
+  const Index     nS{a.size() - 1};
+  Eigen::MatrixXd A{Eigen::MatrixXd::Zero(nS, nS)};
+
+  A.col(0) = -a.tail(nS).matrix();
+  if (nS > 1)
+    A.topRightCorner(nS - 1, nS - 1).setIdentity();
+
+  return A;
+}
+
+// Computes base^n by repeated squaring
+static Eigen::MatrixXd matrixPower(Eigen::MatrixXd base, Index n) {
+  Eigen::MatrixXd result{Eigen::MatrixXd::Identity(base.rows(), base.cols())};
+
+  while (n > 0) {
+    if (n & 1)
+      result = result * base;
+    base = base * base;
+    n >>= 1;
+  }
+
+  return result;
+}
+
+// Adds the zero-input response of the filter started from state s to y,
+// stopping early once the state has decayed below rounding level
+static void addZeroInputResponse(const ArrayXd& a, ArrayXd s,
+                                 Eigen::Ref<ArrayXd> y) {
+  const Index  nS{s.size()};
+  const double threshold{std::numeric_limits<double>::epsilon() * 1e-2 *
+                         s.abs().maxCoeff()};
+
+  for (Index k{0}; k < y.size(); ++k) {
+    if (s.abs().maxCoeff() <= threshold)
+      break;
+
+    const double s0{s(0)};
+    y(k) += s0;
+
+    if (nS > 1)
+      s.head(nS - 1) = s.tail(nS - 1) - a.segment(1, nS - 1) * s0;
+    s(nS - 1) = -a(nS) * s0;
+  }
+}
+
+ArrayXd parallelLinearFilter(const EigenCoeffs&               filter,
+                             const Eigen::Ref<const ArrayXd>& x,
+                             Eigen::Ref<ArrayXd> state, Index blocks) {
+  const Index nX{x.size()};
+  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
+
+  if (state.size() < nS)
+    throw std::runtime_error("Filter state is too small");
+
+#ifdef _OPENMP
+  if (blocks <= 0)
+    blocks = omp_get_max_threads();
+#endif
+  blocks = std::clamp<Index>(blocks, 1, std::max<Index>(nX, 1));
+
+  if (blocks == 1 || nS == 0)
+    return linearFilter(filter, x, state);
+
+  // Zero-pad the shorter polynomial so both have nS + 1 coefficients
+  EigenCoeffs padded{ArrayXd::Zero(nS + 1), ArrayXd::Zero(nS + 1)};
+  padded.b.head(filter.b.size()) = filter.b;
+  padded.a.head(filter.a.size()) = filter.a;
+
+  const Index blockLength{(nX + blocks - 1) / blocks};
+  blocks = (nX + blockLength - 1) / blockLength;
+
+  // 1. Filter every block concurrently; the first one starts from the given
+  //    state, the others from rest. Keep each block's final state.
+  ArrayXd         y(nX);
+  Eigen::MatrixXd finalStates(nS, blocks);
+  finalStates.col(0) = state.head(nS).matrix();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index blk = 0; blk < blocks; ++blk) {
+    const Index start{blk * blockLength};
+    const Index len{std::min(blockLength, nX - start)};
+
+    ArrayXd si{blk == 0 ? ArrayXd{finalStates.col(0).array()}
+                        : ArrayXd::Zero(nS)};
+    y.segment(start, len) = linearFilter(padded, x.segment(start, len), si);
+    finalStates.col(blk)  = si.matrix();
+  }
+
+  // 2. Propagate the true initial state of every block across the boundaries:
+  //    s[blk + 1] = A^L s[blk] + (zero-state final state of block blk + 1)
+  const Eigen::MatrixXd A{stateTransition(padded.a)};
+  const Eigen::MatrixXd AL{matrixPower(A, blockLength)};
+
+  Eigen::MatrixXd initialStates(nS, blocks);
+  initialStates.col(0) = state.head(nS).matrix();
+  Eigen::VectorXd carry{finalStates.col(0)};
+  for (Index blk{1}; blk < blocks; ++blk) {
+    initialStates.col(blk) = carry;
+
+    const Index len{std::min(blockLength, nX - blk * blockLength)};
+    const Eigen::MatrixXd& transition{len == blockLength ? AL
+                                                         : matrixPower(A, len)};
+    carry = transition * carry + finalStates.col(blk);
+  }
+
+  // 3. Correct each block with the response to its initial state
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index blk = 1; blk < blocks; ++blk) {
+    const Index start{blk * blockLength};
+    const Index len{std::min(blockLength, nX - start)};
+
+    addZeroInputResponse(padded.a, initialStates.col(blk).array(),
+                         y.segment(start, len));
+  }
+
+  state.head(nS) = carry.array();
+
+  return y;
+}
+
+ArrayXd parallelLinearFilter(const EigenCoeffs&               filter,
+                             const Eigen::Ref<const ArrayXd>& x,
+                             const Index                      blocks) {
+  const auto nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  ArrayXd    state{ArrayXd::Zero(nS)};
+
+  return parallelLinearFilter(filter, x, state, blocks);
+}
+
+Signal parallelLinearFilter(const Coeffs& filter, const Signal& x,
+                            const std::size_t blocks) {
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  const EigenCoeffs eigenFilter{
+      EigenMap<const ArrayXd>(filter.b.data(),
+                              static_cast<Index>(filter.b.size())),
+      EigenMap<const ArrayXd>(filter.a.data(),
+                              static_cast<Index>(filter.a.size()))};
+
+  const ArrayXd yMap{
+      parallelLinearFilter(eigenFilter, xMap, static_cast<Index>(blocks))};
+  Signal y(static_cast<std::size_t>(yMap.size()));
+  EigenMap<ArrayXd>(y.data(), static_cast<Index>(y.size())) = yMap;
+
+  return y;
+}
+
+Signal linearFilter(const Coeffs& filter, const Signal& x, Signal& si) {
+  const std::size_t nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  if (si.size() < nS)
+    si.resize(nS, 0.0);
+
+  Signal y(x.size());
+  linearFilter(filter, x, y, si);
+
+  return y;
+}
+
+Signal linearFilter(const Coeffs& filter, const Signal& x) {
+  const auto nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  Signal     si(nS, 0.0);
+
+  return linearFilter(filter, x, si);
+}
+
+// Runs one second-order section in place over n samples (transposed direct
+// form II), updating its two state values
+static void biquadInPlace(const double* c, double* y, const Index n,
+                          double* s) {
+  const double a0{c[3]};
+  const double b0{c[0] / a0};
+  const double b1{c[1] / a0};
+  const double b2{c[2] / a0};
+  const double a1{c[4] / a0};
+  const double a2{c[5] / a0};
+
+  double s0{s[0]};
+  double s1{s[1]};
+  for (Index k{0}; k < n; ++k) {
+    const double xk{y[k]};
+    const double yk{b0 * xk + s0};
+    s0   = b1 * xk - a1 * yk + s1;
+    s1   = b2 * xk - a2 * yk;
+    y[k] = yk;
+  }
+
+  s[0] = s0;
+  s[1] = s1;
+}
+
+// Runs the sections over n samples of x into y (which may alias x)
+template <typename Sections>
+static void sosFilterInto(const Sections& sections, const Index nSections,
+                          const double* x, double* y, const Index n,
+                          const Index nState, double* state) {
+  if (nState < 2 * nSections)
+    throw std::runtime_error("SOS state must hold two values per section");
+
+  if (y != x)
+    std::copy_n(x, n, y);
+
+  for (Index i{0}; i < nSections; ++i) {
+    biquadInPlace(sections(i), y, n, state + 2 * i);
+  }
+}
+
+void sosFilter(const Eigen::Ref<const SosArray>& sos,
+               const Eigen::Ref<const ArrayXd>& x, Eigen::Ref<ArrayXd> y,
+               Eigen::Ref<ArrayXd> state) {
+  if (y.size() != x.size())
+    throw std::runtime_error("Output must have the same length as the input");
+
+  sosFilterInto([&](const Index i) { return sos.row(i).data(); }, sos.rows(),
+                x.data(), y.data(), x.size(), state.size(), state.data());
+}
+
+void sosFilter(const SOS& sos, std::span<const double> x, std::span<double> y,
+               std::span<double> si) {
+  if (y.size() != x.size())
+    throw std::runtime_error("Output must have the same length as the input");
+
+  const auto section = [&](const Index i) {
+    return sos[static_cast<std::size_t>(i)].data();
+  };
+  sosFilterInto(section, static_cast<Index>(sos.size()), x.data(), y.data(),
+                static_cast<Index>(x.size()), static_cast<Index>(si.size()),
+                si.data());
+}
+
+ArrayXd sosFilter(const Eigen::Ref<const SosArray>& sos,
+                  const Eigen::Ref<const ArrayXd>&  x,
+                  Eigen::Ref<ArrayXd>               state) {
+  ArrayXd y(x.size());
+  sosFilter(sos, x, y, state);
+
+  return y;
+}
+
+ArrayXd sosFilter(const Eigen::Ref<const SosArray>& sos,
+                  const Eigen::Ref<const ArrayXd>&  x) {
+  ArrayXd state{ArrayXd::Zero(2 * sos.rows())};
+
+  return sosFilter(sos, x, state);
+}
+
+Signal sosFilter(const SOS& sos, const Signal& x, Signal& si) {
+  Signal y(x.size());
+  sosFilter(sos, x, y, si);
+
+  return y;
+}
+
+Signal sosFilter(const SOS& sos, const Signal& x) {
+  Signal si(2 * sos.size(), 0.0);
+
+  return sosFilter(sos, x, si);
+}
+
+// Filters n samples of y in place, with b and a normalised and zero-padded to
+// nS + 1 coefficients
+static void linearFilterInPlace(const ArrayXd& b, const ArrayXd& a, double* y,
+                                const Index n, double* state) {
+  linearFilterKernel(b.data(), a.data(), b.size() - 1, y, y, n, state);
+}
+
+// Normalises a filter by a(0) and zero-pads b and a to the same length
+static EigenCoeffs normalizedFilter(const EigenCoeffs& filter) {
+  const Index nC{std::max(filter.b.size(), filter.a.size())};
+  EigenCoeffs padded{ArrayXd::Zero(nC), ArrayXd::Zero(nC)};
+  padded.b.head(filter.b.size()) = filter.b / filter.a(0);
+  padded.a.head(filter.a.size()) = filter.a / filter.a(0);
+
+  return padded;
+}
+
+ArrayXd linearFilterZi(const EigenCoeffs& filter) {
+  const EigenCoeffs padded{normalizedFilter(filter)};
+  const Index       nS{padded.b.size() - 1};
+
+  // The steady state zi of a unit step solves zi = A zi + b[1:] - a[1:] b[0]
+  const Eigen::MatrixXd IminusA{Eigen::MatrixXd::Identity(nS, nS) -
+                                stateTransition(padded.a)};
+  const Eigen::VectorXd B{
+      (padded.b.tail(nS) - padded.a.tail(nS) * padded.b(0)).matrix()};
+
+  return IminusA.partialPivLu().solve(B).array();
+}
+
+ArrayXd sosFilterZi(const Eigen::Ref<const SosArray>& sos) {
+  ArrayXd zi(2 * sos.rows());
+
+  // Each section starts from the steady state of the step it receives, whose
+  // height is the DC gain of the sections before it
+  double scale{1.0};
+  for (Index i{0}; i < sos.rows(); ++i) {
+    const ArrayXd b{sos.row(i).head<3>().transpose()};
+    const ArrayXd a{sos.row(i).tail<3>().transpose()};
+
+    zi.segment(2 * i, 2) = scale * linearFilterZi(EigenCoeffs{b, a});
+    scale *= b.sum() / a.sum();
+  }
+
+  return zi;
+}
+
+// Zero-phase filtering of n samples of x into y. The signal is extended by
+// padLength samples at both ends with its odd reflection about the end
+// samples, then filtered forwards and backwards (reversing the extended
+// buffer in place), each pass starting from the steady state zi scaled by its
+// first sample. pass(data, n, state) filters data in place.
+template <typename Pass>
+static void filtFiltInto(const ArrayXd& zi, const double* x, const Index n,
+                         const Index padLength, double* y, Pass&& pass) {
+  if (n == 0)
+    return;
+
+  const Index nExt{n + 2 * padLength};
+  ArrayXd     ext(nExt);
+  for (Index i{0}; i < padLength; ++i) {
+    ext(i)                 = 2.0 * x[0] - x[padLength - i];
+    ext(padLength + n + i) = 2.0 * x[n - 1] - x[n - 2 - i];
+  }
+  ext.segment(padLength, n) = EigenMap<const ArrayXd>(x, n);
+
+  ArrayXd state{zi * ext(0)};
+  pass(ext.data(), nExt, state.data());
+  ext.reverseInPlace();
+
+  state = zi * ext(0);
+  pass(ext.data(), nExt, state.data());
+  ext.reverseInPlace();
+
+  EigenMap<ArrayXd>(y, n) = ext.segment(padLength, n);
+}
+
+// Checks the padding length of filtFilt, with -1 selecting the default
+static Index filtFiltPadLength(const Index padLength,
+                               const Index defaultLength, const Index n) {
+  const Index pad{padLength < 0 ? defaultLength : padLength};
+  if (n > 0 && n <= pad)
+    throw std::runtime_error("Signal must be longer than the padding length");
+
+  return pad;
+}
+
+// Default padding of scipy: three times the number of coefficients
+static Index defaultPadLength(const EigenCoeffs& filter) {
+  return 3 * std::max(filter.b.size(), filter.a.size());
+}
+
+static Index defaultPadLength(const Eigen::Ref<const SosArray>& sos) {
+  return 3 * (2 * sos.rows() + 1);
+}
+
+ArrayXd filtFilt(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
+                 const Index padLength) {
+  const EigenCoeffs padded{normalizedFilter(filter)};
+  const ArrayXd     zi{linearFilterZi(padded)};
+  const Index pad{filtFiltPadLength(padLength, defaultPadLength(filter),
+                                    x.size())};
+
+  ArrayXd y(x.size());
+  filtFiltInto(zi, x.data(), x.size(), pad, y.data(),
+               [&](double* data, const Index n, double* state) {
+                 linearFilterInPlace(padded.b, padded.a, data, n, state);
+               });
+
+  return y;
+}
+
+ArrayXd filtFilt(const Eigen::Ref<const SosArray>& sos,
+                 const Eigen::Ref<const ArrayXd>&  x,
+                 const Index                       padLength) {
+  const ArrayXd zi{sosFilterZi(sos)};
+  const Index   pad{
+      filtFiltPadLength(padLength, defaultPadLength(sos), x.size())};
+
+  ArrayXd y(x.size());
+  filtFiltInto(zi, x.data(), x.size(), pad, y.data(),
+               [&](double* data, const Index n, double* state) {
+                 for (Index i{0}; i < sos.rows(); ++i)
+                   biquadInPlace(sos.row(i).data(), data, n, state + 2 * i);
+               });
+
+  return y;
+}
+
+RowMajorMatrixXd
+filtFiltMultichannel(const EigenCoeffs&                        filter,
+                     const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Index                               padLength) {
+  const EigenCoeffs padded{normalizedFilter(filter)};
+  const ArrayXd     zi{linearFilterZi(padded)};
+  const Index pad{filtFiltPadLength(padLength, defaultPadLength(filter),
+                                    x.cols())};
+
+  RowMajorMatrixXd y(x.rows(), x.cols());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index r = 0; r < x.rows(); ++r) {
+    filtFiltInto(zi, x.data() + r * x.outerStride(), x.cols(), pad, &y(r, 0),
+                 [&](double* data, const Index n, double* state) {
+                   linearFilterInPlace(padded.b, padded.a, data, n, state);
+                 });
+  }
+
+  return y;
+}
+
+RowMajorMatrixXd
+filtFiltMultichannel(const Eigen::Ref<const SosArray>&         sos,
+                     const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Index                               padLength) {
+  const ArrayXd zi{sosFilterZi(sos)};
+  const Index   pad{
+      filtFiltPadLength(padLength, defaultPadLength(sos), x.cols())};
+
+  RowMajorMatrixXd y(x.rows(), x.cols());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index r = 0; r < x.rows(); ++r) {
+    filtFiltInto(zi, x.data() + r * x.outerStride(), x.cols(), pad, &y(r, 0),
+                 [&](double* data, const Index n, double* state) {
+                   for (Index i{0}; i < sos.rows(); ++i)
+                     biquadInPlace(sos.row(i).data(), data, n, state + 2 * i);
+                 });
+  }
+
+  return y;
+}
+
+Signal filtFilt(const Coeffs& filter, const Signal& x, const int padLength) {
+  const EigenCoeffs eigenFilter{
+      EigenMap<const ArrayXd>(filter.b.data(),
+                              static_cast<Index>(filter.b.size())),
+      EigenMap<const ArrayXd>(filter.a.data(),
+                              static_cast<Index>(filter.a.size()))};
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  Eigen::Ref<const ArrayXd> xRef{xMap};
+  const ArrayXd             yMap{filtFilt(eigenFilter, xRef, padLength)};
+
+  return Signal(yMap.data(), yMap.data() + yMap.size());
+}
+
+Signal filtFilt(const SOS& sos, const Signal& x, const int padLength) {
+  SosArray sosMap(static_cast<Index>(sos.size()), 6);
+  for (std::size_t i{0}; i < sos.size(); ++i) {
+    sosMap.row(static_cast<Index>(i)) =
+        EigenMap<const Eigen::Array<double, 1, 6>>(sos[i].data());
+  }
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  Eigen::Ref<const ArrayXd> xRef{xMap};
+  const ArrayXd             yMap{filtFilt(sosMap, xRef, padLength)};
+
+  return Signal(yMap.data(), yMap.data() + yMap.size());
+}
+
+// Number of samples for the response of a pole of the given radius to decay
+// below epsilon. The margin covers the gain of the response and the
+// polynomial growth of repeated poles, so the estimate rarely needs extending.
+static Index decayLength(const double radius, const Index order,
+                         const double epsilon, const Index maxLength) {
+  if (radius >= 1.0)
+    return maxLength;
+
+  double n{static_cast<double>(order + 1)};
+  if (radius > 0.0 && epsilon < 1.0)
+    n += 1.5 * std::log(epsilon) / std::log(radius) +
+         4.0 * static_cast<double>(order);
+
+  return std::min(static_cast<Index>(
+                      std::ceil(std::min(n, static_cast<double>(maxLength)))),
+                  maxLength);
+}
+
+Index estimateIRLength(const EigenZPK& filter, const double epsilon,
+                       const Index maxLength) {
+  const double radius{filter.p.size() > 0 ? filter.p.abs().maxCoeff() : 0.0};
+  const Index  order{std::max(filter.z.size(), filter.p.size())};
+
+  return decayLength(radius, order, epsilon, maxLength);
+}
+
+Index estimateIRLength(const EigenCoeffs& filter, const double epsilon,
+                       const Index maxLength) {
+  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
+
+  // Drop trailing zero coefficients, which only add poles at the origin
+  Index nA{filter.a.size()};
+  while (nA > 1 && filter.a(nA - 1) == 0.0)
+    --nA;
+
+  double radius{0.0};
+  if (nA > 1) {
+    const ArrayXd a{filter.a.head(nA) / filter.a(0)};
+    radius = Eigen::EigenSolver<Eigen::MatrixXd>(stateTransition(a), false)
+                 .eigenvalues()
+                 .cwiseAbs()
+                 .maxCoeff();
+  }
+
+  return decayLength(radius, nS, epsilon, maxLength);
+}
+
+ArrayXd findEffectiveIR(const EigenCoeffs& filter, const double epsilon,
+                        const Index maxLength) {
+  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  ArrayXd     si{ArrayXd::Zero(nS)};
+  Eigen::Ref<ArrayXd> siRef{si};
+
+  // Simulate only as many samples as the dominant pole needs to decay
+  ArrayXd impulse{ArrayXd::Zero(estimateIRLength(filter, epsilon, maxLength))};
+  if (impulse.size() > 0)
+    impulse(0) = 1.0;
+  Eigen::Ref<const ArrayXd> impulseRef{impulse};
+  ArrayXd                   ir{linearFilter(filter, impulseRef, siRef)};
+
+  // Extend the response while its last quarter still exceeds epsilon
+  while (ir.size() > 0 && ir.size() < maxLength &&
+         (ir.tail(std::max<Index>(ir.size() / 4, 1)).abs() >= epsilon).any()) {
+    const Index               extra{std::min(ir.size(), maxLength - ir.size())};
+    const ArrayXd             zeros{ArrayXd::Zero(extra)};
+    Eigen::Ref<const ArrayXd> zerosRef{zeros};
+
+    ir.conservativeResize(ir.size() + extra);
+    ir.tail(extra) = linearFilter(filter, zerosRef, siRef);
+  }
+
+  // find effective length
+  Index irLength{std::min<Index>(ir.size(), 1)};
+  for (auto i{ir.size() - 1}; i > 0; --i) {
+    if (std::abs(ir(i)) >= epsilon) {
+      irLength = i + 1;
+      break;
+    }
+  }
+
+  return ir.head(irLength);
+}
+
+Signal findEffectiveIR(const Coeffs& filter, const double epsilon,
+                       const std::size_t maxLength) {
+  const EigenCoeffs eigenFilter{
+      EigenMap<const ArrayXd>(filter.b.data(),
+                              static_cast<Index>(filter.b.size())),
+      EigenMap<const ArrayXd>(filter.a.data(),
+                              static_cast<Index>(filter.a.size()))};
+
+  const ArrayXd irMap{
+      findEffectiveIR(eigenFilter, epsilon, static_cast<Index>(maxLength))};
+
+  return Signal(irMap.data(), irMap.data() + irMap.size());
+}
+
+ArrayXd fastConvolve(const Eigen::Ref<const ArrayXd>& f,
+                     const Eigen::Ref<const ArrayXd>& g) {
+  const Index N{f.size() + g.size() - 1};
+  if (f.size() == 0 || g.size() == 0)
+    return ArrayXd{};
+
+  // Find the next power of 2 for FFT efficiency
+  Index N_fft{1};
+  while (N_fft < N)
+    N_fft <<= 1;
+
+  // Real-input transforms, zero-padded to N_fft
+  VectorXcd F, G;
+  Utils::rfft(f.matrix(), F, N_fft);
+  Utils::rfft(g.matrix(), G, N_fft);
+  F.array() *= G.array();
+
+  VectorXd yPad;
+  Utils::irfft(F, yPad, N_fft);
+
+  return yPad.head(N);
+}
 
 ArrayXd fastConvolve(const Signal& f, const Eigen::Ref<const ArrayXd>& g) {
   const EigenMap<const ArrayXd> fMap(f.data(), static_cast<Index>(f.size()));
@@ -643,21 +2027,45 @@ Signal fastConvolve(const Signal& f, const Signal& g) {
 
 ArrayXd fftFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXd>& x,
                   const double epsilon, const Index maxLength) {
-  const ArrayXd filterIR{findEffectiveIR(filter, epsilon, maxLength)};
+  FftConvolver convolver{filter, epsilon, maxLength};
 
-  return fastConvolve(filterIR, x).head(x.size());
+  return convolver.process(x);
 }
 
-Signal fftFilter(const Coeffs& filter, const Signal& x, const double epsilon,
-                 const std::size_t maxLength) {
-  const Signal filterIR{findEffectiveIR(filter, epsilon, maxLength)};
+ArrayXf fftFilter(const EigenCoeffs& filter, const Eigen::Ref<const ArrayXf>& x,
+                  const double epsilon, const Index maxLength) {
+  FftConvolver convolver{filter, epsilon, maxLength};
 
-  auto y{fastConvolve(filterIR, x)};
+  ArrayXf     y(x.size());
+  const Index hop{convolver.blockLength()};
+  ArrayXd     block(hop);
+  for (Index start{0}; start < x.size(); start += hop) {
+    const Index len{std::min(hop, x.size() - start)};
 
-  if (y.size() > x.size())
-    y.resize(x.size());
+    block.head(len) = x.segment(start, len).cast<double>();
+    convolver.process(block.head(len), block.head(len));
+    y.segment(start, len) = block.head(len).cast<float>();
+  }
 
   return y;
 }
+
+ArrayXf fftFilter(const EigenCoeffsF&              filter,
+                  const Eigen::Ref<const ArrayXf>& x, const double epsilon,
+                  const Index maxLength) {
+  return fftFilter(EigenCoeffs{filter}, x, epsilon, maxLength);
+}
+
+Signal fftFilter(const Coeffs& filter, const Signal& x, const double epsilon,
+                 const std::size_t maxLength) {
+  const EigenCoeffs eigenFilter{
+      EigenMap<const ArrayXd>(filter.b.data(),
+                              static_cast<Index>(filter.b.size())),
+      EigenMap<const ArrayXd>(filter.a.data(),
+                              static_cast<Index>(filter.a.size()))};
+  FftConvolver convolver{eigenFilter, epsilon, static_cast<Index>(maxLength)};
+
+  return convolver.process(x);
+}
 } // namespace Filter
 } // namespace Nodex
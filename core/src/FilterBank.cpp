@@ -0,0 +1,220 @@
+#include "FilterBank.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+// Samples per block of the fused pass: the input block and the output block
+// of one group of bands (kLanes x kBankBlock doubles) stay in L1 cache while
+// every group runs over the input
+constexpr Index kBankBlock{256};
+
+FilterBank::FilterBank(const std::vector<SosArray>& bands) {
+  Index stages{1};
+  for (const auto& sos : bands)
+    stages = std::max(stages, sos.rows());
+
+  init(static_cast<Index>(bands.size()), stages, 2);
+
+  for (Index band{0}; band < m_bands; ++band) {
+    const SosArray& sos{bands[static_cast<std::size_t>(band)]};
+    Lanes&          c{m_coeffs[static_cast<std::size_t>(band / kLanes)]};
+    const Index     lane{band % kLanes};
+
+    for (Index s{0}; s < sos.rows(); ++s) {
+      // b0, b1, b2, a1, a2 of the section, normalised by a0
+      const Index col{s * 5};
+      c.row(lane).segment(col, 3)     = sos.row(s).head(3) / sos(s, 3);
+      c.row(lane).segment(col + 3, 2) = sos.row(s).tail(2) / sos(s, 3);
+    }
+  }
+}
+
+FilterBank::FilterBank(const std::vector<EigenCoeffs>& bands) {
+  Index order{0};
+  for (const auto& tf : bands)
+    order = std::max(order, std::max(tf.b.size(), tf.a.size()) - 1);
+
+  init(static_cast<Index>(bands.size()), 1, order);
+
+  for (Index band{0}; band < m_bands; ++band) {
+    const EigenCoeffs& tf{bands[static_cast<std::size_t>(band)]};
+    Lanes&             c{m_coeffs[static_cast<std::size_t>(band / kLanes)]};
+    const Index        lane{band % kLanes};
+
+    // b0..bN then a1..aN, zero-padded to the order of the bank
+    c.row(lane).head(order + 1).setZero();
+    c.row(lane).head(tf.b.size()) = tf.b.transpose() / tf.a(0);
+    if (tf.a.size() > 1) {
+      c.row(lane).segment(order + 1, tf.a.size() - 1) =
+          tf.a.tail(tf.a.size() - 1).transpose() / tf.a(0);
+    }
+  }
+}
+
+void FilterBank::init(const Index bands, const Index stages,
+                      const Index order) {
+  if (bands < 1)
+    throw std::runtime_error("Filter bank needs at least one band");
+
+  m_bands  = bands;
+  m_stages = stages;
+  m_order  = order;
+
+  const Index groups{(bands + kLanes - 1) / kLanes};
+  const Index width{2 * order + 1};
+
+  // Unused lanes and padding stages pass their input through
+  Lanes passThrough{Lanes::Zero(kLanes, stages * width)};
+  for (Index s{0}; s < stages; ++s)
+    passThrough.col(s * width).setOnes();
+
+  m_coeffs.assign(static_cast<std::size_t>(groups), passThrough);
+  m_state.assign(static_cast<std::size_t>(groups),
+                 Lanes::Zero(kLanes, stages * order));
+  m_block.assign(static_cast<std::size_t>(groups),
+                 Lanes::Zero(kLanes, kBankBlock));
+}
+
+void FilterBank::reset() {
+  for (auto& state : m_state)
+    state.setZero();
+}
+
+// Runs one group of bands over a block of input, leaving the output in
+// m_block. Each stage runs over the whole block in place (transposed direct
+// form II, all lanes at once); with a fixed order its coefficients and state
+// stay in registers.
+template <int FixedOrder>
+void FilterBank::runGroup(const Index group, const double* x,
+                          const Index length) {
+  using LaneArray = Eigen::Array<double, kLanes, 1>;
+
+  const Index N{FixedOrder > 0 ? FixedOrder : m_order};
+  const Index width{2 * N + 1};
+
+  const Lanes& c{m_coeffs[static_cast<std::size_t>(group)]};
+  Lanes&       s{m_state[static_cast<std::size_t>(group)]};
+  Lanes&       out{m_block[static_cast<std::size_t>(group)]};
+
+  for (Index k{0}; k < length; ++k)
+    out.col(k).setConstant(x[k]);
+
+  for (Index stage{0}; stage < m_stages; ++stage) {
+    const Index c0{stage * width};
+    const Index s0{stage * N};
+
+    if constexpr (FixedOrder > 0) {
+      constexpr int kWidth{2 * FixedOrder + 1};
+
+      const Eigen::Array<double, kLanes, kWidth> cs{
+          c.template middleCols<kWidth>(c0)};
+      Eigen::Array<double, kLanes, FixedOrder> z{
+          s.template middleCols<FixedOrder>(s0)};
+
+      for (Index k{0}; k < length; ++k) {
+        const LaneArray xk{out.col(k)};
+        const LaneArray yk{cs.col(0) * xk + z.col(0)};
+
+        for (int j{0}; j < FixedOrder - 1; ++j) {
+          z.col(j) = z.col(j + 1) + cs.col(j + 1) * xk -
+                     cs.col(FixedOrder + 1 + j) * yk;
+        }
+        z.col(FixedOrder - 1) =
+            cs.col(FixedOrder) * xk - cs.col(2 * FixedOrder) * yk;
+
+        out.col(k) = yk;
+      }
+
+      s.template middleCols<FixedOrder>(s0) = z;
+    } else {
+      for (Index k{0}; k < length; ++k) {
+        const LaneArray xk{out.col(k)};
+        const LaneArray yk{c.col(c0) * xk + s.col(s0)};
+
+        for (Index j{0}; j < N - 1; ++j) {
+          s.col(s0 + j) = s.col(s0 + j + 1) + c.col(c0 + j + 1) * xk -
+                          c.col(c0 + N + 1 + j) * yk;
+        }
+        s.col(s0 + N - 1) = c.col(c0 + N) * xk - c.col(c0 + 2 * N) * yk;
+
+        out.col(k) = yk;
+      }
+    }
+  }
+}
+
+void FilterBank::runGroup(const Index group, const double* x,
+                          const Index length) {
+  switch (m_order) {
+  case 1: runGroup<1>(group, x, length); return;
+  case 2: runGroup<2>(group, x, length); return;
+  case 3: runGroup<3>(group, x, length); return;
+  case 4: runGroup<4>(group, x, length); return;
+  case 5: runGroup<5>(group, x, length); return;
+  case 6: runGroup<6>(group, x, length); return;
+  case 7: runGroup<7>(group, x, length); return;
+  case 8: runGroup<8>(group, x, length); return;
+  default: runGroup<0>(group, x, length); return;
+  }
+}
+
+void FilterBank::process(const Eigen::Ref<const ArrayXd>& x,
+                         Eigen::Ref<RowMajorMatrixXd>     y) {
+  if (y.rows() != m_bands || y.cols() != x.size())
+    throw std::runtime_error("Output must have one row per band and as many "
+                             "columns as the input");
+
+  // Pure gains: one coefficient per band
+  if (m_order == 0) {
+    for (Index band{0}; band < m_bands; ++band) {
+      y.row(band) =
+          m_coeffs[static_cast<std::size_t>(band / kLanes)](band % kLanes, 0) *
+          x.transpose().matrix();
+    }
+    return;
+  }
+
+  const Index groups{static_cast<Index>(m_coeffs.size())};
+
+  // Every thread keeps the same groups for every block (static schedule over
+  // the same iteration count), so the group state needs no synchronisation
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  for (Index start = 0; start < x.size(); start += kBankBlock) {
+    const Index len{std::min(kBankBlock, x.size() - start)};
+
+#ifdef _OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+    for (Index g = 0; g < groups; ++g) {
+      runGroup(g, x.data() + start, len);
+
+      const Index rows{std::min(kLanes, m_bands - g * kLanes)};
+      y.block(g * kLanes, start, rows, len) =
+          m_block[static_cast<std::size_t>(g)].topLeftCorner(rows, len);
+    }
+  }
+}
+
+RowMajorMatrixXd FilterBank::process(const Eigen::Ref<const ArrayXd>& x) {
+  RowMajorMatrixXd y(m_bands, x.size());
+  process(x, y);
+
+  return y;
+}
+
+RowMajorMatrixXd filterBank(const std::vector<SosArray>&     bands,
+                            const Eigen::Ref<const ArrayXd>& x) {
+  FilterBank bank{bands};
+
+  return bank.process(x);
+}
+
+RowMajorMatrixXd filterBank(const std::vector<EigenCoeffs>&  bands,
+                            const Eigen::Ref<const ArrayXd>& x) {
+  FilterBank bank{bands};
+
+  return bank.process(x);
+}
+} // namespace Nodex::Filter
@@ -0,0 +1,244 @@
+#include "FilterDispatch.h"
+#include "Convolution.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace Nodex::Filter {
+template <typename T>
+using EigenMap = Eigen::Map<T>;
+
+// Measurements taken by the calibration: the best of a few runs discards the
+// ones slowed down by page faults or preemption
+constexpr int kCalibrationRuns{3};
+
+// Orders of the calibration filters for linearFilter, either side of the
+// fixed-order kernels, and the sizes of the other calibration filters
+constexpr Index kCalibrationLowOrder{2};
+constexpr Index kCalibrationHighOrder{16};
+constexpr Index kCalibrationSections{4};
+constexpr Index kCalibrationIRLength{256};
+
+static std::mutex& costModelMutex() {
+  static std::mutex mutex{};
+  return mutex;
+}
+
+static FilterCostModel& globalCostModel() {
+  static FilterCostModel model{};
+  return model;
+}
+
+FilterCostModel filterCostModel() {
+  const std::lock_guard lock{costModelMutex()};
+  return globalCostModel();
+}
+
+void setFilterCostModel(const FilterCostModel& model) {
+  const std::lock_guard lock{costModelMutex()};
+  globalCostModel() = model;
+}
+
+// FilterCostModel implementation
+double FilterCostModel::timeDomainCost(const EigenCoeffs& filter,
+                                       const Index        length) const {
+  const Index states{std::max(filter.b.size(), filter.a.size()) - 1};
+
+  return static_cast<double>(length) *
+         (sampleCost + stateCost * static_cast<double>(states));
+}
+
+double FilterCostModel::sosCost(const Index sections,
+                                const Index length) const {
+  return static_cast<double>(length) * sectionCost *
+         static_cast<double>(sections);
+}
+
+// Cost of one n-point frame of overlap-save (forward and inverse transforms
+// and the spectral product), in units of n log2 n
+static double frameUnits(const Index fftSize) {
+  const double n{static_cast<double>(fftSize)};
+  return n * std::log2(n);
+}
+
+double FilterCostModel::convolutionCost(const Index irLength,
+                                        const Index length) const {
+  const Index fftSize{overlapSaveFftSize(irLength)};
+  const Index hop{fftSize - std::max<Index>(irLength, 1) + 1};
+  const Index frames{(length + hop - 1) / hop};
+
+  // The transform of the impulse response costs about half a frame
+  return fftCost * frameUnits(fftSize) * (static_cast<double>(frames) + 0.5);
+}
+
+// Cheapest overlap-save cost per sample, reached by the shortest responses
+static double minConvolutionCost(const FilterCostModel& model,
+                                 const Index            length) {
+  const Index fftSize{overlapSaveFftSize(1)};
+
+  return model.fftCost * frameUnits(fftSize) * static_cast<double>(length) /
+         static_cast<double>(fftSize);
+}
+
+// Picks the cheaper strategy once the recursion cost is known; estimateLength
+// is only called when the convolution could win
+template <typename EstimateLength>
+static FilterPlan choose(const double timeCost, const Index length,
+                         const Index maxLength, const FilterCostModel& model,
+                         EstimateLength estimateLength) {
+  FilterPlan plan{timeDomain, 0, timeCost, 0.0};
+  if (length == 0 || timeCost <= minConvolutionCost(model, length))
+    return plan;
+
+  plan.irLength = estimateLength();
+  plan.fftCost  = model.convolutionCost(plan.irLength, length);
+
+  // A response that has not decayed by maxLength would be truncated
+  if (plan.irLength < maxLength && plan.fftCost < timeCost)
+    plan.strategy = fftConvolution;
+
+  return plan;
+}
+
+FilterPlan planFilter(const EigenCoeffs& filter, const Index length,
+                      const double epsilon, const Index maxLength,
+                      const FilterCostModel& model) {
+  return choose(model.timeDomainCost(filter, length), length, maxLength, model,
+                [&]() { return estimateIRLength(filter, epsilon, maxLength); });
+}
+
+// Poles of every section: the roots of a0 z^2 + a1 z + a2
+static ArrayXcd sosPoles(const Eigen::Ref<const SosArray>& sos) {
+  ArrayXcd poles(2 * sos.rows());
+  for (Index s{0}; s < sos.rows(); ++s) {
+    const double  a1{sos(s, 4) / sos(s, 3)};
+    const double  a2{sos(s, 5) / sos(s, 3)};
+    const Complex root{std::sqrt(Complex{a1 * a1 - 4.0 * a2, 0.0})};
+
+    poles(2 * s)     = 0.5 * (-a1 + root);
+    poles(2 * s + 1) = 0.5 * (-a1 - root);
+  }
+
+  return poles;
+}
+
+FilterPlan planFilter(const Eigen::Ref<const SosArray>& sos, const Index length,
+                      const double epsilon, const Index maxLength,
+                      const FilterCostModel& model) {
+  return choose(model.sosCost(sos.rows(), length), length, maxLength, model,
+                [&]() {
+                  const EigenZPK poles{ArrayXcd{}, sosPoles(sos), 1.0};
+                  return estimateIRLength(poles, epsilon, maxLength);
+                });
+}
+
+ArrayXd filter(const EigenCoeffs& coeffs, const Eigen::Ref<const ArrayXd>& x,
+               const double epsilon, const Index maxLength) {
+  const FilterPlan plan{planFilter(coeffs, x.size(), epsilon, maxLength)};
+
+  if (plan.strategy == fftConvolution)
+    return fftFilter(coeffs, x, epsilon, maxLength);
+
+  return linearFilter(coeffs, x);
+}
+
+ArrayXd filter(const Eigen::Ref<const SosArray>& sos,
+               const Eigen::Ref<const ArrayXd>& x, const double epsilon,
+               const Index maxLength) {
+  const FilterPlan plan{planFilter(sos, x.size(), epsilon, maxLength)};
+
+  if (plan.strategy == timeDomain)
+    return sosFilter(sos, x);
+
+  // Impulse response of the cascade over the estimated length, without the
+  // tail below epsilon
+  ArrayXd impulse{ArrayXd::Zero(plan.irLength)};
+  impulse(0) = 1.0;
+  const ArrayXd ir{sosFilter(sos, impulse)};
+
+  Index irLength{ir.size()};
+  while (irLength > 1 && std::abs(ir(irLength - 1)) < epsilon)
+    --irLength;
+
+  FftConvolver convolver{ir.head(irLength)};
+
+  return convolver.process(x);
+}
+
+Signal filter(const Coeffs& coeffs, const Signal& x, const double epsilon,
+              const Index maxLength) {
+  const EigenCoeffs eigenFilter{
+      EigenMap<const ArrayXd>(coeffs.b.data(),
+                              static_cast<Index>(coeffs.b.size())),
+      EigenMap<const ArrayXd>(coeffs.a.data(),
+                              static_cast<Index>(coeffs.a.size()))};
+  const EigenMap<const ArrayXd> xMap{x.data(), static_cast<Index>(x.size())};
+
+  const ArrayXd y{filter(eigenFilter, xMap, epsilon, maxLength)};
+
+  return Signal(y.begin(), y.end());
+}
+
+// Best time of a few runs of f, in nanoseconds
+template <typename Function>
+static double measure(Function f) {
+  double best{std::numeric_limits<double>::infinity()};
+  for (int run{0}; run < kCalibrationRuns; ++run) {
+    const auto start{std::chrono::steady_clock::now()};
+    f();
+    const std::chrono::duration<double, std::nano> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = std::min(best, elapsed.count());
+  }
+
+  return best;
+}
+
+// Stable filter with the given order: a cascade of poles at radius 0.5
+static EigenCoeffs calibrationFilter(const Index order) {
+  return zpk2tf(EigenZPK{ArrayXcd::Zero(order), ArrayXcd::Constant(order, 0.5),
+                         1.0});
+}
+
+FilterCostModel calibrateFilterCostModel(const Index length) {
+  const ArrayXd   x{ArrayXd::Random(std::max<Index>(length, 1))};
+  const double    samples{static_cast<double>(x.size())};
+  FilterCostModel model{};
+
+  // Both orders time the recursion; the slope is the cost per state
+  const EigenCoeffs low{calibrationFilter(kCalibrationLowOrder)};
+  const EigenCoeffs high{calibrationFilter(kCalibrationHighOrder)};
+  const double lowCost{measure([&]() { linearFilter(low, x); }) / samples};
+  const double highCost{measure([&]() { linearFilter(high, x); }) / samples};
+
+  model.stateCost = std::max(highCost - lowCost, 0.0) /
+                    static_cast<double>(kCalibrationHighOrder -
+                                        kCalibrationLowOrder);
+  model.sampleCost =
+      std::max(lowCost - model.stateCost *
+                             static_cast<double>(kCalibrationLowOrder),
+               0.0);
+
+  SosArray sos(kCalibrationSections, 6);
+  sos.rowwise() = Eigen::Array<double, 1, 6>{1.0, 0.0, 0.0, 1.0, -0.5, 0.1};
+  model.sectionCost = measure([&]() { sosFilter(sos, x); }) / samples /
+                      static_cast<double>(kCalibrationSections);
+
+  const ArrayXd ir{ArrayXd::Random(kCalibrationIRLength)};
+  const double  convolutionCost{measure([&]() {
+    FftConvolver convolver{ir};
+    convolver.process(x);
+  })};
+
+  // With a unit cost, the prediction is the number of work units
+  model.fftCost = 1.0;
+  model.fftCost =
+      convolutionCost / model.convolutionCost(kCalibrationIRLength, x.size());
+
+  setFilterCostModel(model);
+
+  return model;
+}
+} // namespace Nodex::Filter
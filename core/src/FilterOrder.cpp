@@ -0,0 +1,289 @@
+#include "FilterOrder.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+// Band edges prewarped for the bilinear transform, lower edge first
+struct Edges {
+  std::array<double, 2> pass{};
+  std::array<double, 2> stop{};
+};
+
+static bool isBand(const Mode mode) {
+  return mode == bandpass || mode == bandstop;
+}
+
+static Edges prewarp(const FilterSpec& spec) {
+  const double nyquist{spec.fs / 2};
+  const bool   band{isBand(spec.mode)};
+
+  const auto edgesOrdered{[&]() {
+    switch (spec.mode) {
+    case lowpass:
+      return spec.passFreq < spec.stopFreq;
+    case highpass:
+      return spec.stopFreq < spec.passFreq;
+    case bandpass:
+      return spec.stopFreq < spec.passFreq && spec.passFreq < spec.passFreq2 &&
+             spec.passFreq2 < spec.stopFreq2;
+    default:
+      return spec.passFreq < spec.stopFreq && spec.stopFreq < spec.stopFreq2 &&
+             spec.stopFreq2 < spec.passFreq2;
+    }
+  }};
+
+  const double lowest{spec.mode == bandpass || spec.mode == highpass
+                          ? spec.stopFreq
+                          : spec.passFreq};
+  const double highest{band ? std::max(spec.passFreq2, spec.stopFreq2)
+                            : std::max(spec.passFreq, spec.stopFreq)};
+  if (!edgesOrdered() || lowest <= 0 || highest >= nyquist)
+    throw std::runtime_error("Band edges must be ordered as the mode implies "
+                             "and lie between 0 and fs / 2");
+
+  if (spec.passRipple <= 0 || spec.stopAttenuation <= spec.passRipple)
+    throw std::runtime_error("The stopband attenuation must exceed the "
+                             "passband ripple");
+
+  const auto warp{[&](const double f) {
+    return std::tan(std::numbers::pi * f / spec.fs);
+  }};
+
+  Edges edges{};
+  edges.pass = {warp(spec.passFreq), warp(band ? spec.passFreq2 : 0.0)};
+  edges.stop = {warp(spec.stopFreq), warp(band ? spec.stopFreq2 : 0.0)};
+
+  return edges;
+}
+
+// Ratio of stopband to passband edge of the equivalent analogue lowpass
+static double selectivity(const Mode mode, const Edges& edges) {
+  const auto& [p0, p1]{edges.pass};
+
+  switch (mode) {
+  case lowpass:
+    return edges.stop[0] / p0;
+  case highpass:
+    return p0 / edges.stop[0];
+  case bandpass: {
+    const auto nat{[&](const double s) {
+      return std::abs((s * s - p0 * p1) / (s * (p0 - p1)));
+    }};
+    return std::min(nat(edges.stop[0]), nat(edges.stop[1]));
+  }
+  default: {
+    const auto nat{[&](const double s) {
+      return std::abs(s * (p0 - p1) / (s * s - p0 * p1));
+    }};
+    return std::min(nat(edges.stop[0]), nat(edges.stop[1]));
+  }
+  }
+}
+
+// Order a family needs for the selectivity, before rounding up
+static double fractionalOrder(const Type type, const double nat,
+                              const FilterSpec& spec) {
+  const double gpass{std::pow(10, 0.1 * spec.passRipple)};
+  const double gstop{std::pow(10, 0.1 * spec.stopAttenuation)};
+
+  switch (type) {
+  case butter:
+    return std::log10((gstop - 1) / (gpass - 1)) / (2 * std::log10(nat));
+  case ellip: {
+    const double m0{1 / (nat * nat)};
+    const double m1{(gpass - 1) / (gstop - 1)};
+    return ellipk(m0) * ellipkm1(m1) / (ellipkm1(m0) * ellipk(m1));
+  }
+  default:
+    return std::acosh(std::sqrt((gstop - 1) / (gpass - 1))) / std::acosh(nat);
+  }
+}
+
+// Minimum of f on [a, b] by golden-section search
+template <typename F>
+static double minimize(F&& f, double a, double b) {
+  constexpr double tolerance{1e-5};
+  const double     ratio{(std::sqrt(5.0) - 1) / 2};
+
+  double x1{b - ratio * (b - a)};
+  double x2{a + ratio * (b - a)};
+  double f1{f(x1)};
+  double f2{f(x2)};
+  while (b - a > tolerance) {
+    if (f1 < f2) {
+      b  = x2;
+      x2 = x1;
+      f2 = f1;
+      x1 = b - ratio * (b - a);
+      f1 = f(x1);
+    } else {
+      a  = x1;
+      x1 = x2;
+      f1 = f2;
+      x2 = a + ratio * (b - a);
+      f2 = f(x2);
+    }
+  }
+
+  return (a + b) / 2;
+}
+
+// Prewarped edges and rounded-up order of a family. A bandstop passband is
+// first narrowed as far as it lowers the order, since the transform cannot
+// meet both of its edges exactly.
+static std::pair<Edges, int> minimumOrder(const Type        type,
+                                          const FilterSpec& spec) {
+  Edges edges{prewarp(spec)};
+
+  if (spec.mode == bandstop) {
+    const auto orderWith{[&](const std::size_t i) {
+      return [&, i](const double edge) {
+        Edges moved{edges};
+        moved.pass[i] = edge;
+        return fractionalOrder(type, selectivity(spec.mode, moved), spec);
+      };
+    }};
+
+    edges.pass[0] =
+        minimize(orderWith(0), edges.pass[0], edges.stop[0] - 1e-12);
+    edges.pass[1] =
+        minimize(orderWith(1), edges.stop[1] + 1e-12, edges.pass[1]);
+  }
+
+  const double order{
+      fractionalOrder(type, selectivity(spec.mode, edges), spec)};
+
+  return {edges, std::max(1, static_cast<int>(std::ceil(order)))};
+}
+
+// Unwarps analogue frequencies back to the units of fs. iirFilter prewarps
+// the centre sqrt(fc fc2) and the width fc2 - fc of a band rather than its
+// edges, so band edges are unwarped to the centre and width that transform
+// back to them.
+static OrderEstimate estimate(const int order, const double w0,
+                              const double w1, const FilterSpec& spec) {
+  const auto unwarp{[&](const double w) {
+    return std::atan(w) * spec.fs / std::numbers::pi;
+  }};
+
+  if (!isBand(spec.mode))
+    return {order, unwarp(w0), 0.0};
+
+  const double centre{unwarp(std::sqrt(w0 * w1))};
+  const double width{unwarp(w1 - w0)};
+  const double low{(std::sqrt(width * width + 4 * centre * centre) - width) /
+                   2};
+
+  return {order, low, low + width};
+}
+
+OrderEstimate buttord(const FilterSpec& spec) {
+  const auto [edges, order]{minimumOrder(butter, spec)};
+  const auto& [p0, p1]{edges.pass};
+
+  // Natural frequency that puts the passband edges exactly at the ripple
+  const double gpass{std::pow(10, 0.1 * spec.passRipple)};
+  const double w0{std::pow(gpass - 1, -1.0 / (2 * order))};
+
+  switch (spec.mode) {
+  case lowpass:
+    return estimate(order, w0 * p0, 0.0, spec);
+  case highpass:
+    return estimate(order, p0 / w0, 0.0, spec);
+  case bandpass: {
+    const double root{
+        std::sqrt(w0 * w0 / 4 * (p1 - p0) * (p1 - p0) + p0 * p1)};
+    const double a{std::abs(-w0 * (p1 - p0) / 2 + root)};
+    const double b{std::abs(w0 * (p1 - p0) / 2 + root)};
+    return estimate(order, std::min(a, b), std::max(a, b), spec);
+  }
+  default: {
+    const double root{
+        std::sqrt((p1 - p0) * (p1 - p0) + 4 * w0 * w0 * p0 * p1)};
+    const double a{std::abs(((p1 - p0) + root) / (2 * w0))};
+    const double b{std::abs(((p1 - p0) - root) / (2 * w0))};
+    return estimate(order, std::min(a, b), std::max(a, b), spec);
+  }
+  }
+}
+
+OrderEstimate cheb1ord(const FilterSpec& spec) {
+  const auto [edges, order]{minimumOrder(cheb1, spec)};
+
+  return estimate(order, edges.pass[0], edges.pass[1], spec);
+}
+
+OrderEstimate cheb2ord(const FilterSpec& spec) {
+  const auto [edges, order]{minimumOrder(cheb2, spec)};
+  const auto& [p0, p1]{edges.pass};
+
+  // Stopband edge at which the design just meets the passband ripple
+  const double gpass{std::pow(10, 0.1 * spec.passRipple)};
+  const double gstop{std::pow(10, 0.1 * spec.stopAttenuation)};
+  const double shift{
+      1 / std::cosh(std::acosh(std::sqrt((gstop - 1) / (gpass - 1))) / order)};
+
+  switch (spec.mode) {
+  case lowpass:
+    return estimate(order, p0 / shift, 0.0, spec);
+  case highpass:
+    return estimate(order, p0 * shift, 0.0, spec);
+  case bandpass: {
+    const double w0{(p0 - p1) / (2 * shift) +
+                    std::sqrt((p1 - p0) * (p1 - p0) / (4 * shift * shift) +
+                              p1 * p0)};
+    return estimate(order, w0, p0 * p1 / w0, spec);
+  }
+  default: {
+    const double w0{shift / 2 * (p0 - p1) +
+                    std::sqrt(shift * shift * (p1 - p0) * (p1 - p0) / 4 +
+                              p1 * p0)};
+    return estimate(order, w0, p0 * p1 / w0, spec);
+  }
+  }
+}
+
+OrderEstimate ellipord(const FilterSpec& spec) {
+  const auto [edges, order]{minimumOrder(ellip, spec)};
+
+  return estimate(order, edges.pass[0], edges.pass[1], spec);
+}
+
+DesignKey designFromSpec(const FilterSpec& spec) {
+  const auto sections{[&](const int order) {
+    return ((isBand(spec.mode) ? 2 * order : order) + 1) / 2;
+  }};
+
+  DesignKey best{};
+  int       bestSections{0};
+  for (const Type type : {butter, cheb1, cheb2, ellip}) {
+    OrderEstimate estimate{};
+    switch (type) {
+    case butter:
+      estimate = buttord(spec);
+      break;
+    case cheb1:
+      estimate = cheb1ord(spec);
+      break;
+    case cheb2:
+      estimate = cheb2ord(spec);
+      break;
+    default:
+      estimate = ellipord(spec);
+      break;
+    }
+
+    if (bestSections == 0 || sections(estimate.order) < bestSections) {
+      bestSections = sections(estimate.order);
+      best = {type,    spec.mode, estimate.order, estimate.fc, estimate.fc2,
+              spec.fs, type == cheb2 ? spec.stopAttenuation : spec.passRipple,
+              spec.stopAttenuation};
+    }
+  }
+
+  return best;
+}
+} // namespace Nodex::Filter
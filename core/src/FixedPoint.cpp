@@ -0,0 +1,224 @@
+#include "FixedPoint.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+// Samples per block: the input block, its two past samples and the 64-bit
+// accumulators of one section stay in L1 cache
+constexpr Index kFixedBlock{256};
+
+// Response of a cascade of sections (a0 in column 3) on n frequencies
+static ArrayXcd sosResponse(const Eigen::Ref<const SosArray>& sos,
+                            const Index                       n) {
+  ArrayXcd h{ArrayXcd::Ones(n)};
+  for (Index i{0}; i < sos.rows(); ++i) {
+    const EigenCoeffs section{sos.row(i).head(3).transpose(),
+                              sos.row(i).tail(3).transpose()};
+    h *= freqz(section, n).h;
+  }
+
+  return h;
+}
+
+SosQuantization quantizeSos(const Eigen::Ref<const SosArray>& sos,
+                            const int wordBits, const int coeffBits,
+                            const Index n) {
+  if (wordBits < 2 || wordBits > 32)
+    throw std::runtime_error("Coefficient words must have 2 to 32 bits");
+
+  // b0, b1, b2, a1, a2 of every section, normalised by a0
+  Eigen::Array<double, Eigen::Dynamic, 5, Eigen::RowMajor> normalized(
+      sos.rows(), 5);
+  normalized.leftCols(3) = sos.leftCols(3).colwise() / sos.col(3);
+  normalized.rightCols(2) = sos.rightCols(2).colwise() / sos.col(3);
+
+  const double largest{static_cast<double>((std::int64_t{1} << (wordBits - 1)) -
+                                           1)};
+  const double peak{normalized.size() > 0 ? normalized.abs().maxCoeff() : 0.0};
+
+  // The most fractional bits that keep every coefficient in the word
+  int bits{coeffBits};
+  if (bits < 0) {
+    bits = wordBits - 1;
+    while (bits > 0 && std::round(peak * std::ldexp(1.0, bits)) > largest)
+      --bits;
+  }
+
+  if (bits > wordBits - 1 || std::round(peak * std::ldexp(1.0, bits)) > largest)
+    throw std::runtime_error("Coefficients do not fit in the word with the "
+                             "requested fractional bits");
+
+  SosQuantization result{};
+  result.coeffBits = bits;
+  result.coeffs =
+      (normalized * std::ldexp(1.0, bits)).round().cast<std::int32_t>();
+
+  result.sos.resize(sos.rows(), 6);
+  const auto quantized{result.coeffs.cast<double>() * std::ldexp(1.0, -bits)};
+  result.sos.leftCols(3)  = quantized.leftCols(3);
+  result.sos.col(3)       = 1.0;
+  result.sos.rightCols(2) = quantized.rightCols(2);
+
+  const ArrayXcd reference{sosResponse(sos, n)};
+  const ArrayXd  error{(sosResponse(result.sos, n) - reference).abs()};
+  result.maxError = error.maxCoeff();
+  result.maxErrorDb =
+      20.0 * std::log10(result.maxError / reference.abs().maxCoeff());
+
+  return result;
+}
+
+// Whether the five products of every section and the rounding offset fit
+// in the 64-bit accumulator for any samples (|x|, |y| <= 2^digits)
+template <typename Sample>
+static bool hasHeadroom(const SosQuantization& q) {
+  const std::int64_t offset{q.coeffBits > 0
+                                ? std::int64_t{1} << (q.coeffBits - 1)
+                                : std::int64_t{0}};
+  const std::int64_t limit{(std::numeric_limits<std::int64_t>::max() - offset) >>
+                           std::numeric_limits<Sample>::digits};
+
+  for (Index i{0}; i < q.coeffs.rows(); ++i) {
+    if (q.coeffs.row(i).template cast<std::int64_t>().abs().sum() > limit)
+      return false;
+  }
+  return true;
+}
+
+// FixedSosFilter implementation
+template <typename Sample>
+FixedSosFilter<Sample>::FixedSosFilter(const Eigen::Ref<const SosArray>& sos,
+                                       const FixedPointFormat& format)
+    : m_quantization{quantizeSos(
+          sos, std::numeric_limits<Sample>::digits + 1, format.coeffBits)},
+      m_format{format} {
+  // Picked fractional bits give way to accumulator headroom: a Q31 notch
+  // (|b0| + |b1| + |b2| + |a1| + |a2| near 7) only fits with 29 bits
+  while (format.coeffBits < 0 && m_quantization.coeffBits > 0 &&
+         !hasHeadroom<Sample>(m_quantization)) {
+    m_quantization = quantizeSos(sos, std::numeric_limits<Sample>::digits + 1,
+                                 m_quantization.coeffBits - 1);
+  }
+
+  if (!hasHeadroom<Sample>(m_quantization))
+    throw std::runtime_error("Coefficients could overflow the 64-bit "
+                             "accumulator; use fewer fractional bits");
+
+  m_format.coeffBits = m_quantization.coeffBits;
+
+  m_state = decltype(m_state)::Zero(sos.rows(), 4);
+  m_input.assign(static_cast<std::size_t>(kFixedBlock + 2), Sample{0});
+  m_accumulator.assign(static_cast<std::size_t>(kFixedBlock), Accumulator{0});
+}
+
+template <typename Sample>
+void FixedSosFilter<Sample>::reset() {
+  m_state.setZero();
+}
+
+// Runs one section in place over a block of at most kFixedBlock samples
+template <typename Sample>
+template <bool Saturate>
+void FixedSosFilter<Sample>::runSection(const Index section, Sample* data,
+                                        const Index length) {
+  const auto        c{m_quantization.coeffs.row(section)};
+  const Accumulator b0{c(0)};
+  const Accumulator b1{c(1)};
+  const Accumulator b2{c(2)};
+  const Accumulator a1{c(3)};
+  const Accumulator a2{c(4)};
+
+  const int         bits{m_quantization.coeffBits};
+  const Accumulator offset{m_format.rounding == FixedPointFormat::nearest &&
+                                   bits > 0
+                               ? Accumulator{1} << (bits - 1)
+                               : Accumulator{0}};
+
+  // Two past inputs, then the block
+  Sample* input{m_input.data()};
+  input[0] = m_state(section, 1);
+  input[1] = m_state(section, 0);
+  std::copy_n(data, length, input + 2);
+
+  // Feed-forward part, independent across samples
+  Accumulator* acc{m_accumulator.data()};
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+  for (Index k = 0; k < length; ++k) {
+    acc[k] = b0 * input[k + 2] + b1 * input[k + 1] + b2 * input[k] + offset;
+  }
+
+  m_state(section, 0) = input[length + 1];
+  m_state(section, 1) = input[length];
+
+  // Feedback recursion
+  constexpr Accumulator lowest{std::numeric_limits<Sample>::min()};
+  constexpr Accumulator highest{std::numeric_limits<Sample>::max()};
+
+  Accumulator y1{m_state(section, 2)};
+  Accumulator y2{m_state(section, 3)};
+  for (Index k{0}; k < length; ++k) {
+    Accumulator yk{(acc[k] - a1 * y1 - a2 * y2) >> bits};
+    if constexpr (Saturate)
+      yk = std::clamp(yk, lowest, highest);
+    else
+      yk = static_cast<Sample>(yk);
+
+    data[k] = static_cast<Sample>(yk);
+    y2      = y1;
+    y1      = yk;
+  }
+
+  m_state(section, 2) = static_cast<Sample>(y1);
+  m_state(section, 3) = static_cast<Sample>(y2);
+}
+
+template <typename Sample>
+void FixedSosFilter<Sample>::process(const Sample* x, Sample* y,
+                                     const Index n) {
+  if (y != x)
+    std::copy_n(x, n, y);
+
+  for (Index start{0}; start < n; start += kFixedBlock) {
+    const Index len{std::min(kFixedBlock, n - start)};
+
+    for (Index i{0}; i < m_state.rows(); ++i) {
+      if (m_format.saturate)
+        runSection<true>(i, y + start, len);
+      else
+        runSection<false>(i, y + start, len);
+    }
+  }
+}
+
+template <typename Sample>
+std::vector<Sample>
+FixedSosFilter<Sample>::process(const std::vector<Sample>& x) {
+  std::vector<Sample> y(x.size());
+  process(x.data(), y.data(), static_cast<Index>(x.size()));
+
+  return y;
+}
+
+template class FixedSosFilter<std::int16_t>;
+template class FixedSosFilter<std::int32_t>;
+
+std::vector<std::int16_t> sosFilterQ15(const Eigen::Ref<const SosArray>& sos,
+                                       const std::vector<std::int16_t>&  x,
+                                       const FixedPointFormat& format) {
+  SosFilterQ15 filter{sos, format};
+
+  return filter.process(x);
+}
+
+std::vector<std::int32_t> sosFilterQ31(const Eigen::Ref<const SosArray>& sos,
+                                       const std::vector<std::int32_t>&  x,
+                                       const FixedPointFormat& format) {
+  SosFilterQ31 filter{sos, format};
+
+  return filter.process(x);
+}
+} // namespace Nodex::Filter
@@ -0,0 +1,191 @@
+#include "Resample.h"
+#include "Fir.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+template <typename T>
+using EigenMap = Eigen::Map<T>;
+
+// Parameters of the anti-aliasing filter (as in scipy's resample_poly)
+constexpr Index  kResampleHalfLengthFactor{10};
+constexpr double kResampleKaiserBeta{5.0};
+
+static void checkFactors(const Index up, const Index down) {
+  if (up < 1 || down < 1)
+    throw std::runtime_error("Resampling factors must be positive");
+}
+
+// PolyphaseResampler implementation
+PolyphaseResampler::PolyphaseResampler(const Index up, const Index down,
+                                       const Eigen::Ref<const ArrayXd>& h,
+                                       const Index delay, const Index channels)
+    : m_up{up}, m_down{down}, m_delay{delay} {
+  checkFactors(up, down);
+  if (h.size() == 0)
+    throw std::runtime_error("Resampling filter must not be empty");
+  if (delay < 0 || channels < 1)
+    throw std::runtime_error("Invalid resampler delay or channel count");
+
+  m_taps   = (h.size() + up - 1) / up;
+  m_phases = RowMajorMatrixXd::Zero(up, m_taps);
+  for (Index k{0}; k < h.size(); ++k)
+    m_phases(k % up, m_taps - 1 - k / up) = h(k);
+
+  m_buffer = RowMajorMatrixXd::Zero(channels, m_taps - 1);
+  reset();
+}
+
+PolyphaseResampler::PolyphaseResampler(const Index up, const Index down,
+                                       const Index channels)
+    : PolyphaseResampler{up, down, resampleFilter(up, down),
+                         kResampleHalfLengthFactor * std::max(up, down),
+                         channels} {}
+
+Index PolyphaseResampler::outputLength(const Index inputLength) const {
+  const Index end{inputLength * m_up};
+  return end > m_next ? (end - m_next + m_down - 1) / m_down : 0;
+}
+
+void PolyphaseResampler::reset() {
+  m_next = m_delay;
+  m_buffer.leftCols(m_taps - 1).setZero();
+}
+
+// Resamples the chunk stored after the history in m_buffer
+void PolyphaseResampler::run(const Index                  length,
+                             Eigen::Ref<RowMajorMatrixXd> y) {
+  const Index history{m_taps - 1};
+  const Index count{y.cols()};
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (Index c = 0; c < m_buffer.rows(); ++c) {
+    Index t{m_next};
+    for (Index n{0}; n < count; ++n, t += m_down) {
+      // Input t / up is the newest one the output depends on; it sits at
+      // history + t / up in the buffer, so the run starts at t / up
+      y(c, n) = m_phases.row(t % m_up).dot(
+          m_buffer.row(c).segment(t / m_up, m_taps));
+    }
+  }
+
+  m_next += count * m_down - length * m_up;
+
+  // Keep the newest inputs as the history of the next chunk
+  if (history > 0)
+    m_buffer.leftCols(history) = m_buffer.middleCols(length, history).eval();
+}
+
+RowMajorMatrixXd PolyphaseResampler::processMultichannel(
+    const Eigen::Ref<const RowMajorMatrixXd>& x) {
+  if (x.rows() != m_buffer.rows())
+    throw std::runtime_error("Input must have one row per channel");
+
+  const Index history{m_taps - 1};
+  const Index length{x.cols()};
+  if (m_buffer.cols() < history + length)
+    m_buffer.conservativeResize(Eigen::NoChange, history + length);
+  m_buffer.middleCols(history, length) = x;
+
+  RowMajorMatrixXd y(x.rows(), outputLength(length));
+  run(length, y);
+
+  return y;
+}
+
+ArrayXd PolyphaseResampler::process(const Eigen::Ref<const ArrayXd>& x) {
+  const EigenMap<const RowMajorMatrixXd> xMap{x.data(), 1, x.size()};
+
+  return processMultichannel(xMap).row(0).transpose().array();
+}
+
+Signal PolyphaseResampler::process(const Signal& x) {
+  const EigenMap<const ArrayXd> xMap{x.data(), static_cast<Index>(x.size())};
+  const ArrayXd                 y{process(xMap)};
+
+  return Signal(y.begin(), y.end());
+}
+
+ArrayXd resampleFilter(const Index up, const Index down) {
+  checkFactors(up, down);
+
+  // Cutoff at the lower Nyquist frequency, as a fraction of the upsampled
+  // Nyquist frequency (so fs = 2)
+  const Index halfLength{kResampleHalfLengthFactor * std::max(up, down)};
+  const ArrayXd h{firwin(2 * halfLength + 1,
+                         1.0 / static_cast<double>(std::max(up, down)), 2.0,
+                         lowpass, kaiser, kResampleKaiserBeta)};
+
+  // Unit gain at DC once the zero stuffing (a gain of 1 / up) is undone
+  return h * static_cast<double>(up);
+}
+
+// Feeds x and then zeros to a fresh resampler until it has produced length
+// outputs
+static RowMajorMatrixXd runWhole(PolyphaseResampler&                       r,
+                                 const Eigen::Ref<const RowMajorMatrixXd>& x,
+                                 const Index length, const Index delay) {
+  if (length == 0)
+    return RowMajorMatrixXd(x.rows(), 0);
+
+  // The last output depends on the inputs up to (its upsampled position) / up
+  const Index last{(delay + (length - 1) * r.down()) / r.up()};
+  const Index padded{std::max(x.cols(), last + 1)};
+
+  RowMajorMatrixXd input{RowMajorMatrixXd::Zero(x.rows(), padded)};
+  input.leftCols(x.cols()) = x;
+
+  return r.processMultichannel(input).leftCols(length);
+}
+
+ArrayXd upfirdn(const Eigen::Ref<const ArrayXd>& h,
+                const Eigen::Ref<const ArrayXd>& x, const Index up,
+                const Index down) {
+  checkFactors(up, down);
+  if (x.size() == 0)
+    return ArrayXd{};
+
+  const Index length{((x.size() - 1) * up + h.size() - 1) / down + 1};
+
+  PolyphaseResampler                     resampler{up, down, h};
+  const EigenMap<const RowMajorMatrixXd> xMap{x.data(), 1, x.size()};
+
+  return runWhole(resampler, xMap, length, 0).row(0).transpose().array();
+}
+
+RowMajorMatrixXd
+resamplePolyMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                         const Index up, const Index down) {
+  checkFactors(up, down);
+
+  const Index divisor{std::gcd(up, down)};
+  const Index p{up / divisor};
+  const Index q{down / divisor};
+
+  if (p == q)
+    return x;
+
+  const ArrayXd      h{resampleFilter(p, q)};
+  const Index        delay{(h.size() - 1) / 2};
+  PolyphaseResampler resampler{p, q, h, delay, x.rows()};
+
+  return runWhole(resampler, x, (x.cols() * p + q - 1) / q, delay);
+}
+
+ArrayXd resamplePoly(const Eigen::Ref<const ArrayXd>& x, const Index up,
+                     const Index down) {
+  const EigenMap<const RowMajorMatrixXd> xMap{x.data(), 1, x.size()};
+
+  return resamplePolyMultichannel(xMap, up, down).row(0).transpose().array();
+}
+
+Signal resamplePoly(const Signal& x, const Index up, const Index down) {
+  const EigenMap<const ArrayXd> xMap{x.data(), static_cast<Index>(x.size())};
+  const ArrayXd                 y{resamplePoly(xMap, up, down)};
+
+  return Signal(y.begin(), y.end());
+}
+} // namespace Nodex::Filter
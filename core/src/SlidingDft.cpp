@@ -0,0 +1,186 @@
+#include "SlidingDft.h"
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+// Angular frequency in radians per sample
+static ArrayXd radians(const Eigen::Ref<const ArrayXd>& frequencies,
+                       const double                     fs) {
+  if (fs <= 0)
+    throw std::runtime_error("Sampling frequency must be positive");
+
+  return 2 * std::numbers::pi * frequencies / fs;
+}
+
+// Goertzel recursion of every lane (channel * frequencies + bin)
+static ArrayXcd goertzelLanes(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                              const ArrayXd&                            w) {
+  const Index nB{w.size()};
+  const Index nL{x.rows() * nB};
+  const Index n{x.cols()};
+
+  ArrayXd coeff(nL);
+  for (Index c{0}; c < x.rows(); ++c)
+    coeff.segment(c * nB, nB) = 2 * w.cos();
+
+  // s(n) = x(n) + 2 cos(w) s(n - 1) - s(n - 2)
+  ArrayXd s1{ArrayXd::Zero(nL)};
+  ArrayXd s2{ArrayXd::Zero(nL)};
+  ArrayXd s0(nL);
+  ArrayXd sample(nL);
+  for (Index j{0}; j < n; ++j) {
+    for (Index c{0}; c < x.rows(); ++c)
+      sample.segment(c * nB, nB).setConstant(x(c, j));
+
+    s0 = sample + coeff * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  // X = e^(-j w (n - 1)) (s(n - 1) - e^(-j w) s(n - 2))
+  ArrayXcd result(nL);
+  for (Index i{0}; i < nL; ++i) {
+    const double wi{w(i % nB)};
+    result(i) = std::polar(1.0, -wi * static_cast<double>(n - 1)) *
+                (s1(i) - std::polar(1.0, -wi) * s2(i));
+  }
+
+  return result;
+}
+
+ArrayXcd goertzel(const Eigen::Ref<const ArrayXd>& x,
+                  const Eigen::Ref<const ArrayXd>& frequencies,
+                  const double                     fs) {
+  return goertzelLanes(
+      Eigen::Map<const RowMajorMatrixXd>(x.data(), 1, x.size()),
+      radians(frequencies, fs));
+}
+
+RowMajorMatrixXcd
+goertzelMultichannel(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                     const Eigen::Ref<const ArrayXd>&          frequencies,
+                     const double                              fs) {
+  const ArrayXcd lanes{goertzelLanes(x, radians(frequencies, fs))};
+
+  return Eigen::Map<const RowMajorMatrixXcd>(lanes.data(), x.rows(),
+                                             frequencies.size());
+}
+
+SlidingDft::SlidingDft(const Eigen::Ref<const ArrayXd>& frequencies,
+                       const double fs, const Index windowLength,
+                       const Index channels)
+    : m_frequencies{frequencies}, m_fs{fs}, m_channels{channels} {
+  if (windowLength < 1 || channels < 1)
+    throw std::runtime_error("Window length and channels must be positive");
+
+  const ArrayXd w{radians(frequencies, fs)};
+  const Index   nL{channels * w.size()};
+  const double  length{static_cast<double>(windowLength)};
+
+  m_step.resize(nL);
+  m_leave.resize(nL);
+  m_scale.resize(nL);
+  for (Index k{0}; k < w.size(); ++k) {
+    // e^(j w N) from the phase in cycles, wrapped before scaling
+    const double  cycles{frequencies(k) / fs * length};
+    const double  wrapped{cycles - std::floor(cycles)};
+    const Complex leave{std::polar(1.0, 2 * std::numbers::pi * wrapped)};
+
+    // A tone A cos(w n) puts A / 2 in its bin, a constant A all of it
+    const double scale{(frequencies(k) == 0 ? 1.0 : 2.0) / length};
+
+    for (Index c{0}; c < channels; ++c) {
+      m_step(c * w.size() + k)  = std::polar(1.0, -w(k));
+      m_leave(c * w.size() + k) = leave;
+      m_scale(c * w.size() + k) = scale;
+    }
+  }
+
+  m_rotator.resize(nL);
+  m_sum.resize(nL);
+  m_sample.resize(nL);
+  m_oldest.resize(nL);
+  m_samples.resize(channels, windowLength);
+  reset();
+}
+
+void SlidingDft::resync() {
+  const Index nB{frequencies()};
+  const Index n{windowLength()};
+
+  // e^(-j w n) from the phase in cycles, wrapped before scaling
+  for (Index k{0}; k < nB; ++k) {
+    const double cycles{m_frequencies(k) / m_fs *
+                        static_cast<double>(m_time)};
+    const double wrapped{cycles - std::floor(cycles)};
+    const Complex rotator{std::polar(1.0, -2 * std::numbers::pi * wrapped)};
+    for (Index c{0}; c < m_channels; ++c)
+      m_rotator(c * nB + k) = rotator;
+  }
+
+  // The window's sum, from its oldest sample (at time m_time - n)
+  for (Index c{0}; c < m_channels; ++c) {
+    for (Index k{0}; k < nB; ++k) {
+      const Index i{c * nB + k};
+      Complex     rotator{m_rotator(i) * m_leave(i)};
+      Complex     sum{};
+      for (Index m{0}, col{m_pos}; m < n; ++m) {
+        sum += m_samples(c, col) * rotator;
+        rotator *= m_step(i);
+        if (++col == n)
+          col = 0;
+      }
+      m_sum(i) = sum;
+    }
+  }
+}
+
+void SlidingDft::process(const Eigen::Ref<const RowMajorMatrixXd>& x,
+                         Eigen::Ref<RowMajorMatrixXd>              amplitude,
+                         Eigen::Ref<RowMajorMatrixXd>              phase) {
+  const Index nB{frequencies()};
+  const Index nL{m_sum.size()};
+  if (x.rows() != m_channels)
+    throw std::runtime_error("Input must have one row per channel");
+  if (amplitude.rows() != nL || amplitude.cols() != x.cols() ||
+      phase.rows() != nL || phase.cols() != x.cols())
+    throw std::runtime_error("Outputs must have one row per channel and "
+                             "frequency, one column per sample");
+
+  for (Index j{0}; j < x.cols(); ++j) {
+    // Newest sample in, the one it replaces in the ring out
+    for (Index c{0}; c < m_channels; ++c) {
+      m_sample.segment(c * nB, nB).setConstant(x(c, j));
+      m_oldest.segment(c * nB, nB).setConstant(m_samples(c, m_pos));
+      m_samples(c, m_pos) = x(c, j);
+    }
+
+    // + x(n) e^(-j w n) - x(n - N) e^(-j w (n - N))
+    m_sum += (m_sample - m_oldest * m_leave) * m_rotator;
+    m_rotator *= m_step;
+
+    ++m_time;
+    if (++m_pos == windowLength()) {
+      m_pos = 0;
+      resync();
+    }
+
+    for (Index i{0}; i < nL; ++i) {
+      amplitude(i, j) = m_scale(i) * std::abs(m_sum(i));
+      phase(i, j)     = std::arg(m_sum(i));
+    }
+  }
+}
+
+ArrayXcd SlidingDft::bins() const {
+  return m_sum * m_scale;
+}
+
+void SlidingDft::reset() {
+  m_samples.setZero();
+  m_pos  = 0;
+  m_time = 0;
+  resync();
+}
+} // namespace Nodex::Filter
@@ -0,0 +1,115 @@
+#include "Stft.h"
+#include "Utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+Stft::Stft(const Window window, const Index windowLength, const Index hop,
+           const Index nfft, const Index channels, const double fs)
+    : m_hop{hop}, m_nfft{nfft < 0 ? windowLength : nfft}, m_fs{fs} {
+  if (windowLength < 1 || hop < 1 || hop > windowLength)
+    throw std::runtime_error("Hop must be between 1 and the window length");
+  if (m_nfft < windowLength)
+    throw std::runtime_error("FFT size must be at least the window length");
+  if (channels < 1 || fs <= 0)
+    throw std::runtime_error("Channels and sampling frequency must be "
+                             "positive");
+
+  // Periodic window: the symmetric window one sample longer, truncated
+  m_window = getWindow(window, windowLength + 1).head(windowLength);
+  m_scale  = 1.0 / (fs * m_window.square().sum());
+
+  // Every bin but DC (and Nyquist for even sizes) also stands for its
+  // negative frequency
+  m_lastDoubled = m_nfft % 2 ? m_nfft / 2 : m_nfft / 2 - 1;
+
+  m_pending  = RowMajorMatrixXd::Zero(channels, windowLength);
+  m_sum      = RowMajorMatrixXd::Zero(channels, bins());
+  m_segment  = Eigen::VectorXd::Zero(windowLength);
+  m_spectrum = Eigen::VectorXcd::Zero(bins());
+}
+
+void Stft::computeFrame(const Index frame) {
+  const Index nC{channels()};
+
+  for (Index c{0}; c < nC; ++c) {
+    m_segment = (m_pending.row(c).transpose().array() * m_window).matrix();
+    Utils::rfft(m_segment, m_spectrum, m_nfft);
+
+    auto psd{m_frames.row(frame * nC + c)};
+    psd = m_spectrum.cwiseAbs2().transpose() * m_scale;
+    psd.segment(1, m_lastDoubled) *= 2.0;
+
+    m_sum.row(c) += psd;
+  }
+  ++m_averaged;
+}
+
+Index Stft::process(const Eigen::Ref<const RowMajorMatrixXd>& x) {
+  if (x.rows() != channels())
+    throw std::runtime_error("Input must have one row per channel");
+
+  const Index n{x.cols()};
+  const Index length{windowLength()};
+  const Index nFrames{m_count + n < length
+                          ? 0
+                          : (m_count + n - length) / m_hop + 1};
+  m_frames.resize(nFrames * channels(), bins());
+
+  // Fill the segment, transform it, then keep its last length - hop samples
+  Index read{0};
+  for (Index f{0}; f < nFrames; ++f) {
+    const Index take{length - m_count};
+    m_pending.middleCols(m_count, take) = x.middleCols(read, take);
+    read += take;
+
+    computeFrame(f);
+
+    for (Index c{0}; c < channels(); ++c) {
+      double* row{&m_pending(c, 0)};
+      std::copy(row + m_hop, row + length, row);
+    }
+    m_count = length - m_hop;
+  }
+
+  m_pending.middleCols(m_count, n - read) = x.rightCols(n - read);
+  m_count += n - read;
+
+  return nFrames;
+}
+
+RowMajorMatrixXd Stft::psd() const {
+  return m_averaged > 0 ? RowMajorMatrixXd{m_sum / m_averaged} : m_sum;
+}
+
+ArrayXd Stft::frequencies() const {
+  return Utils::generateRfftFrequencyVector(m_nfft, m_fs);
+}
+
+void Stft::reset() {
+  m_pending.setZero();
+  m_count = 0;
+  m_frames.resize(0, bins());
+  m_sum.setZero();
+  m_averaged = 0;
+}
+
+RowMajorMatrixXd spectrogram(const Eigen::Ref<const ArrayXd>& x,
+                             const Window window, const Index windowLength,
+                             const Index hop, const Index nfft,
+                             const double fs) {
+  Stft stft{window, windowLength, hop, nfft, 1, fs};
+  stft.process(Eigen::Map<const RowMajorMatrixXd>(x.data(), 1, x.size()));
+
+  return stft.frames();
+}
+
+ArrayXd welch(const Eigen::Ref<const ArrayXd>& x, const Window window,
+              const Index windowLength, const Index hop, const Index nfft,
+              const double fs) {
+  Stft stft{window, windowLength, hop, nfft, 1, fs};
+  stft.process(Eigen::Map<const RowMajorMatrixXd>(x.data(), 1, x.size()));
+
+  return stft.psd().row(0).transpose().array();
+}
+} // namespace Nodex::Filter
@@ -0,0 +1,80 @@
+#include "StreamingFilter.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nodex::Filter {
+template <typename T>
+using EigenMap = Eigen::Map<T>;
+
+StreamingFilter::StreamingFilter(const EigenCoeffs& filter) : m_backend{tf} {
+  if (filter.b.size() == 0 || filter.a.size() == 0 || filter.a(0) == 0.0)
+    throw std::runtime_error("Filter needs coefficients and a(0) != 0");
+
+  // With b and a of the same length linearFilter uses them without copying
+  const Index nC{std::max(filter.b.size(), filter.a.size())};
+  m_filter = EigenCoeffs{ArrayXd::Zero(nC), ArrayXd::Zero(nC)};
+  m_filter.b.head(filter.b.size()) = filter.b / filter.a(0);
+  m_filter.a.head(filter.a.size()) = filter.a / filter.a(0);
+
+  m_state = ArrayXd::Zero(nC - 1);
+}
+
+StreamingFilter::StreamingFilter(const Eigen::Ref<const SosArray>& sos)
+    : m_backend{StreamingFilter::sos}, m_sos{sos},
+      m_state{ArrayXd::Zero(2 * sos.rows())} {}
+
+StreamingFilter::StreamingFilter(const FftConvolver& convolver)
+    : m_backend{fft}, m_convolver{convolver} {
+  m_convolver.reset();
+}
+
+void StreamingFilter::process(const Eigen::Ref<const ArrayXd>& x,
+                              Eigen::Ref<ArrayXd>              y) {
+  switch (m_backend) {
+  case tf: linearFilter(m_filter, x, y, m_state); return;
+  case sos: sosFilter(m_sos, x, y, m_state); return;
+  case fft: m_convolver.process(x, y); return;
+  }
+}
+
+ArrayXd StreamingFilter::process(const Eigen::Ref<const ArrayXd>& x) {
+  ArrayXd y(x.size());
+  process(x, y);
+
+  return y;
+}
+
+Signal StreamingFilter::process(const Signal& x) {
+  const EigenMap<const ArrayXd> xMap(x.data(), static_cast<Index>(x.size()));
+
+  Signal            y(x.size());
+  EigenMap<ArrayXd> yMap(y.data(), static_cast<Index>(y.size()));
+  process(xMap, yMap);
+
+  return y;
+}
+
+void StreamingFilter::reset() {
+  m_state.setZero();
+  m_convolver.reset();
+}
+
+Index StreamingFilter::stateSize() const {
+  return m_backend == fft ? std::max<Index>(m_convolver.irLength() - 1, 0)
+                          : m_state.size();
+}
+
+ArrayXd StreamingFilter::snapshot() const {
+  return m_backend == fft ? m_convolver.history() : m_state;
+}
+
+void StreamingFilter::restore(const Eigen::Ref<const ArrayXd>& state) {
+  if (state.size() != stateSize())
+    throw std::runtime_error("State does not match the filter");
+
+  if (m_backend == fft)
+    m_convolver.setHistory(state);
+  else
+    m_state = state;
+}
+} // namespace Nodex::Filter
@@ -1,5 +1,6 @@
 #include "Utils.h"
 #include "Eigen/Core"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -219,13 +220,54 @@ void saveCsvData(const std::string& filePath, const CsvData& data,
   }
 }
 
-Eigen::ArrayXd computeFFT(const Eigen::Ref<const Eigen::VectorXd>& signal) {
-  Eigen::FFT<double> fft;
+// FFT engine of the calling thread. Eigen's FFT keeps the plan of every size
+// and direction it has run, so a long-lived engine acts as a plan cache. The
+// engines are per thread because the plans and their scratch buffers are not
+// safe to share between threads.
+static Eigen::FFT<double>& fftEngine() {
+  thread_local Eigen::FFT<double> engine{Eigen::FFT<double>::impl_type{},
+                                         Eigen::FFT<double>::HalfSpectrum};
+  return engine;
+}
+
+void rfft(const Eigen::Ref<const Eigen::VectorXd>& signal,
+          Eigen::VectorXcd& spectrum, Eigen::Index nfft) {
+  if (nfft < 0)
+    nfft = signal.size();
+
+  spectrum.resize(nfft / 2 + 1);
+  if (nfft == 0)
+    return;
+
+  if (signal.size() == nfft) {
+    fftEngine().fwd(spectrum.data(), signal.data(), nfft);
+    return;
+  }
+
+  thread_local Eigen::VectorXd padded;
+  const Eigen::Index           n{std::min(nfft, signal.size())};
+  padded.setZero(nfft);
+  padded.head(n) = signal.head(n);
+  fftEngine().fwd(spectrum.data(), padded.data(), nfft);
+}
 
+void irfft(const Eigen::Ref<const Eigen::VectorXcd>& spectrum,
+           Eigen::VectorXd& signal, const Eigen::Index nfft) {
+  if (spectrum.size() != nfft / 2 + 1)
+    throw std::runtime_error("Half spectrum must have nfft / 2 + 1 bins");
+
+  signal.resize(nfft);
+  if (nfft == 0)
+    return;
+
+  fftEngine().inv(signal.data(), spectrum.data(), nfft);
+}
+
+Eigen::ArrayXd computeFFT(const Eigen::Ref<const Eigen::VectorXd>& signal) {
   Eigen::VectorXcd freqDomain;
-  fft.fwd(freqDomain, signal);
+  rfft(signal, freqDomain);
 
-  return freqDomain.cwiseAbs().real();
+  return freqDomain.cwiseAbs().array();
 }
 
 Eigen::ArrayXd generateTimeVector(const Eigen::Index length, const double fs) {
@@ -247,4 +289,9 @@ Eigen::ArrayXd generateFrequencyVector(const Eigen::Index length,
   }
   return result;
 }
+
+Eigen::ArrayXd generateRfftFrequencyVector(const Eigen::Index length,
+                                           const double       fs) {
+  return generateFrequencyVector(length, fs).head(length / 2 + 1);
+}
 } // namespace Nodex::Utils
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef TESTS_SRC_TESTSIGNALS_H_
+#define TESTS_SRC_TESTSIGNALS_H_
+
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @file TestSignals.h
+ * @brief Deterministic broadband test signals shared by the tests.
+ */
+
+/**
+ * Generates a slow sine plus a cosine of a scrambled sample index, which
+ * spreads energy over the whole band.
+ * @param n The number of samples
+ * @param frequency The sine frequency (rad/sample)
+ * @param amplitude The amplitude of the scrambled cosine
+ * @param shift The offset of the scrambled index, to decorrelate channels
+ * @return The signal
+ */
+inline Nodex::Filter::ArrayXd noise(const Nodex::Filter::Index n,
+                                    const double frequency = 0.05,
+                                    const double amplitude = 0.4,
+                                    const Nodex::Filter::Index shift = 0) {
+  Nodex::Filter::ArrayXd x(n);
+  for (Nodex::Filter::Index i{0}; i < n; ++i) {
+    x(i) = std::sin(frequency * static_cast<double>(i)) +
+           amplitude * std::cos(static_cast<double>((i * 37 + shift) % 113));
+  }
+  return x;
+}
+
+// The same signal as noise(), as a std::vector
+inline Nodex::Filter::Signal noiseSignal(const std::size_t n,
+                                         const double frequency = 0.05,
+                                         const double amplitude = 0.4) {
+  const Nodex::Filter::ArrayXd x{
+      noise(static_cast<Nodex::Filter::Index>(n), frequency, amplitude)};
+  return Nodex::Filter::Signal(x.begin(), x.end());
+}
+
+// One noise() row per channel, each with its own frequency and shift
+inline Nodex::Filter::RowMajorMatrixXd
+noiseMatrix(const Nodex::Filter::Index rows, const Nodex::Filter::Index cols,
+            const double frequency = 0.01, const double amplitude = 0.3) {
+  Nodex::Filter::RowMajorMatrixXd x(rows, cols);
+  for (Nodex::Filter::Index r{0}; r < rows; ++r) {
+    x.row(r) = noise(cols, frequency * static_cast<double>(r + 1), amplitude,
+                     7 * r)
+                   .transpose();
+  }
+  return x;
+}
+
+#endif // TESTS_SRC_TESTSIGNALS_H_
@@ -0,0 +1,208 @@
+#include "Averaging.h"
+#include "FilterEigen.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace Nodex::Filter;
+
+// Test signal: a slow sine on a large offset plus fast noise, per channel
+RowMajorMatrixXd testSignal(const Index channels, const Index n,
+                            const double offset) {
+  RowMajorMatrixXd x{RowMajorMatrixXd::Random(channels, n)};
+  for (Index c{0}; c < channels; ++c)
+    for (Index j{0}; j < n; ++j)
+      x(c, j) += offset + std::sin(0.001 * (c + 1) * j);
+  return x;
+}
+
+// Runs process over chunks of varying length (some empty)
+template <typename F>
+void inChunks(const Index n, F&& process) {
+  const Index sizes[]{1, 0, 17, 333, 2, 1000};
+  for (Index start{0}, i{0}; start < n; ++i) {
+    const Index size{std::min(sizes[i % 6], n - start)};
+    process(start, size);
+    start += size;
+  }
+}
+
+bool testMovingAverage() {
+  std::cout << "--- Testing moving average ---\n";
+
+  const Index            n{20000};
+  const Index            window{101};
+  const RowMajorMatrixXd x{testSignal(2, n, 0.0)};
+
+  RowMajorMatrixXd y(2, n);
+  MovingAverage    average{window, 2};
+  inChunks(n, [&](const Index start, const Index size) {
+    average.process(x.middleCols(start, size), y.middleCols(start, size));
+  });
+
+  double diff{0.0};
+  for (Index c{0}; c < 2; ++c) {
+    const ArrayXd expected{linearFilter(
+        EigenCoeffs{ArrayXd::Constant(window, 1.0 / window), ArrayXd::Ones(1)},
+        x.row(c).transpose().array())};
+    diff = std::max(
+        diff, (y.row(c).transpose().array() - expected).abs().maxCoeff());
+  }
+
+  // In place
+  RowMajorMatrixXd inPlace{x};
+  average.reset();
+  average.process(inPlace, inPlace);
+
+  std::cout << "max |running - FIR|: " << diff << '\n';
+
+  return diff < 1e-12 && inPlace == y;
+}
+
+bool testExponentialAverage() {
+  std::cout << "--- Testing exponential average ---\n";
+
+  const Index            n{5000};
+  const double           alpha{0.05};
+  const RowMajorMatrixXd x{testSignal(3, n, 1.0)};
+
+  RowMajorMatrixXd   y(3, n);
+  ExponentialAverage average{alpha, 3};
+  inChunks(n, [&](const Index start, const Index size) {
+    average.process(x.middleCols(start, size), y.middleCols(start, size));
+  });
+
+  double diff{0.0};
+  for (Index c{0}; c < 3; ++c) {
+    const ArrayXd expected{linearFilter(
+        EigenCoeffs{ArrayXd::Constant(1, alpha), ArrayXd{{1.0, alpha - 1}}},
+        x.row(c).transpose().array())};
+    diff = std::max(
+        diff, (y.row(c).transpose().array() - expected).abs().maxCoeff());
+  }
+
+  // A step reaches 1 - 1/e after one time constant
+  const double       fs{1000.0};
+  ExponentialAverage step{ExponentialAverage::alphaFromTimeConstant(0.1, fs)};
+  RowMajorMatrixXd   ones{RowMajorMatrixXd::Ones(1, 100)};
+  step.process(ones, ones);
+
+  std::cout << "max |recursive - IIR|: " << diff
+            << ", step after tau: " << ones(0, 99) << '\n';
+
+  return diff < 1e-12 && std::abs(ones(0, 99) - (1 - std::exp(-1.0))) < 1e-12;
+}
+
+bool testCic() {
+  std::cout << "--- Testing CIC decimator ---\n";
+
+  const Index            n{10007};
+  const Index            decimation{8};
+  const Index            stages{3};
+  const Index            delay{2};
+  const RowMajorMatrixXd x{testSignal(2, n, 0.0)};
+
+  // Reference: the cascade of boxcars as one FIR, then every 8th sample
+  ArrayXd b{ArrayXd::Ones(1)};
+  for (Index s{0}; s < stages; ++s) {
+    ArrayXd next{ArrayXd::Zero(b.size() + decimation * delay - 1)};
+    for (Index k{0}; k < decimation * delay; ++k)
+      next.segment(k, b.size()) += b;
+    b = next;
+  }
+  b /= b.sum();
+
+  CicDecimator     cic{decimation, stages, delay, 2};
+  RowMajorMatrixXd y(2, 0);
+  inChunks(n, [&](const Index start, const Index size) {
+    const RowMajorMatrixXd out{cic.process(x.middleCols(start, size))};
+    RowMajorMatrixXd       grown(2, y.cols() + out.cols());
+    grown << y, out;
+    y = grown;
+  });
+
+  double diff{0.0};
+  for (Index c{0}; c < 2; ++c) {
+    const ArrayXd full{linearFilter(EigenCoeffs{b, ArrayXd::Ones(1)},
+                                    x.row(c).transpose().array())};
+    for (Index i{0}; i < y.cols(); ++i)
+      diff = std::max(diff, std::abs(y(c, i) - full(i * decimation)));
+  }
+  std::cout << "outputs: " << y.cols() << ", max |CIC - FIR|: " << diff
+            << '\n';
+
+  bool rejected{false};
+  try {
+    CicDecimator{0, 3};
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return y.cols() == (n + decimation - 1) / decimation && diff < 1e-12 &&
+         rejected;
+}
+
+bool testRunningStats() {
+  std::cout << "--- Testing running statistics ---\n";
+
+  // A large offset: a running sum of squares would lose every digit of the
+  // variance
+  const Index            n{300000};
+  const Index            window{500};
+  const RowMajorMatrixXd x{testSignal(2, n, 1e6)};
+
+  RowMajorMatrixXd mean(2, n), variance(2, n), rms(2, n);
+  RunningStats     stats{window, 2};
+  inChunks(n, [&](const Index start, const Index size) {
+    stats.process(x.middleCols(start, size), mean.middleCols(start, size),
+                  variance.middleCols(start, size),
+                  rms.middleCols(start, size));
+  });
+
+  // Two-pass statistics of a few windows (zeros before the start)
+  double meanDiff{0.0}, varDiff{0.0}, rmsDiff{0.0};
+  for (const Index j : {Index{0}, Index{10}, window - 1, Index{4321}, n - 1}) {
+    for (Index c{0}; c < 2; ++c) {
+      ArrayXd w{ArrayXd::Zero(window)};
+      const Index filled{std::min(j + 1, window)};
+      w.tail(filled) = x.row(c).segment(j + 1 - filled, filled).transpose();
+
+      const double m{w.mean()};
+      const double v{(w - m).square().mean()};
+      meanDiff = std::max(meanDiff, std::abs(mean(c, j) - m));
+      varDiff  = std::max(varDiff, std::abs(variance(c, j) - v) / v);
+      rmsDiff  = std::max(rmsDiff,
+                          std::abs(rms(c, j) - std::sqrt(w.square().mean())));
+    }
+  }
+  std::cout << "max mean error: " << meanDiff
+            << ", max relative variance error: " << varDiff
+            << ", max rms error: " << rmsDiff << '\n';
+
+  return meanDiff < 1e-6 && varDiff < 1e-6 && rmsDiff < 1e-6;
+}
+
+int main() {
+  if (!testMovingAverage()) {
+    std::cerr << "Moving average test failed.\n";
+    return 1;
+  }
+
+  if (!testExponentialAverage()) {
+    std::cerr << "Exponential average test failed.\n";
+    return 1;
+  }
+
+  if (!testCic()) {
+    std::cerr << "CIC decimator test failed.\n";
+    return 1;
+  }
+
+  if (!testRunningStats()) {
+    std::cerr << "Running statistics test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+#include "BatchDesign.h"
+#include "DesignCache.h"
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// Every type and mode, at mixed orders so that the rows need padding
+std::vector<DesignKey> sweep() {
+  std::vector<DesignKey> keys{};
+  for (const Type type : {butter, cheb1, cheb2, ellip}) {
+    for (const Mode mode : {lowpass, highpass, bandpass, bandstop}) {
+      for (int order{1}; order <= 7; order += 2) {
+        keys.push_back({type, mode, order, 40.0 + 10.0 * order,
+                        200.0 + 5.0 * order, 1000.0,
+                        type == cheb2 ? 40.0 : 1.0});
+      }
+    }
+  }
+  return keys;
+}
+
+double maxDiff(const std::vector<Complex>& expected,
+               const DesignBatch::ComplexRows& rows, const Index row) {
+  double diff{0.0};
+  for (std::size_t j{0}; j < expected.size(); ++j)
+    diff = std::max(diff, std::abs(expected[j] -
+                                   rows(row, static_cast<Index>(j))));
+  return diff;
+}
+
+bool testMatchesDesign() {
+  std::cout << "--- Testing batch design against designFilter ---\n";
+
+  const std::vector<DesignKey> keys{sweep()};
+  const DesignBatch            batch{iirFilterBatch(keys)};
+
+  bool   ok{batch.size() == static_cast<Index>(keys.size())};
+  double diff{0.0};
+  for (Index i{0}; ok && i < batch.size(); ++i) {
+    const Design design{designFilter(keys[static_cast<std::size_t>(i)])};
+    const Index  nSections{design.sos.rows()};
+
+    ok = ok &&
+         batch.counts(i) == static_cast<Index>(design.zpk.p.size()) &&
+         batch.sections(i) == nSections;
+    if (!ok)
+      break;
+
+    diff = std::max({diff, maxDiff(design.zpk.z, batch.zeros, i),
+                     maxDiff(design.zpk.p, batch.poles, i),
+                     std::abs(design.zpk.k - batch.gains(i)) /
+                         std::abs(design.zpk.k)});
+
+    const auto row{batch.sos.row(i)};
+    for (Index s{0}; s < nSections; ++s)
+      diff = std::max(diff, (row.segment(6 * s, 6).array() -
+                             design.sos.row(s).matrix().array())
+                                .abs()
+                                .maxCoeff());
+
+    // Padding: zero roots and pass-through sections
+    for (Index j{batch.counts(i)}; j < batch.zeros.cols(); ++j)
+      ok = ok && batch.zeros(i, j) == Complex{} &&
+           batch.poles(i, j) == Complex{};
+    for (Index s{nSections}; s < batch.sos.cols() / 6; ++s)
+      ok = ok && row(6 * s) == 1.0 && row(6 * s + 3) == 1.0 &&
+           row.segment(6 * s, 6).array().abs().sum() == 2.0;
+  }
+  std::cout << "designs: " << batch.size() << ", max difference: " << diff
+            << '\n';
+
+  // Both run the same design steps, so the results are identical
+  return ok && diff == 0.0;
+}
+
+bool testFilterBatch() {
+  std::cout << "--- Testing batch design with multichannel filtering ---\n";
+
+  const std::vector<DesignKey> keys{
+      {butter, lowpass,  2, 50.0,  0.0,   1000.0},
+      {cheb1,  bandpass, 3, 80.0,  160.0, 1000.0, 1.0},
+      {cheb2,  highpass, 5, 120.0, 0.0,   1000.0, 40.0},
+  };
+  const DesignBatch batch{iirFilterBatch(keys)};
+
+  const Index      n{500};
+  RowMajorMatrixXd x(3, n);
+  for (Index j{0}; j < n; ++j)
+    x.col(j).setConstant(std::sin(0.05 * j) + 0.5 * std::sin(1.1 * j));
+
+  RowMajorMatrixXd       state{RowMajorMatrixXd::Zero(3, batch.sos.cols() / 3)};
+  const RowMajorMatrixXd y{sosFilterMultichannel(batch.sos, x, state)};
+
+  double diff{0.0};
+  for (Index i{0}; i < 3; ++i) {
+    const ArrayXd expected{sosFilter(
+        designFilter(keys[static_cast<std::size_t>(i)]).sos,
+        x.row(i).transpose().array())};
+    diff = std::max(
+        diff, (y.row(i).transpose().array() - expected).abs().maxCoeff());
+  }
+  std::cout << "max |batch - single|: " << diff << '\n';
+
+  bool rejected{false};
+  try {
+    iirFilterBatch({{butter, lowpass, 0, 50.0, 0.0, 1000.0}});
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return diff < 1e-9 && rejected && iirFilterBatch({}).size() == 0;
+}
+
+// Whether the batch design of keys throws a runtime_error
+bool throws(const std::vector<DesignKey>& keys) {
+  try {
+    iirFilterBatch(keys);
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+bool testRejected() {
+  std::cout << "--- Testing rejected batch keys ---\n";
+
+  const DesignKey valid{ellip, lowpass, 4, 100.0, 0.0, 1000.0, 1.0, 40.0};
+
+  // Rejected before the designs start
+  std::vector<DesignKey> invalid(5, valid);
+  invalid[0].ripple      = 0.0;
+  invalid[1].attenuation = 0.0;
+  invalid[2].fc          = 500.0;
+  invalid[3].mode        = bandpass;
+  invalid[3].fc2         = 80.0;
+  invalid[4].mode        = bandstop;
+  invalid[4].fc2         = 600.0;
+
+  bool checked{true};
+  for (const auto& key : invalid)
+    checked = checked && throws({valid, key});
+
+  // Passes the checks but fails in the design itself, inside the parallel
+  // region: the error must still reach the caller
+  DesignKey failing{valid};
+  failing.attenuation = 1e4;
+  const bool designed{throws({valid, failing, valid})};
+
+  std::cout << "checked keys rejected: " << checked
+            << ", failed design rejected: " << designed << '\n';
+
+  return checked && designed && !throws({valid});
+}
+
+int main() {
+  if (!testMatchesDesign()) {
+    std::cerr << "Batch design test failed.\n";
+    return 1;
+  }
+
+  if (!testFilterBatch()) {
+    std::cerr << "Batch design filtering test failed.\n";
+    return 1;
+  }
+
+  if (!testRejected()) {
+    std::cerr << "Batch design rejection test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
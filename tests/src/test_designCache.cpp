@@ -0,0 +1,130 @@
+#include "DesignCache.h"
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <iostream>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+bool testHitsAndMisses() {
+  std::cout << "--- Testing design cache hits and misses ---\n";
+
+  DesignCache cache{};
+
+  const DesignKey key{cheb1, bandpass, 3, 50.0, 150.0, 1000.0, 1.0};
+  const auto      first{cache.get(key)};
+  const auto      second{cache.get(key)};
+
+  // fc2 does not affect a lowpass design, so both keys share an entry
+  const auto lowpass4{cache.get({butter, lowpass, 4, 100.0, 0.0, 1000.0})};
+  const auto lowpass4Again{cache.get({butter, lowpass, 4, 100.0, 7.0, 1000.0})};
+
+  std::cout << "hits: " << cache.hits() << ", misses: " << cache.misses()
+            << ", size: " << cache.size() << '\n';
+
+  return first == second && lowpass4 == lowpass4Again && cache.hits() == 2 &&
+         cache.misses() == 2 && cache.size() == 2;
+}
+
+bool testMatchesDesign() {
+  std::cout << "--- Testing cached design against iirFilter ---\n";
+
+  DesignCache cache{};
+
+  const ZPK      zpk{iirFilter(3, 50.0, 150.0, 1000.0, cheb1, bandpass, 1.0)};
+  const EigenZPK eigenZpk{zpk};
+  const auto     design{
+      cache.get({cheb1, bandpass, 3, 50.0, 150.0, 1000.0, 1.0})};
+
+  const EigenCoeffs tf{zpk2tf(eigenZpk)};
+  const SosArray    sos{zpk2sos(eigenZpk)};
+
+  const bool same{design->zpk.z == zpk.z && design->zpk.p == zpk.p &&
+                  design->zpk.k == zpk.k && (design->tf.b == tf.b).all() &&
+                  (design->tf.a == tf.a).all() &&
+                  design->sos.rows() == sos.rows() &&
+                  (design->sos == sos).all()};
+  std::cout << "identical: " << same << '\n';
+
+  return same;
+}
+
+bool testEviction() {
+  std::cout << "--- Testing least recently used eviction ---\n";
+
+  DesignCache cache{2};
+
+  const DesignKey a{butter, lowpass, 2, 100.0, 0.0, 1000.0};
+  const DesignKey b{butter, lowpass, 3, 100.0, 0.0, 1000.0};
+  const DesignKey c{butter, lowpass, 4, 100.0, 0.0, 1000.0};
+
+  const auto kept{cache.get(a)};
+  cache.get(b);
+  cache.get(a); // a becomes the most recently used
+  cache.get(c); // evicts b
+
+  const std::size_t missesBefore{cache.misses()};
+  cache.get(a);
+  const bool aKept{cache.misses() == missesBefore};
+  cache.get(b);
+  const bool bEvicted{cache.misses() == missesBefore + 1};
+
+  std::cout << "size: " << cache.size() << ", a kept: " << aKept
+            << ", b evicted: " << bEvicted << '\n';
+
+  // Evicted designs stay valid for their holders
+  return cache.size() == 2 && aKept && bEvicted && kept->sos.rows() == 1;
+}
+
+bool testConcurrentAccess() {
+  std::cout << "--- Testing concurrent design cache access ---\n";
+
+  DesignCache cache{16};
+
+  const int                                  lookups{2000};
+  std::vector<std::shared_ptr<const Design>> designs(lookups);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < lookups; ++i) {
+    designs[i] = cache.get({butter, lowpass, 1 + i % 12, 100.0, 0.0, 1000.0});
+  }
+
+  // Each of the 12 designs is missed at least once, and at most once per
+  // thread racing on it
+  bool ok{cache.hits() + cache.misses() == lookups && cache.size() == 12 &&
+          cache.misses() >= 12};
+  for (int i = 0; i < lookups; ++i) {
+    ok = ok && designs[i] == designs[i % 12] &&
+         designs[i]->sos.rows() == (i % 12 + 2) / 2;
+  }
+  std::cout << "hits: " << cache.hits() << ", misses: " << cache.misses()
+            << '\n';
+
+  return ok;
+}
+
+int main() {
+  if (!testHitsAndMisses()) {
+    std::cerr << "Design cache hit and miss test failed.\n";
+    return 1;
+  }
+
+  if (!testMatchesDesign()) {
+    std::cerr << "Cached design test failed.\n";
+    return 1;
+  }
+
+  if (!testEviction()) {
+    std::cerr << "Design cache eviction test failed.\n";
+    return 1;
+  }
+
+  if (!testConcurrentAccess()) {
+    std::cerr << "Concurrent design cache test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+#include "Convolution.h"
+#include "Filter.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+// Direct convolution truncated to the input length
+ArrayXd directConvolve(const ArrayXd& h, const ArrayXd& x) {
+  ArrayXd y{ArrayXd::Zero(x.size())};
+  for (Index n{0}; n < x.size(); ++n) {
+    for (Index k{0}; k < h.size() && k <= n; ++k) {
+      y(n) += h(k) * x(n - k);
+    }
+  }
+  return y;
+}
+
+bool testRealFft(const Index n) {
+  std::cout << "--- Testing real FFT (" << n << " points) ---\n";
+
+  const ArrayXd x{noise(n)};
+
+  Eigen::VectorXcd spectrum;
+  Nodex::Utils::rfft(x.matrix(), spectrum);
+
+  // Direct DFT of the non-negative frequency bins
+  double diff{0.0};
+  for (Index k{0}; k <= n / 2; ++k) {
+    Complex bin{0.0};
+    for (Index i{0}; i < n; ++i) {
+      bin += x(i) * std::polar(1.0, -2.0 * std::numbers::pi *
+                                        static_cast<double>(k * i) /
+                                        static_cast<double>(n));
+    }
+    diff = std::max(diff, std::abs(spectrum(k) - bin));
+  }
+
+  Eigen::VectorXd roundTrip;
+  Nodex::Utils::irfft(spectrum, roundTrip, n);
+  const double inverseDiff{(roundTrip.array() - x).abs().maxCoeff()};
+
+  std::cout << "bins: " << spectrum.size() << ", max |rfft - dft|: " << diff
+            << ", max |irfft(rfft(x)) - x|: " << inverseDiff << '\n';
+
+  return spectrum.size() == n / 2 + 1 && diff < 1e-9 && inverseDiff < 1e-12;
+}
+
+bool testChunkedConvolution(const Index irLength, const Index chunk) {
+  std::cout << "--- Testing FFT convolver (IR " << irLength << ", chunks of "
+            << chunk << ") ---\n";
+
+  const ArrayXd h{noise(irLength + 7).tail(irLength)};
+  const ArrayXd x{noise(5000)};
+
+  FftConvolver convolver{h};
+  ArrayXd      y(x.size());
+  for (Index start{0}; start < x.size(); start += chunk) {
+    const Index len{std::min(chunk, x.size() - start)};
+    y.segment(start, len) = convolver.process(x.segment(start, len));
+  }
+
+  const double diff{(y - directConvolve(h, x)).abs().maxCoeff()};
+  std::cout << "fft size: " << convolver.fftSize()
+            << ", max |fft - direct|: " << diff << '\n';
+
+  return diff < 1e-9;
+}
+
+bool testPartitionedConvolution(const Index irLength, const Index blockSize,
+                                const Index tailBlockSize, const Index chunk) {
+  std::cout << "--- Testing partitioned convolver (IR " << irLength
+            << ", blocks " << blockSize << "/" << tailBlockSize
+            << ", chunks of " << chunk << ") ---\n";
+
+  const ArrayXd h{noise(irLength + 3).tail(irLength)};
+  const ArrayXd x{noise(6000)};
+
+  PartitionedConvolver convolver{h, blockSize, tailBlockSize};
+  ArrayXd              y(x.size());
+  for (Index start{0}; start < x.size(); start += chunk) {
+    const Index len{std::min(chunk, x.size() - start)};
+    y.segment(start, len) = convolver.process(x.segment(start, len));
+  }
+
+  const double diff{(y - directConvolve(h, x)).abs().maxCoeff()};
+  std::cout << "max |partitioned - direct|: " << diff << '\n';
+
+  return diff < 1e-9;
+}
+
+bool testEffectiveIR(const EigenCoeffs& filter) {
+  std::cout << "--- Testing effective impulse response length ---\n";
+
+  const double epsilon{1e-12};
+  const Index  maxLength{20000};
+
+  // Brute force: simulate maxLength samples and trim below epsilon
+  ArrayXd impulse{ArrayXd::Zero(maxLength)};
+  impulse(0) = 1.0;
+  const ArrayXd full{linearFilter(filter, impulse)};
+  Index         expectedLength{1};
+  for (Index i{full.size() - 1}; i > 0; --i) {
+    if (std::abs(full(i)) >= epsilon) {
+      expectedLength = i + 1;
+      break;
+    }
+  }
+
+  const ArrayXd ir{findEffectiveIR(filter, epsilon, maxLength)};
+  std::cout << "estimated: " << estimateIRLength(filter, epsilon, maxLength)
+            << ", effective: " << ir.size() << ", expected: " << expectedLength
+            << '\n';
+
+  return ir.size() == expectedLength &&
+         (ir - full.head(expectedLength)).abs().maxCoeff() == 0.0;
+}
+
+bool testFftFilter() {
+  std::cout << "--- Testing FFT filter against linear filter ---\n";
+
+  const EigenCoeffs filter{
+      zpk2tf(EigenZPK{iirFilter(4, 100.0, 1000.0, butter, lowpass)})};
+  const ArrayXd x{noise(20000)};
+
+  const ArrayXd expected{linearFilter(filter, x)};
+
+  const double diff{
+      (fftFilter(filter, x, 1e-12, 10000) - expected).abs().maxCoeff()};
+  const ArrayXf xf{x.cast<float>()};
+  const double  floatDiff{
+      (fftFilter(filter, xf, 1e-12, 10000).cast<double>() - expected)
+          .abs()
+          .maxCoeff()};
+  std::cout << "max |fft - linear|: " << diff
+            << ", single precision: " << floatDiff << '\n';
+
+  return diff < 1e-9 && floatDiff < 1e-5;
+}
+
+int main() {
+  if (!testRealFft(256)) {
+    std::cerr << "Even size real FFT test failed.\n";
+    return 1;
+  }
+
+  if (!testRealFft(243)) {
+    std::cerr << "Odd size real FFT test failed.\n";
+    return 1;
+  }
+
+  if (!testChunkedConvolution(1, 100)) {
+    std::cerr << "Single tap convolution test failed.\n";
+    return 1;
+  }
+
+  if (!testChunkedConvolution(100, 5000)) {
+    std::cerr << "One-shot convolution test failed.\n";
+    return 1;
+  }
+
+  if (!testChunkedConvolution(300, 77)) {
+    std::cerr << "Chunked convolution test failed.\n";
+    return 1;
+  }
+
+  if (!testPartitionedConvolution(2000, 64, 0, 64)) {
+    std::cerr << "Uniformly partitioned convolution test failed.\n";
+    return 1;
+  }
+
+  if (!testPartitionedConvolution(2000, 64, 0, 45)) {
+    std::cerr << "Partitioned convolution with partial blocks failed.\n";
+    return 1;
+  }
+
+  if (!testPartitionedConvolution(3000, 32, 256, 100)) {
+    std::cerr << "Non-uniformly partitioned convolution test failed.\n";
+    return 1;
+  }
+
+  if (!testEffectiveIR(zpk2tf(
+          EigenZPK{iirFilter(4, 100.0, 1000.0, butter, lowpass)}))) {
+    std::cerr << "Lowpass effective impulse response test failed.\n";
+    return 1;
+  }
+
+  if (!testEffectiveIR(zpk2tf(
+          EigenZPK{iirFilter(3, 40.0, 60.0, 1000.0, cheb1, bandpass, 1.0)}))) {
+    std::cerr << "Narrow bandpass effective impulse response test failed.\n";
+    return 1;
+  }
+
+  if (!testFftFilter()) {
+    std::cerr << "FFT filter test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
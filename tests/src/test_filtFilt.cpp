@@ -0,0 +1,132 @@
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <cmath>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+ArrayXd sine(const Index n, const double f, const double fs) {
+  ArrayXd x(n);
+  for (Index i{0}; i < n; ++i) {
+    x(i) = std::sin(2.0 * std::numbers::pi * f * static_cast<double>(i) / fs);
+  }
+  return x;
+}
+
+bool testConstantInput(const ZPK& zpk) {
+  std::cout << "--- Testing filtfilt of a constant signal ---\n";
+
+  // With steady-state initial conditions there is no start-up transient
+  const ArrayXd x{ArrayXd::Constant(500, 3.0)};
+  const ArrayXd yTf{filtFilt(zpk2tf(EigenZPK{zpk}), x)};
+  const ArrayXd ySos{filtFilt(zpk2sos(EigenZPK{zpk}), x)};
+
+  const double diffTf{(yTf - x).abs().maxCoeff()};
+  const double diffSos{(ySos - x).abs().maxCoeff()};
+  std::cout << "max |tf - x|: " << diffTf << ", max |sos - x|: " << diffSos
+            << '\n';
+
+  return diffTf < 1e-9 && diffSos < 1e-9;
+}
+
+bool testZeroPhase(const ZPK& zpk, const double f, const double fs) {
+  std::cout << "--- Testing filtfilt phase at " << f << " Hz ---\n";
+
+  const ArrayXd x{sine(4000, f, fs)};
+  const ArrayXd y{filtFilt(zpk2sos(EigenZPK{zpk}), x)};
+
+  // Away from the edges the output is the input scaled by |H|^2
+  const std::vector<double> w{2.0 * std::numbers::pi * f / fs};
+  const double              gain{std::norm(freqz(zpk, w)[0])};
+
+  const double diff{
+      (y.segment(1000, 2000) - gain * x.segment(1000, 2000)).abs().maxCoeff()};
+  std::cout << "|H|^2: " << gain << ", max |y - |H|^2 x|: " << diff << '\n';
+
+  return diff < 1e-8;
+}
+
+bool testSosMatchesTf(const ZPK& zpk) {
+  std::cout << "--- Testing SOS filtfilt against transfer function ---\n";
+
+  const Signal x{[] {
+    Signal s(1500);
+    for (std::size_t i{0}; i < s.size(); ++i)
+      s[i] = std::cos(0.07 * static_cast<double>(i)) +
+             0.2 * static_cast<double>(i % 13);
+    return s;
+  }()};
+
+  const Signal yTf{filtFilt(zpk2tf(zpk), x)};
+  const Signal ySos{filtFilt(zpk2sos(zpk), x)};
+
+  double diff{0.0};
+  for (std::size_t i{0}; i < x.size(); ++i)
+    diff = std::max(diff, std::abs(yTf[i] - ySos[i]));
+  std::cout << "max |tf - sos|: " << diff << '\n';
+
+  return diff < 1e-9;
+}
+
+bool testMultichannel(const ZPK& zpk, const Index channels) {
+  std::cout << "--- Testing multichannel filtfilt (" << channels
+            << " channels) ---\n";
+
+  RowMajorMatrixXd x(channels, 800);
+  for (Index r{0}; r < channels; ++r)
+    x.row(r) = sine(800, 5.0 * static_cast<double>(r + 1), 1000.0).transpose();
+
+  const EigenCoeffs tf{zpk2tf(EigenZPK{zpk})};
+  const SosArray    sos{zpk2sos(EigenZPK{zpk})};
+
+  const RowMajorMatrixXd yTf{filtFiltMultichannel(tf, x)};
+  const RowMajorMatrixXd ySos{filtFiltMultichannel(sos, x)};
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd row{x.row(r).transpose().array()};
+    const ArrayXd expectedTf{filtFilt(tf, row)};
+    const ArrayXd expectedSos{filtFilt(sos, row)};
+
+    diff = std::max(diff, (yTf.row(r).transpose().array() - expectedTf)
+                              .abs()
+                              .maxCoeff());
+    diff = std::max(diff, (ySos.row(r).transpose().array() - expectedSos)
+                              .abs()
+                              .maxCoeff());
+  }
+  std::cout << "max |multi - single|: " << diff << '\n';
+
+  return diff == 0.0;
+}
+
+int main() {
+  const double fs{1000.0};
+
+  const ZPK lowpass4{iirFilter(4, 100.0, fs, butter, lowpass)};
+  const ZPK bandpass3{iirFilter(3, 50.0, 150.0, fs, cheb1, bandpass, 1.0)};
+
+  if (!testConstantInput(lowpass4)) {
+    std::cerr << "Constant input filtfilt test failed.\n";
+    return 1;
+  }
+
+  if (!testZeroPhase(lowpass4, 60.0, fs) ||
+      !testZeroPhase(bandpass3, 90.0, fs)) {
+    std::cerr << "Zero phase filtfilt test failed.\n";
+    return 1;
+  }
+
+  if (!testSosMatchesTf(bandpass3)) {
+    std::cerr << "SOS filtfilt test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(bandpass3, 5)) {
+    std::cerr << "Multichannel filtfilt test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
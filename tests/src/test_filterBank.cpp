@@ -0,0 +1,114 @@
+#include "FilterBank.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// Log-spaced bandpass filters of orders cycling through 1, 2 and 3
+std::vector<EigenZPK> bandpassDesigns(const Index bands) {
+  std::vector<EigenZPK> designs{};
+  const double          fs{1000.0};
+  for (Index i{0}; i < bands; ++i) {
+    const double low{20.0 * std::pow(1.15, static_cast<double>(i))};
+    designs.emplace_back(
+        iirFilter(static_cast<int>(i % 3 + 1), low, 1.15 * low, fs));
+  }
+  return designs;
+}
+
+bool testSos(const Index bands) {
+  std::cout << "--- Testing SOS filter bank (" << bands << " bands) ---\n";
+
+  const ArrayXd         x{noise(3000)};
+  std::vector<SosArray> sos{};
+  for (const auto& zpk : bandpassDesigns(bands))
+    sos.push_back(zpk2sos(zpk));
+
+  const RowMajorMatrixXd y{filterBank(sos, x)};
+
+  double diff{0.0};
+  for (Index band{0}; band < bands; ++band) {
+    const ArrayXd expected{sosFilter(sos[static_cast<std::size_t>(band)], x)};
+    diff = std::max(
+        diff, (y.row(band).transpose().array() - expected).abs().maxCoeff());
+  }
+  std::cout << "max |bank - sosFilter|: " << diff << '\n';
+
+  return y.rows() == bands && y.cols() == x.size() && diff < 1e-12;
+}
+
+bool testTransferFunctions(const Index bands) {
+  std::cout << "--- Testing transfer function filter bank (" << bands
+            << " bands) ---\n";
+
+  const ArrayXd            x{noise(3000)};
+  std::vector<EigenCoeffs> tf{};
+  for (const auto& zpk : bandpassDesigns(bands))
+    tf.push_back(zpk2tf(zpk));
+
+  // An FIR band and a first-order band, both shorter than the bank
+  tf.emplace_back(ArrayXd{{0.25, 0.5, 0.25}}, ArrayXd::Ones(1));
+  tf.emplace_back(ArrayXd{{0.5, 0.5}}, ArrayXd{{1.0, -0.5}});
+
+  const RowMajorMatrixXd y{filterBank(tf, x)};
+
+  double diff{0.0};
+  for (std::size_t band{0}; band < tf.size(); ++band) {
+    const ArrayXd expected{linearFilter(tf[band], x)};
+    const auto row{y.row(static_cast<Index>(band)).transpose().array()};
+    diff = std::max(diff, (row - expected).abs().maxCoeff());
+  }
+  std::cout << "max |bank - linearFilter|: " << diff << '\n';
+
+  return diff < 1e-10;
+}
+
+bool testStreaming(const Index chunk) {
+  std::cout << "--- Testing streaming filter bank (chunks of " << chunk
+            << ") ---\n";
+
+  const ArrayXd         x{noise(2000)};
+  std::vector<SosArray> sos{};
+  for (const auto& zpk : bandpassDesigns(11))
+    sos.push_back(zpk2sos(zpk));
+
+  const RowMajorMatrixXd expected{filterBank(sos, x)};
+
+  FilterBank       bank{sos};
+  RowMajorMatrixXd y(bank.bands(), x.size());
+  for (Index start{0}; start < x.size(); start += chunk) {
+    const Index len{std::min(chunk, x.size() - start)};
+    bank.process(x.segment(start, len), y.middleCols(start, len));
+  }
+
+  // After a reset the bank starts a new stream
+  bank.reset();
+  const RowMajorMatrixXd again{bank.process(x)};
+
+  const double diff{(y - expected).cwiseAbs().maxCoeff()};
+  std::cout << "max |chunked - whole|: " << diff << '\n';
+
+  return diff == 0.0 && again == expected;
+}
+
+int main() {
+  if (!testSos(1) || !testSos(8) || !testSos(21)) {
+    std::cerr << "SOS filter bank test failed.\n";
+    return 1;
+  }
+
+  if (!testTransferFunctions(5) || !testTransferFunctions(14)) {
+    std::cerr << "Transfer function filter bank test failed.\n";
+    return 1;
+  }
+
+  if (!testStreaming(1) || !testStreaming(100) || !testStreaming(700)) {
+    std::cerr << "Streaming filter bank test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include "FilterDispatch.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+
+using namespace Nodex::Filter;
+
+bool testPlan() {
+  std::cout << "--- Testing filter plans ---\n";
+
+  const FilterCostModel model{};
+  const Index           length{100000};
+
+  // A low order recursion is cheaper than any convolution
+  const EigenCoeffs lowOrder{zpk2tf(EigenZPK{iirFilter(4, 100.0, 1000.0)})};
+  const FilterPlan  low{planFilter(lowOrder, length, 1e-12, 10000, model)};
+
+  // A long FIR filter is cheaper to convolve
+  const EigenCoeffs longFir{ArrayXd::Constant(2000, 1e-3), ArrayXd::Ones(1)};
+  const FilterPlan  fir{planFilter(longFir, length, 1e-12, 10000, model)};
+
+  // An integrator never decays, so it must not be truncated
+  const EigenCoeffs integrator{ArrayXd::Ones(200), ArrayXd{{1.0, -1.0}}};
+  const FilterPlan  never{planFilter(integrator, length, 1e-12, 10000, model)};
+
+  std::cout << "low order: " << low.strategy << " (" << low.timeCost << " ns)"
+            << "\nlong FIR: " << fir.strategy << " (IR " << fir.irLength
+            << ", " << fir.timeCost << " vs " << fir.fftCost << " ns)"
+            << "\nintegrator: " << never.strategy << " (IR "
+            << never.irLength << ")\n";
+
+  return low.strategy == timeDomain && low.irLength == 0 &&
+         fir.strategy == fftConvolution && fir.irLength == 2000 &&
+         fir.fftCost < fir.timeCost && never.strategy == timeDomain &&
+         never.irLength == 10000 && never.fftCost < never.timeCost;
+}
+
+bool testFilter(const FilterCostModel& model, const FilterStrategy expected) {
+  std::cout << "--- Testing dispatched filter ("
+            << (expected == timeDomain ? "time domain" : "FFT") << ") ---\n";
+
+  setFilterCostModel(model);
+
+  const ArrayXd     x{noise(20000)};
+  const EigenZPK    zpk{iirFilter(6, 100.0, 1000.0)};
+  const EigenCoeffs tf{zpk2tf(zpk)};
+  const SosArray    sos{zpk2sos(zpk)};
+
+  const ArrayXd y{filter(tf, x)};
+  const ArrayXd ySos{filter(sos, x)};
+  const double  diff{(y - linearFilter(tf, x)).abs().maxCoeff()};
+  const double  diffSos{(ySos - sosFilter(sos, x)).abs().maxCoeff()};
+
+  const FilterPlan plan{planFilter(tf, x.size())};
+  const FilterPlan sosPlan{planFilter(sos, x.size())};
+
+  std::cout << "max |filter - linearFilter|: " << diff
+            << ", max |filter - sosFilter|: " << diffSos << '\n';
+
+  setFilterCostModel(FilterCostModel{});
+
+  // The convolution only differs by the truncated tail and rounding
+  const double tolerance{expected == timeDomain ? 0.0 : 1e-9};
+
+  return plan.strategy == expected && sosPlan.strategy == expected &&
+         diff <= tolerance && diffSos <= tolerance;
+}
+
+bool testCalibration() {
+  std::cout << "--- Testing cost model calibration ---\n";
+
+  const FilterCostModel model{calibrateFilterCostModel(1 << 12)};
+  const FilterCostModel installed{filterCostModel()};
+
+  std::cout << "sample: " << model.sampleCost << " ns, state: "
+            << model.stateCost << " ns, section: " << model.sectionCost
+            << " ns, fft: " << model.fftCost << " ns\n";
+
+  setFilterCostModel(FilterCostModel{});
+
+  return std::isfinite(model.sampleCost) && std::isfinite(model.stateCost) &&
+         model.sectionCost > 0.0 && model.fftCost > 0.0 &&
+         std::isfinite(model.sectionCost) && std::isfinite(model.fftCost) &&
+         installed.sampleCost == model.sampleCost &&
+         installed.fftCost == model.fftCost;
+}
+
+int main() {
+  if (!testPlan()) {
+    std::cerr << "Filter plan test failed.\n";
+    return 1;
+  }
+
+  // Costs skewed towards one strategy or the other
+  FilterCostModel slowRecursion{};
+  slowRecursion.stateCost   = 1e3;
+  slowRecursion.sectionCost = 1e3;
+
+  FilterCostModel slowFft{};
+  slowFft.fftCost = 1e3;
+
+  if (!testFilter(FilterCostModel{}, timeDomain) ||
+      !testFilter(slowRecursion, fftConvolution) ||
+      !testFilter(slowFft, timeDomain)) {
+    std::cerr << "Dispatched filter test failed.\n";
+    return 1;
+  }
+
+  if (!testCalibration()) {
+    std::cerr << "Cost model calibration test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
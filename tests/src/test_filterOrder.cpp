@@ -0,0 +1,228 @@
+#include "DesignCache.h"
+#include "Filter.h"
+#include "FilterOrder.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// |H| in dB of a design at frequencies in the units of fs
+std::vector<double> gainDb(const ZPK& zpk, const std::vector<double>& f,
+                           const double fs) {
+  std::vector<double> w(f.size());
+  for (std::size_t i{0}; i < f.size(); ++i)
+    w[i] = 2 * std::numbers::pi * f[i] / fs;
+
+  const std::vector<Complex> h{freqz(zpk, w)};
+  std::vector<double>        db(h.size());
+  for (std::size_t i{0}; i < h.size(); ++i)
+    db[i] = 20 * std::log10(std::abs(h[i]));
+  return db;
+}
+
+// n frequencies evenly spaced over [a, b]
+std::vector<double> span(const double a, const double b, const int n) {
+  std::vector<double> f(static_cast<std::size_t>(n));
+  for (int i{0}; i < n; ++i)
+    f[static_cast<std::size_t>(i)] = a + (b - a) * i / (n - 1);
+  return f;
+}
+
+// Whether the design has at most passRipple of loss over the passband and
+// at least stopAttenuation over the stopband
+bool meetsSpec(const DesignKey& key, const FilterSpec& spec) {
+  const ZPK    zpk{designFilter(key).zpk};
+  const double nyquist{spec.fs / 2};
+  const double slack{1e-3};
+
+  std::vector<std::vector<double>> pass{};
+  std::vector<std::vector<double>> stop{};
+  switch (spec.mode) {
+  case lowpass:
+    pass = {span(0.0, spec.passFreq, 200)};
+    stop = {span(spec.stopFreq, nyquist, 400)};
+    break;
+  case highpass:
+    pass = {span(spec.passFreq, nyquist, 200)};
+    stop = {span(0.0, spec.stopFreq, 400)};
+    break;
+  case bandpass:
+    pass = {span(spec.passFreq, spec.passFreq2, 200)};
+    stop = {span(0.0, spec.stopFreq, 400), span(spec.stopFreq2, nyquist, 400)};
+    break;
+  default:
+    pass = {span(0.0, spec.passFreq, 200), span(spec.passFreq2, nyquist, 200)};
+    stop = {span(spec.stopFreq, spec.stopFreq2, 400)};
+    break;
+  }
+
+  bool ok{true};
+  for (const auto& f : pass) {
+    for (const double db : gainDb(zpk, f, spec.fs))
+      ok = ok && db >= -spec.passRipple - slack && db <= slack;
+  }
+  for (const auto& f : stop) {
+    for (const double db : gainDb(zpk, f, spec.fs))
+      ok = ok && db <= -spec.stopAttenuation + slack;
+  }
+
+  return ok;
+}
+
+bool testEllipap(const int n) {
+  std::cout << "--- Testing elliptic prototype (order " << n << ") ---\n";
+
+  const double rp{1.0};
+  const double rs{40.0};
+  const ZPK    zpk{ellipap(n, rp, rs)};
+
+  // Analogue response in dB
+  const auto db{[&](const double w) {
+    Complex h{zpk.k};
+    for (const auto& z : zpk.z)
+      h *= Complex{0.0, w} - z;
+    for (const auto& p : zpk.p)
+      h /= Complex{0.0, w} - p;
+    return 20 * std::log10(std::abs(h));
+  }};
+
+  // Equiripple: between 0 and -rp up to w = 1, at most -rs past the
+  // transition, reaching -rs between the zeros
+  double passMin{0.0}, passMax{-1e9}, stopMax{-1e9};
+  for (int i{0}; i <= 1000; ++i) {
+    const double gain{db(i / 1000.0)};
+    passMin = std::min(passMin, gain);
+    passMax = std::max(passMax, gain);
+  }
+
+  // Stopband edge: where the gain first falls to -rs
+  double ws{1.0};
+  while (db(ws) > -rs + 1e-9 && ws < 100.0)
+    ws += 1e-4;
+  for (int i{0}; i <= 20000; ++i)
+    stopMax = std::max(stopMax, db(ws + i / 100.0));
+
+  std::cout << "passband: [" << passMin << ", " << passMax
+            << "] dB, stopband from " << ws << ", max: " << stopMax
+            << " dB\n";
+
+  const bool stable{std::ranges::all_of(
+      zpk.p, [](const Complex& p) { return p.real() < 0; })};
+
+  return stable && zpk.p.size() == static_cast<std::size_t>(n) &&
+         zpk.z.size() == static_cast<std::size_t>(n - n % 2) &&
+         std::abs(db(1.0) + rp) < 1e-6 && passMin > -rp - 1e-6 &&
+         passMax < 1e-6 && stopMax < -rs + 1e-6 && stopMax > -rs - 1e-3;
+}
+
+bool testOrder(const FilterSpec& spec, const char* name) {
+  std::cout << "--- Testing minimum orders (" << name << ") ---\n";
+
+  bool ok{true};
+  for (const Type type : {butter, cheb1, cheb2, ellip}) {
+    OrderEstimate estimate{};
+    switch (type) {
+    case butter:
+      estimate = buttord(spec);
+      break;
+    case cheb1:
+      estimate = cheb1ord(spec);
+      break;
+    case cheb2:
+      estimate = cheb2ord(spec);
+      break;
+    default:
+      estimate = ellipord(spec);
+      break;
+    }
+
+    DesignKey key{type,         spec.mode, estimate.order, estimate.fc,
+                  estimate.fc2, spec.fs,   spec.passRipple,
+                  spec.stopAttenuation};
+    if (type == cheb2)
+      key.ripple = spec.stopAttenuation;
+
+    const bool meets{meetsSpec(key, spec)};
+    std::cout << "type " << type << ": order " << estimate.order << ", fc "
+              << estimate.fc << ", fc2 " << estimate.fc2
+              << ", meets spec: " << meets << '\n';
+    ok = ok && meets;
+  }
+
+  // Lowpass and highpass orders are exact: one less misses the spec
+  if (spec.mode == lowpass || spec.mode == highpass) {
+    const OrderEstimate estimate{buttord(spec)};
+    ok = ok && !meetsSpec({butter, spec.mode, estimate.order - 1, estimate.fc,
+                           0.0, spec.fs},
+                          spec);
+  }
+
+  return ok;
+}
+
+bool testDesignFromSpec() {
+  std::cout << "--- Testing design from specification ---\n";
+
+  // A sharp transition: elliptic needs far fewer sections
+  FilterSpec sharp{lowpass, 100.0, 120.0};
+  sharp.fs = 1000.0;
+  const DesignKey key{designFromSpec(sharp)};
+
+  // A loose one: every family needs a single section, Butterworth wins
+  FilterSpec loose{lowpass, 50.0, 400.0};
+  loose.fs              = 1000.0;
+  loose.stopAttenuation = 20.0;
+  const DesignKey looseKey{designFromSpec(loose)};
+
+  std::cout << "sharp: type " << key.type << ", order " << key.order
+            << " (butter " << buttord(sharp).order << "); loose: type "
+            << looseKey.type << ", order " << looseKey.order << '\n';
+
+  bool rejected{false};
+  try {
+    designFromSpec({lowpass, 200.0, 100.0, 0.0, 0.0, 1000.0});
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return key.type == ellip && key.order == ellipord(sharp).order &&
+         key.order < buttord(sharp).order && meetsSpec(key, sharp) &&
+         looseKey.type == butter && looseKey.order <= 2 && rejected;
+}
+
+int main() {
+  for (const int n : {2, 3, 4, 5, 7}) {
+    if (!testEllipap(n)) {
+      std::cerr << "Elliptic prototype test failed.\n";
+      return 1;
+    }
+  }
+
+  FilterSpec lp{lowpass, 100.0, 150.0};
+  lp.fs = 1000.0;
+  FilterSpec hp{highpass, 200.0, 120.0};
+  hp.fs              = 1000.0;
+  hp.passRipple      = 0.5;
+  hp.stopAttenuation = 60.0;
+  FilterSpec bp{bandpass, 100.0, 60.0, 200.0, 260.0};
+  bp.fs = 1000.0;
+  FilterSpec bs{bandstop, 100.0, 140.0, 300.0, 220.0};
+  bs.fs = 1000.0;
+
+  if (!testOrder(lp, "lowpass") || !testOrder(hp, "highpass") ||
+      !testOrder(bp, "bandpass") || !testOrder(bs, "bandstop")) {
+    std::cerr << "Minimum order test failed.\n";
+    return 1;
+  }
+
+  if (!testDesignFromSpec()) {
+    std::cerr << "Design from specification test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
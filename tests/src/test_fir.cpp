@@ -0,0 +1,154 @@
+#include "Fir.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+// |H| of FIR taps at the given frequencies (Hz)
+ArrayXd gain(const ArrayXd& taps, const ArrayXd& f, const double fs) {
+  const EigenCoeffs fir{taps, ArrayXd::Ones(1)};
+  return freqz(fir, ArrayXd{2.0 * std::numbers::pi * f / fs}).magnitude;
+}
+
+bool isSymmetric(const ArrayXd& taps) {
+  return (taps - taps.reverse()).abs().maxCoeff() < 1e-12;
+}
+
+bool testFirwin() {
+  std::cout << "--- Testing windowed FIR design ---\n";
+
+  const double fs{1000.0};
+
+  const ArrayXd lowpass101{firwin(101, 100.0, fs)};
+  const ArrayXd highpass101{firwin(101, 100.0, fs, highpass, blackman)};
+  const ArrayXd bandpass80{firwin(80, 100.0, 200.0, fs, bandpass, hann)};
+  const ArrayXd bandstop81{
+      firwin(81, 100.0, 200.0, fs, bandstop, kaiser, 6.0)};
+
+  // Unit gain at the scale frequency, half the gain at the cutoff and a deep
+  // stopband (the Hamming window gives about 53 dB)
+  const ArrayXd lp{gain(lowpass101, ArrayXd{{0.0, 100.0, 200.0, 400.0}}, fs)};
+  const ArrayXd hp{gain(highpass101, ArrayXd{{500.0, 100.0, 20.0}}, fs)};
+  const ArrayXd bp{gain(bandpass80, ArrayXd{{150.0, 20.0, 400.0}}, fs)};
+  const ArrayXd bs{gain(bandstop81, ArrayXd{{0.0, 150.0, 500.0}}, fs)};
+
+  std::cout << "lowpass: " << lp.transpose() << "\nhighpass: "
+            << hp.transpose() << "\nbandpass: " << bp.transpose()
+            << "\nbandstop: " << bs.transpose() << '\n';
+
+  return isSymmetric(lowpass101) && isSymmetric(highpass101) &&
+         isSymmetric(bandpass80) && isSymmetric(bandstop81) &&
+         std::abs(lp(0) - 1.0) < 1e-12 && std::abs(lp(1) - 0.5) < 0.01 &&
+         lp(2) < 3e-3 && lp(3) < 3e-3 && std::abs(hp(0) - 1.0) < 1e-12 &&
+         hp(2) < 1e-3 && std::abs(bp(0) - 1.0) < 1e-12 && bp(1) < 1e-2 &&
+         bp(2) < 1e-2 && std::abs(bs(0) - 1.0) < 1e-12 && bs(1) < 1e-2 &&
+         std::abs(bs(2) - 1.0) < 1e-2;
+}
+
+bool testRemez(const Index numtaps, const double stopWeight,
+               const double passEdge = 0.4, const double stopEdge = 0.5,
+               const double tolerance = 0.02) {
+  std::cout << "--- Testing equiripple FIR design (" << numtaps
+            << " taps, stopband weight " << stopWeight << ", edges "
+            << passEdge << " and " << stopEdge << ") ---\n";
+
+  const double  fs{2.0};
+  const ArrayXd taps{remez(numtaps, {0.0, passEdge, stopEdge, 1.0},
+                           {1.0, 0.0}, {1.0, stopWeight}, fs)};
+
+  const ArrayXd passband{ArrayXd::LinSpaced(20000, 0.0, passEdge)};
+  const ArrayXd stopband{ArrayXd::LinSpaced(20000, stopEdge, 1.0)};
+  const double  passRipple{(gain(taps, passband, fs) - 1.0).abs().maxCoeff()};
+  const double  stopRipple{gain(taps, stopband, fs).maxCoeff()};
+
+  // The weighted errors of an equiripple design are equal in every band
+  const double ratio{passRipple / (stopWeight * stopRipple)};
+  std::cout << "passband ripple: " << passRipple
+            << ", stopband ripple: " << stopRipple << ", ratio: " << ratio
+            << '\n';
+
+  return isSymmetric(taps) && std::abs(ratio - 1.0) < tolerance &&
+         passRipple < 0.05;
+}
+
+bool testFirFilter(const ArrayXd& taps, const FirFilter::Method method,
+                   const Index chunk) {
+  std::cout << "--- Testing FIR filter (" << taps.size() << " taps, "
+            << (method == FirFilter::fft ? "FFT" : "direct")
+            << ", chunks of " << chunk << ") ---\n";
+
+  const ArrayXd x{noise(5000)};
+  const ArrayXd expected{linearFilter(EigenCoeffs{taps, ArrayXd::Ones(1)}, x)};
+
+  FirFilter filter{taps, 1, method};
+  ArrayXd   y{x};
+  for (Index start{0}; start < x.size(); start += chunk) {
+    const Index len{std::min(chunk, x.size() - start)};
+    filter.process(y.segment(start, len), y.segment(start, len));
+  }
+
+  const double diff{(y - expected).abs().maxCoeff()};
+  std::cout << "uses fft: " << filter.usesFft()
+            << ", max |fir - linear|: " << diff << '\n';
+
+  return filter.usesFft() == (method == FirFilter::fft) && diff < 1e-10;
+}
+
+bool testMultichannel(const ArrayXd& taps, const Index channels) {
+  std::cout << "--- Testing multichannel FIR filter (" << taps.size()
+            << " taps, " << channels << " channels) ---\n";
+
+  RowMajorMatrixXd x(channels, 3000);
+  for (Index r{0}; r < channels; ++r)
+    x.row(r) = noise(3000 + r).tail(3000).transpose();
+
+  const RowMajorMatrixXd y{firFilterMultichannel(taps, x)};
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{firFilter(taps, ArrayXd{x.row(r).transpose()})};
+    diff = std::max(
+        diff, (y.row(r).transpose().array() - expected).abs().maxCoeff());
+  }
+  std::cout << "max |multi - single|: " << diff << '\n';
+
+  return diff == 0.0;
+}
+
+int main() {
+  if (!testFirwin()) {
+    std::cerr << "Windowed FIR design test failed.\n";
+    return 1;
+  }
+
+  // A heavily weighted narrow transition: sampling the response from an
+  // interpolant that does not match its nodes drops the ratio to about 0.92,
+  // while the design grid alone accounts for about 1%
+  if (!testRemez(41, 1.0) || !testRemez(40, 1.0) || !testRemez(61, 10.0) ||
+      !testRemez(63, 5.0, 0.3, 0.35, 0.015)) {
+    std::cerr << "Equiripple FIR design test failed.\n";
+    return 1;
+  }
+
+  const ArrayXd short31{firwin(31, 50.0, 1000.0)};
+  const ArrayXd long301{firwin(301, 50.0, 1000.0)};
+
+  if (!testFirFilter(short31, FirFilter::direct, 5000) ||
+      !testFirFilter(short31, FirFilter::direct, 7) ||
+      !testFirFilter(long301, FirFilter::direct, 1500) ||
+      !testFirFilter(long301, FirFilter::fft, 333) ||
+      !testFirFilter(ArrayXd::Constant(1, 2.0), FirFilter::direct, 100)) {
+    std::cerr << "FIR filter test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(short31, 5) || !testMultichannel(long301, 3)) {
+    std::cerr << "Multichannel FIR filter test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,249 @@
+#include "FixedPoint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// Full-scale sine plus a smaller tone, as integer samples
+template <typename Sample>
+std::vector<Sample> tones(const std::size_t n, const double scale) {
+  const double full{static_cast<double>(std::numeric_limits<Sample>::max())};
+
+  std::vector<Sample> x(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    const double t{static_cast<double>(i)};
+    x[i] = static_cast<Sample>(
+        std::round(scale * full *
+                   (0.6 * std::sin(0.01 * t) + 0.3 * std::sin(1.7 * t))));
+  }
+  return x;
+}
+
+// Direct form I, one sample at a time, as firmware computes it
+template <typename Sample>
+std::vector<Sample> reference(const SosQuantization& q, std::vector<Sample> x,
+                              const FixedPointFormat& format) {
+  const std::int64_t lowest{std::numeric_limits<Sample>::min()};
+  const std::int64_t highest{std::numeric_limits<Sample>::max()};
+  const int          bits{q.coeffBits};
+
+  for (Index s{0}; s < q.coeffs.rows(); ++s) {
+    std::int64_t x1{0}, x2{0}, y1{0}, y2{0};
+    for (auto& sample : x) {
+      std::int64_t acc{q.coeffs(s, 0) * std::int64_t{sample} +
+                       q.coeffs(s, 1) * x1 + q.coeffs(s, 2) * x2 -
+                       q.coeffs(s, 3) * y1 - q.coeffs(s, 4) * y2};
+      if (format.rounding == FixedPointFormat::nearest)
+        acc += std::int64_t{1} << (bits - 1);
+
+      std::int64_t y{acc >> bits};
+      y = format.saturate ? std::clamp(y, lowest, highest)
+                          : std::int64_t{static_cast<Sample>(y)};
+
+      x2     = x1;
+      x1     = sample;
+      y2     = y1;
+      y1     = y;
+      sample = static_cast<Sample>(y);
+    }
+  }
+  return x;
+}
+
+template <typename Sample>
+bool testBitExact(const SosArray& sos, const FixedPointFormat& format,
+                  const double scale) {
+  std::cout << "--- Testing Q" << std::numeric_limits<Sample>::digits
+            << " SOS filter (rounding " << format.rounding << ", saturate "
+            << format.saturate << ", scale " << scale << ") ---\n";
+
+  const std::vector<Sample> x{tones<Sample>(3000, scale)};
+
+  FixedSosFilter<Sample>    filter{sos, format};
+  const std::vector<Sample> whole{filter.process(x)};
+  const std::vector<Sample> expected{
+      reference(filter.quantization(), x, format)};
+
+  // Chunks that straddle the internal blocks
+  filter.reset();
+  std::vector<Sample> chunked(x.size());
+  for (std::size_t start{0}; start < x.size(); start += 301) {
+    const std::size_t len{std::min<std::size_t>(301, x.size() - start)};
+    filter.process(x.data() + start, chunked.data() + start,
+                   static_cast<Index>(len));
+  }
+
+  std::cout << "coefficient bits: " << filter.quantization().coeffBits
+            << ", identical: " << (whole == expected) << ", chunked identical: "
+            << (chunked == expected) << '\n';
+
+  return whole == expected && chunked == expected;
+}
+
+template <typename Sample>
+bool testAgainstDouble(const SosArray& sos, const double tolerance) {
+  std::cout << "--- Testing Q" << std::numeric_limits<Sample>::digits
+            << " SOS filter against double precision ---\n";
+
+  const double              full{std::numeric_limits<Sample>::max()};
+  const std::vector<Sample> x{tones<Sample>(4000, 0.5)};
+  FixedSosFilter<Sample>    filter{sos};
+  const std::vector<Sample> y{filter.process(x)};
+
+  // Only the arithmetic differs: the double filter uses the quantized sections
+  ArrayXd xd(static_cast<Index>(x.size()));
+  for (Index i{0}; i < xd.size(); ++i)
+    xd(i) = x[static_cast<std::size_t>(i)] / full;
+  const ArrayXd expected{sosFilter(filter.quantization().sos, xd)};
+
+  double diff{0.0};
+  for (Index i{0}; i < xd.size(); ++i)
+    diff = std::max(diff, std::abs(y[static_cast<std::size_t>(i)] / full -
+                                   expected(i)));
+  std::cout << "max |fixed - double| (full scale 1): " << diff << '\n';
+
+  return diff < tolerance;
+}
+
+bool testQuantization(const SosArray& sos) {
+  std::cout << "--- Testing SOS coefficient quantization ---\n";
+
+  const SosQuantization q15{quantizeSos(sos, 16)};
+  const SosQuantization q31{quantizeSos(sos, 32)};
+  const SosQuantization coarse{quantizeSos(sos, 16, 10)};
+
+  std::cout << "Q15: " << q15.coeffBits << " bits, " << q15.maxErrorDb
+            << " dB; Q31: " << q31.coeffBits << " bits, " << q31.maxErrorDb
+            << " dB; 10 bits: " << coarse.maxErrorDb << " dB\n";
+
+  // The integer coefficients are the quantized sections
+  const double scale{std::ldexp(1.0, q15.coeffBits)};
+  const bool   consistent{
+      (q15.coeffs.cast<double>().leftCols(3) == q15.sos.leftCols(3) * scale)
+          .all() &&
+      (q15.coeffs.cast<double>().rightCols(2) == q15.sos.rightCols(2) * scale)
+          .all()};
+
+  bool rejected{false};
+  try {
+    quantizeSos(sos, 16, 15);
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return consistent && rejected && q31.coeffBits == q15.coeffBits + 16 &&
+         q31.maxError < q15.maxError &&
+         q15.maxError < coarse.maxError && q15.maxErrorDb < -40.0;
+}
+
+bool testSaturation() {
+  std::cout << "--- Testing fixed-point saturation ---\n";
+
+  // A gain of 1.5: full scale inputs overflow
+  SosArray gain(1, 6);
+  gain << 1.5, 0.0, 0.0, 1.0, 0.0, 0.0;
+
+  const std::vector<std::int16_t> x{30000, -30000, 1000};
+  const std::vector<std::int16_t> saturated{sosFilterQ15(gain, x)};
+
+  FixedPointFormat wrap{};
+  wrap.saturate = false;
+  const std::vector<std::int16_t> wrapped{sosFilterQ15(gain, x, wrap)};
+
+  return saturated == std::vector<std::int16_t>{32767, -32768, 1500} &&
+         wrapped == std::vector<std::int16_t>{-20536, 20536, 1500};
+}
+
+bool testHeadroom() {
+  std::cout << "--- Testing Q31 accumulator headroom ---\n";
+
+  // A notch at 10 Hz: |b1| and |a1| are close to 2, and the absolute
+  // coefficients of the section sum to almost 7
+  const double w0{2.0 * std::numbers::pi * 10.0 / 1000.0};
+  const double radius{0.99};
+  SosArray     notch(1, 6);
+  notch << 1.0, -2.0 * std::cos(w0), 1.0, 1.0, -2.0 * radius * std::cos(w0),
+      radius * radius;
+
+  // Full scale square wave, the worst case for the products
+  std::vector<std::int32_t> x(2000);
+  for (std::size_t i{0}; i < x.size(); ++i)
+    x[i] = (i / 7) % 2 ? std::numeric_limits<std::int32_t>::min()
+                       : std::numeric_limits<std::int32_t>::max();
+
+  SosFilterQ31                    filter{notch};
+  const std::vector<std::int32_t> y{filter.process(x)};
+  const std::vector<std::int32_t> expected{
+      reference(filter.quantization(), x, filter.format())};
+
+  FixedPointFormat tooFine{};
+  tooFine.coeffBits = 30;
+  bool rejected{false};
+  try {
+    SosFilterQ31{notch, tooFine};
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  std::cout << "fractional bits: " << filter.quantization().coeffBits
+            << ", bit exact: " << (y == expected) << ", 30 bits rejected: "
+            << rejected << '\n';
+
+  return filter.quantization().coeffBits == 29 && y == expected && rejected;
+}
+
+int main() {
+  const SosArray lowpass{zpk2sos(EigenZPK{iirFilter(4, 50.0, 1000.0)})};
+  const SosArray bandpass{
+      zpk2sos(EigenZPK{iirFilter(3, 60.0, 140.0, 1000.0)})};
+
+  // A gain of 3 in the first section, so that loud inputs overflow
+  SosArray loud{lowpass};
+  loud.row(0).head(3) *= 3.0;
+
+  FixedPointFormat truncating{};
+  truncating.rounding = FixedPointFormat::truncate;
+  FixedPointFormat wrapping{};
+  wrapping.saturate = false;
+
+  if (!testBitExact<std::int16_t>(lowpass, {}, 0.9) ||
+      !testBitExact<std::int16_t>(bandpass, truncating, 0.9) ||
+      !testBitExact<std::int16_t>(loud, {}, 0.9) ||
+      !testBitExact<std::int16_t>(loud, wrapping, 0.9) ||
+      !testBitExact<std::int32_t>(lowpass, {}, 0.9) ||
+      !testBitExact<std::int32_t>(bandpass, truncating, 0.9) ||
+      !testBitExact<std::int32_t>(loud, {}, 0.9) ||
+      !testBitExact<std::int32_t>(loud, wrapping, 0.9)) {
+    std::cerr << "Fixed-point bit-exactness test failed.\n";
+    return 1;
+  }
+
+  if (!testAgainstDouble<std::int16_t>(lowpass, 1e-2) ||
+      !testAgainstDouble<std::int32_t>(lowpass, 1e-6)) {
+    std::cerr << "Fixed-point accuracy test failed.\n";
+    return 1;
+  }
+
+  if (!testQuantization(bandpass)) {
+    std::cerr << "Coefficient quantization test failed.\n";
+    return 1;
+  }
+
+  if (!testSaturation()) {
+    std::cerr << "Fixed-point saturation test failed.\n";
+    return 1;
+  }
+
+  if (!testHeadroom()) {
+    std::cerr << "Fixed-point headroom test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include "Filter.h"
+#include "FilterEigen.h"
+#include <cmath>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+bool testUniformGrid(const ZPK& zpk, const Index n, const bool whole) {
+  std::cout << "--- Testing uniform grid frequency response (" << n << " points"
+            << (whole ? ", whole circle" : "") << ") ---\n";
+
+  const FrequencyResponse response{freqz(zpk2tf(EigenZPK{zpk}), n, whole)};
+
+  const double  span{whole ? 2.0 * std::numbers::pi : std::numbers::pi};
+  const ArrayXd w{ArrayXd::LinSpaced(n, 0, static_cast<double>(n - 1)) *
+                  span / static_cast<double>(n)};
+  const ArrayXcd expected{freqz(EigenZPK{zpk}, w)};
+
+  const double wDiff{(response.w - w).abs().maxCoeff()};
+  const double diff{(response.h - expected).abs().maxCoeff()};
+  const double magnitudeDiff{
+      (response.magnitude - expected.abs()).abs().maxCoeff()};
+  std::cout << "max |uniform - zpk|: " << diff << '\n';
+
+  return response.h.size() == n && wDiff < 1e-12 && diff < 1e-9 &&
+         magnitudeDiff < 1e-9;
+}
+
+bool testLongFir(const Index n, const bool whole) {
+  std::cout << "--- Testing FFT frequency response of a long FIR (" << n
+            << " points" << (whole ? ", whole circle" : "") << ") ---\n";
+
+  ArrayXd b(301);
+  for (Index i{0}; i < b.size(); ++i)
+    b(i) = std::cos(0.3 * static_cast<double>(i)) / static_cast<double>(i + 1);
+  const EigenCoeffs fir{b, ArrayXd::Ones(1)};
+
+  // Long filters use the FFTs, and the coefficients wrap around when there
+  // are more taps than FFT points
+  const FrequencyResponse response{freqz(fir, n, whole)};
+  const FrequencyResponse horner{freqz(fir, response.w)};
+
+  const ArrayXd passband{(response.magnitude > 1e-6).cast<double>()};
+  const double  diff{(response.h - horner.h).abs().maxCoeff()};
+  const double  delayDiff{
+      (passband * (response.groupDelay - horner.groupDelay).abs())
+          .maxCoeff()};
+  std::cout << "max |fft - horner|: " << diff
+            << ", group delay: " << delayDiff << '\n';
+
+  return diff < 1e-9 && delayDiff < 1e-6;
+}
+
+bool testArbitraryGrid(const ZPK& zpk) {
+  std::cout << "--- Testing Horner frequency response on arbitrary grid ---\n";
+
+  ArrayXd w(1000);
+  for (Index i{0}; i < w.size(); ++i)
+    w(i) = std::fmod(0.37 * static_cast<double>(i * i), std::numbers::pi);
+
+  const EigenCoeffs       tf{zpk2tf(EigenZPK{zpk})};
+  const FrequencyResponse response{freqz(tf, w)};
+  const ArrayXcd          expected{freqz(EigenZPK{zpk}, w)};
+
+  const double diff{(response.h - expected).abs().maxCoeff()};
+  const double phaseDiff{
+      (response.phase - expected.arg()).abs().maxCoeff()};
+  std::cout << "max |horner - zpk|: " << diff << '\n';
+
+  return diff < 1e-9 && phaseDiff < 1e-9;
+}
+
+bool testGroupDelay(const ZPK& zpk) {
+  std::cout << "--- Testing group delay against the phase derivative ---\n";
+
+  const Index             n{8192};
+  const FrequencyResponse response{freqz(zpk2tf(EigenZPK{zpk}), n)};
+  const double            dw{std::numbers::pi / static_cast<double>(n)};
+
+  // Central differences of the unwrapped phase, away from the stopband zeros
+  double diff{0.0};
+  for (Index k{1}; k < n / 2; ++k) {
+    double dPhase{response.phase(k + 1) - response.phase(k - 1)};
+    dPhase = std::remainder(dPhase, 2.0 * std::numbers::pi);
+    diff   = std::max(diff,
+                      std::abs(-dPhase / (2.0 * dw) - response.groupDelay(k)));
+  }
+  std::cout << "max |group delay - finite difference|: " << diff << '\n';
+
+  return diff < 1e-2;
+}
+
+bool testLinearPhase() {
+  std::cout << "--- Testing group delay of a linear phase FIR ---\n";
+
+  // Symmetric taps have a constant delay of half the length
+  const ArrayXd     b{{1.0, 3.0, -2.0, 5.0, -2.0, 3.0, 1.0}};
+  const EigenCoeffs fir{b, ArrayXd::Ones(1)};
+
+  const FrequencyResponse response{freqz(fir, 64)};
+  const FrequencyResponse horner{freqz(fir, response.w)};
+
+  const double diff{std::max((response.groupDelay - 3.0).abs().maxCoeff(),
+                             (horner.groupDelay - 3.0).abs().maxCoeff())};
+  std::cout << "max |group delay - 3|: " << diff << '\n';
+
+  return diff < 1e-9;
+}
+
+int main() {
+  const ZPK lowpass6{iirFilter(6, 100.0, 1000.0, cheb1, lowpass, 1.0)};
+  const ZPK bandpass4{iirFilter(4, 50.0, 150.0, 1000.0, butter, bandpass)};
+
+  if (!testUniformGrid(lowpass6, 512, false) ||
+      !testUniformGrid(bandpass4, 777, false) ||
+      !testUniformGrid(bandpass4, 777, true) ||
+      !testUniformGrid(lowpass6, 5, true)) {
+    std::cerr << "Uniform grid frequency response test failed.\n";
+    return 1;
+  }
+
+  if (!testLongFir(4096, false) || !testLongFir(100, true)) {
+    std::cerr << "Long FIR frequency response test failed.\n";
+    return 1;
+  }
+
+  if (!testArbitraryGrid(bandpass4)) {
+    std::cerr << "Arbitrary grid frequency response test failed.\n";
+    return 1;
+  }
+
+  if (!testGroupDelay(lowpass6)) {
+    std::cerr << "Group delay test failed.\n";
+    return 1;
+  }
+
+  if (!testLinearPhase()) {
+    std::cerr << "Linear phase group delay test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,247 @@
+#include "Filter.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// Direct form difference equation, assuming a(0) == 1
+ArrayXd differenceEquation(const EigenCoeffs& filter, const ArrayXd& x) {
+  ArrayXd y{ArrayXd::Zero(x.size())};
+  for (Index n{0}; n < x.size(); ++n) {
+    for (Index k{0}; k < filter.b.size() && k <= n; ++k)
+      y(n) += filter.b(k) * x(n - k);
+    for (Index k{1}; k < filter.a.size() && k <= n; ++k)
+      y(n) -= filter.a(k) * y(n - k);
+  }
+  return y;
+}
+
+bool testFixedOrder(const EigenCoeffs& filter) {
+  std::cout << "--- Testing linear filter with " << filter.b.size() << " b and "
+            << filter.a.size() << " a coefficients ---\n";
+
+  const Index   nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  const ArrayXd x{noiseMatrix(1, 2000).row(0).transpose().array()};
+
+  // Two chunks, so that the state is carried between calls
+  ArrayXd state{ArrayXd::Zero(nS)};
+  ArrayXd y(x.size());
+  y.head(777) = linearFilter(filter, x.head(777), state);
+  y.tail(x.size() - 777) = linearFilter(filter, x.tail(x.size() - 777), state);
+
+  const ArrayXd expected{differenceEquation(filter, x)};
+  const double  diff{(y - expected).abs().maxCoeff() /
+                    expected.abs().maxCoeff()};
+  std::cout << "max |linear - direct| / max |direct|: " << diff << '\n';
+
+  // A state too short for the filter is rejected, not resized
+  bool    rejected{false};
+  ArrayXd shortState{ArrayXd::Zero(nS - 1)};
+  try {
+    linearFilter(filter, x, shortState);
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return diff < 1e-9 && rejected;
+}
+
+bool testMultichannel(const EigenCoeffs& filter, const Index channels) {
+  std::cout << "--- Testing multichannel linear filter (" << channels
+            << " channels) ---\n";
+
+  const Index            nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  const RowMajorMatrixXd x{noiseMatrix(channels, 3000)};
+
+  // Two chunks through the matrix overload
+  RowMajorMatrixXd state{RowMajorMatrixXd::Zero(channels, nS)};
+  RowMajorMatrixXd y(channels, x.cols());
+  y.leftCols(1234) =
+      linearFilter(EigenCoeffs{filter}, x.leftCols(1234), state);
+  y.rightCols(x.cols() - 1234) =
+      linearFilter(EigenCoeffs{filter}, x.rightCols(x.cols() - 1234), state);
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{linearFilter(filter, x.row(r).transpose().array())};
+    diff = std::max(diff, (y.row(r).transpose().array() - expected)
+                              .abs()
+                              .maxCoeff());
+  }
+  std::cout << "max |multi - single|: " << diff << '\n';
+
+  return diff < 1e-12;
+}
+
+bool testPerChannel(const Index channels) {
+  std::cout << "--- Testing per-channel linear filter (" << channels
+            << " channels) ---\n";
+
+  // Lowpass filters of orders 1 to 4, zero-padded to the longest and scaled
+  // so that a(0) != 1
+  const RowMajorMatrixXd   x{noiseMatrix(channels, 3000)};
+  std::vector<EigenCoeffs> filters{};
+  RowMajorMatrixXd         b{RowMajorMatrixXd::Zero(channels, 5)};
+  RowMajorMatrixXd         a{RowMajorMatrixXd::Zero(channels, 5)};
+  for (Index r{0}; r < channels; ++r) {
+    const int    order{static_cast<int>(r % 4) + 1};
+    const double fc{50.0 + 7.0 * static_cast<double>(r)};
+    filters.push_back(zpk2tf(EigenZPK{iirFilter(order, fc, 1000.0)}));
+    b.row(r).head(order + 1) = filters.back().b.transpose().matrix();
+    a.row(r).head(order + 1) = filters.back().a.transpose().matrix();
+    b.row(r) *= static_cast<double>(r % 3 + 1);
+    a.row(r) *= static_cast<double>(r % 3 + 1);
+  }
+
+  // Two chunks through the matrix overload
+  RowMajorMatrixXd state{RowMajorMatrixXd::Zero(channels, 4)};
+  RowMajorMatrixXd y(channels, x.cols());
+  y.leftCols(1234) = linearFilter(b, a, x.leftCols(1234), state);
+  y.rightCols(x.cols() - 1234) =
+      linearFilter(b, a, x.rightCols(x.cols() - 1234), state);
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{linearFilter(filters[static_cast<std::size_t>(r)],
+                                        x.row(r).transpose().array())};
+    diff = std::max(diff, (y.row(r).transpose().array() - expected)
+                              .abs()
+                              .maxCoeff());
+  }
+  std::cout << "max |per-channel - single|: " << diff << '\n';
+
+  return diff < 1e-12;
+}
+
+bool testSinglePrecision(const EigenCoeffs& filter, const Index channels) {
+  std::cout << "--- Testing single precision linear filter (" << channels
+            << " channels) ---\n";
+
+  const RowMajorMatrixXd x{noiseMatrix(channels, 4000)};
+  const RowMajorMatrixXf xf{x.cast<float>()};
+  const EigenCoeffsF     filterF{filter};
+  const Index nS{std::max(filter.b.size(), filter.a.size()) - 1};
+
+  // Float storage with double accumulation, and float throughout
+  double doubleAccDiff{0.0};
+  double floatDiff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{linearFilter(filter, x.row(r).transpose().array())};
+    const ArrayXf row{xf.row(r).transpose().array()};
+
+    const ArrayXf doubleAcc{linearFilter(filter, row)};
+    const ArrayXf singleAcc{linearFilter(filterF, row)};
+
+    doubleAccDiff = std::max(
+        doubleAccDiff, (doubleAcc.cast<double>() - expected).abs().maxCoeff());
+    floatDiff = std::max(
+        floatDiff, (singleAcc.cast<double>() - expected).abs().maxCoeff());
+  }
+
+  // The multichannel version matches the single channel float filter
+  RowMajorMatrixXf       state{RowMajorMatrixXf::Zero(channels, nS)};
+  const RowMajorMatrixXf y{linearFilter(EigenCoeffsF{filterF}, xf, state)};
+  double                 multiDiff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXf row{xf.row(r).transpose().array()};
+    multiDiff =
+        std::max(multiDiff, static_cast<double>((y.row(r).transpose().array() -
+                                                 linearFilter(filterF, row))
+                                                    .abs()
+                                                    .maxCoeff()));
+  }
+
+  std::cout << "max |double acc - double|: " << doubleAccDiff
+            << ", max |float - double|: " << floatDiff
+            << ", max |multi - single|: " << multiDiff << '\n';
+
+  return doubleAccDiff < 1e-5 && floatDiff < 1e-3 && multiDiff < 1e-5;
+}
+
+bool testParallelInTime(const EigenCoeffs& filter, const Index blocks) {
+  std::cout << "--- Testing parallel-in-time linear filter (" << blocks
+            << " blocks) ---\n";
+
+  const Index   nS{std::max(filter.b.size(), filter.a.size()) - 1};
+  const ArrayXd x{noiseMatrix(1, 100003).row(0).transpose().array()};
+
+  ArrayXd       serialState{ArrayXd::Constant(nS, 0.25)};
+  ArrayXd       parallelState{serialState};
+  const ArrayXd expected{linearFilter(filter, x, serialState)};
+  const ArrayXd y{parallelLinearFilter(filter, x, parallelState, blocks)};
+
+  const double diff{(y - expected).abs().maxCoeff()};
+  const double stateDiff{(parallelState - serialState).abs().maxCoeff()};
+  std::cout << "max |parallel - serial|: " << diff
+            << ", final state difference: " << stateDiff << '\n';
+
+  return diff < 1e-10 && stateDiff < 1e-10;
+}
+
+int main() {
+  const double fs{1000.0};
+
+  const EigenCoeffs lowpass4{
+      zpk2tf(EigenZPK{iirFilter(4, 100.0, fs, butter, lowpass)})};
+  const EigenCoeffs bandpass3{
+      zpk2tf(EigenZPK{iirFilter(3, 50.0, 150.0, fs, cheb1, bandpass, 1.0)})};
+
+  for (const int order : {1, 2, 5, 8, 9}) {
+    if (!testFixedOrder(
+            zpk2tf(EigenZPK{iirFilter(order, 100.0, fs, cheb1, lowpass, 1.0)}))) {
+      std::cerr << "Order " << order << " linear filter test failed.\n";
+      return 1;
+    }
+  }
+
+  ArrayXd fir(4);
+  fir << 0.1, 0.2, 0.3, 0.4;
+  ArrayXd allPole(3);
+  allPole << 1.0, -0.5, 0.25;
+  if (!testFixedOrder(EigenCoeffs{fir, ArrayXd::Ones(1)}) ||
+      !testFixedOrder(EigenCoeffs{ArrayXd::Constant(1, 0.5), allPole})) {
+    std::cerr << "Unequal coefficient count linear filter test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(lowpass4, 13)) {
+    std::cerr << "Multichannel lowpass test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(bandpass3, 64)) {
+    std::cerr << "Multichannel bandpass test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(lowpass4, 3)) {
+    std::cerr << "Multichannel partial block test failed.\n";
+    return 1;
+  }
+
+  if (!testPerChannel(5) || !testPerChannel(19)) {
+    std::cerr << "Per-channel linear filter test failed.\n";
+    return 1;
+  }
+
+  if (!testSinglePrecision(lowpass4, 21)) {
+    std::cerr << "Single precision linear filter test failed.\n";
+    return 1;
+  }
+
+  if (!testParallelInTime(lowpass4, 7)) {
+    std::cerr << "Parallel-in-time lowpass test failed.\n";
+    return 1;
+  }
+
+  if (!testParallelInTime(bandpass3, 16)) {
+    std::cerr << "Parallel-in-time bandpass test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+#include "Averaging.h"
+#include "Convolution.h"
+#include "Filter.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace Nodex::Filter;
+
+// Counts the heap allocations made by the test. Eigen and the library
+// allocate through malloc, so that is hooked where the C library allows it
+static std::atomic<std::size_t> allocations{0};
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+  ++allocations;
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+  ++allocations;
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, std::size_t size) noexcept {
+  ++allocations;
+  return __libc_realloc(p, size);
+}
+}
+#else
+void* operator new(const std::size_t size) {
+  ++allocations;
+  if (void* p{std::malloc(size)})
+    return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+double maxAbsDiff(const Signal& a, const Signal& b) {
+  double diff{0.0};
+  for (std::size_t i{0}; i < a.size(); ++i) {
+    diff = std::max(diff, std::abs(a[i] - b[i]));
+  }
+  return diff;
+}
+
+bool testLinearFilter(const Coeffs& filter) {
+  std::cout << "--- Testing linear filter into output buffers ---\n";
+
+  const Signal x{noiseSignal(4096)};
+  const Signal expected{linearFilter(filter, x)};
+
+  // Chunks of 256 samples filtered in place, as a streaming caller would
+  Signal y{x};
+  Signal si(std::max(filter.b.size(), filter.a.size()) - 1, 0.0);
+
+  const std::size_t before{allocations};
+  for (std::size_t start{0}; start < y.size(); start += 256) {
+    const std::span<double> chunk{y.data() + start, 256};
+    linearFilter(filter, chunk, chunk, si);
+  }
+  const std::size_t used{allocations - before};
+
+  const double diff{maxAbsDiff(y, expected)};
+  std::cout << "max |in place - linear|: " << diff
+            << ", allocations: " << used << '\n';
+
+  return diff < 1e-12 && used == 0;
+}
+
+bool testSosFilter(const SOS& sos) {
+  std::cout << "--- Testing SOS filter into output buffers ---\n";
+
+  const Signal x{noiseSignal(4096)};
+  const Signal expected{sosFilter(sos, x)};
+
+  Signal y(x.size());
+  Signal si(2 * sos.size(), 0.0);
+
+  const std::size_t before{allocations};
+  for (std::size_t start{0}; start < x.size(); start += 512) {
+    sosFilter(sos, std::span<const double>{x.data() + start, 512},
+              std::span<double>{y.data() + start, 512}, si);
+  }
+  const std::size_t used{allocations - before};
+
+  const double diff{maxAbsDiff(y, expected)};
+  std::cout << "max |buffered - sos|: " << diff << ", allocations: " << used
+            << '\n';
+
+  return diff < 1e-12 && used == 0;
+}
+
+bool testPartitionedConvolver(const Index tailBlockSize) {
+  std::cout << "--- Testing partitioned convolver in place (tail blocks "
+            << tailBlockSize << ") ---\n";
+
+  const Signal xSignal{noiseSignal(6000)};
+  const Eigen::Map<const ArrayXd> x(xSignal.data(),
+                                    static_cast<Index>(xSignal.size()));
+  const ArrayXd                   ir{x.head(1500) * 0.01};
+
+  PartitionedConvolver reference{ir, 64, tailBlockSize};
+  const ArrayXd        expected{reference.process(x)};
+
+  PartitionedConvolver convolver{ir, 64, tailBlockSize};
+  ArrayXd              y{x};
+
+  // Warm up the transforms of this thread on a full block of the longest
+  // partition before counting
+  const Index warmUp{std::max<Index>(64, tailBlockSize)};
+  convolver.process(y.head(warmUp), y.head(warmUp));
+
+  const std::size_t before{allocations};
+  for (Index start{warmUp}; start < y.size(); start += 100) {
+    const Index len{std::min<Index>(100, y.size() - start)};
+    convolver.process(y.segment(start, len), y.segment(start, len));
+  }
+  const std::size_t used{allocations - before};
+
+  const double diff{(y - expected).abs().maxCoeff()};
+  std::cout << "max |in place - reference|: " << diff
+            << ", allocations: " << used << '\n';
+
+  return diff < 1e-12 && used == 0;
+}
+
+bool testRunningStats() {
+  std::cout << "--- Testing running statistics into output buffers ---\n";
+
+  const RowMajorMatrixXd x{noiseMatrix(3, 4096)};
+  RowMajorMatrixXd       mean(3, x.cols());
+  RowMajorMatrixXd       variance(3, x.cols());
+  RowMajorMatrixXd       rms(3, x.cols());
+
+  // Across several window resyncs
+  RunningStats      stats{500, 3};
+  const std::size_t before{allocations};
+  for (Index start{0}; start < x.cols(); start += 256) {
+    stats.process(x.middleCols(start, 256), mean.middleCols(start, 256),
+                  variance.middleCols(start, 256), rms.middleCols(start, 256));
+  }
+  const std::size_t used{allocations - before};
+
+  std::cout << "allocations: " << used << '\n';
+
+  return used == 0;
+}
+
+int main() {
+  const ZPK zpk{iirFilter(6, 80.0, 1000.0, cheb1, lowpass, 1.0)};
+
+  if (!testLinearFilter(zpk2tf(zpk))) {
+    std::cerr << "Linear filter output buffer test failed.\n";
+    return 1;
+  }
+
+  if (!testSosFilter(zpk2sos(zpk))) {
+    std::cerr << "SOS filter output buffer test failed.\n";
+    return 1;
+  }
+
+  if (!testPartitionedConvolver(0) || !testPartitionedConvolver(256)) {
+    std::cerr << "Partitioned convolver output buffer test failed.\n";
+    return 1;
+  }
+
+  if (!testRunningStats()) {
+    std::cerr << "Running statistics output buffer test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+#include "FilterEigen.h"
+#include "Resample.h"
+#include <cmath>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+ArrayXd sine(const Index n, const double f, const double fs) {
+  ArrayXd x(n);
+  for (Index i{0}; i < n; ++i) {
+    x(i) = std::sin(2.0 * std::numbers::pi * f * static_cast<double>(i) / fs);
+  }
+  return x;
+}
+
+// Zero stuffing, full convolution and decimation, sample by sample
+ArrayXd directUpfirdn(const ArrayXd& h, const ArrayXd& x, const Index up,
+                      const Index down) {
+  ArrayXd upsampled{ArrayXd::Zero((x.size() - 1) * up + 1)};
+  for (Index i{0}; i < x.size(); ++i)
+    upsampled(i * up) = x(i);
+
+  ArrayXd full{ArrayXd::Zero(upsampled.size() + h.size() - 1)};
+  for (Index n{0}; n < upsampled.size(); ++n)
+    full.segment(n, h.size()) += upsampled(n) * h;
+
+  ArrayXd y((full.size() - 1) / down + 1);
+  for (Index n{0}; n < y.size(); ++n)
+    y(n) = full(n * down);
+  return y;
+}
+
+bool testUpfirdn(const Index up, const Index down) {
+  std::cout << "--- Testing upfirdn (up " << up << ", down " << down
+            << ") ---\n";
+
+  const ArrayXd h{sine(37, 3.0, 100.0) + 0.1};
+  const ArrayXd x{sine(500, 7.0, 1000.0) + 0.3 * sine(500, 190.0, 1000.0)};
+
+  const ArrayXd y{upfirdn(h, x, up, down)};
+  const ArrayXd expected{directUpfirdn(h, x, up, down)};
+
+  const double diff{y.size() == expected.size()
+                        ? (y - expected).abs().maxCoeff()
+                        : 1.0};
+  std::cout << "length: " << y.size() << ", max |polyphase - direct|: " << diff
+            << '\n';
+
+  return diff < 1e-12;
+}
+
+bool testStreaming(const Index up, const Index down, const Index chunk) {
+  std::cout << "--- Testing streaming resampler (up " << up << ", down "
+            << down << ", chunks of " << chunk << ") ---\n";
+
+  const ArrayXd x{sine(3000, 11.0, 1000.0) + 0.2 * sine(3000, 97.0, 1000.0)};
+
+  PolyphaseResampler whole{up, down};
+  const ArrayXd      expected{whole.process(x)};
+
+  PolyphaseResampler streaming{up, down};
+  ArrayXd            y(expected.size());
+  Index              produced{0};
+  for (Index start{0}; start < x.size(); start += chunk) {
+    const Index   len{std::min(chunk, x.size() - start)};
+    const ArrayXd out{streaming.process(x.segment(start, len))};
+    y.segment(produced, out.size()) = out;
+    produced += out.size();
+  }
+
+  const double diff{(y - expected).abs().maxCoeff()};
+  std::cout << "outputs: " << produced << ", max |chunked - whole|: " << diff
+            << '\n';
+
+  return produced == expected.size() && diff == 0.0;
+}
+
+bool testResamplePoly(const Index up, const Index down) {
+  std::cout << "--- Testing resample_poly (up " << up << ", down " << down
+            << ") ---\n";
+
+  // A tone well inside both bands comes out delay free at the new rate
+  const double  fs{30000.0};
+  const double  f{10.0};
+  const ArrayXd x{sine(30000, f, fs)};
+  const ArrayXd y{resamplePoly(x, up, down)};
+
+  const double  newFs{fs * static_cast<double>(up) / static_cast<double>(down)};
+  const ArrayXd expected{sine(y.size(), f, newFs)};
+
+  // Away from the edges, where the signal was cut off
+  const Index  edge{y.size() / 10};
+  const double diff{
+      (y.segment(edge, y.size() - 2 * edge) -
+       expected.segment(edge, y.size() - 2 * edge))
+          .abs()
+          .maxCoeff()};
+  const Index expectedLength{(x.size() * up + down - 1) / down};
+  std::cout << "length: " << y.size() << ", max |y - sine|: " << diff << '\n';
+
+  return y.size() == expectedLength && diff < 1e-3;
+}
+
+bool testAntiAliasing() {
+  std::cout << "--- Testing resample_poly anti-aliasing ---\n";
+
+  // A tone above the new Nyquist frequency must not fold into the output
+  const ArrayXd x{sine(30000, 700.0, 30000.0)};
+  const ArrayXd y{resamplePoly(x, 1, 30)};
+
+  const double peak{y.segment(100, y.size() - 200).abs().maxCoeff()};
+  std::cout << "residual amplitude: " << peak << '\n';
+
+  return peak < 1e-2;
+}
+
+bool testMultichannel(const Index channels) {
+  std::cout << "--- Testing multichannel resample_poly (" << channels
+            << " channels) ---\n";
+
+  RowMajorMatrixXd x(channels, 1200);
+  for (Index r{0}; r < channels; ++r)
+    x.row(r) = sine(1200, 3.0 * static_cast<double>(r + 1), 1000.0).transpose();
+
+  const RowMajorMatrixXd y{resamplePolyMultichannel(x, 3, 7)};
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{resamplePoly(ArrayXd{x.row(r).transpose()}, 3, 7)};
+    diff = std::max(
+        diff, (y.row(r).transpose().array() - expected).abs().maxCoeff());
+  }
+  std::cout << "max |multi - single|: " << diff << '\n';
+
+  return diff == 0.0;
+}
+
+int main() {
+  if (!testUpfirdn(1, 1) || !testUpfirdn(3, 1) || !testUpfirdn(1, 4) ||
+      !testUpfirdn(5, 3) || !testUpfirdn(2, 7)) {
+    std::cerr << "upfirdn test failed.\n";
+    return 1;
+  }
+
+  if (!testStreaming(1, 30, 64) || !testStreaming(3, 2, 1) ||
+      !testStreaming(7, 5, 333)) {
+    std::cerr << "Streaming resampler test failed.\n";
+    return 1;
+  }
+
+  if (!testResamplePoly(1, 30) || !testResamplePoly(2, 3) ||
+      !testResamplePoly(4, 1)) {
+    std::cerr << "resample_poly test failed.\n";
+    return 1;
+  }
+
+  if (!testAntiAliasing()) {
+    std::cerr << "Anti-aliasing test failed.\n";
+    return 1;
+  }
+
+  if (!testMultichannel(4)) {
+    std::cerr << "Multichannel resample_poly test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include "FilterEigen.h"
+#include "SlidingDft.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+
+using namespace Nodex::Filter;
+
+// sum x(n) e^(-j 2 pi f n / fs), term by term
+Complex directDft(const ArrayXd& x, const double f, const double fs) {
+  Complex sum{};
+  for (Index n{0}; n < x.size(); ++n)
+    sum += x(n) * std::polar(1.0, -2 * std::numbers::pi * f * n / fs);
+  return sum;
+}
+
+bool testGoertzel() {
+  std::cout << "--- Testing Goertzel against the direct DFT ---\n";
+
+  const double     fs{1000.0};
+  const ArrayXd    frequencies{{0.0, 50.0, 61.3, 250.0, 499.0}};
+  RowMajorMatrixXd x{RowMajorMatrixXd::Random(3, 777)};
+
+  const RowMajorMatrixXcd bins{goertzelMultichannel(x, frequencies, fs)};
+
+  double diff{0.0};
+  double singleDiff{0.0};
+  for (Index c{0}; c < x.rows(); ++c) {
+    const ArrayXd  row{x.row(c).transpose().array()};
+    const ArrayXcd single{goertzel(row, frequencies, fs)};
+    for (Index k{0}; k < frequencies.size(); ++k) {
+      diff = std::max(
+          diff, std::abs(bins(c, k) - directDft(row, frequencies(k), fs)));
+      singleDiff = std::max(singleDiff, std::abs(bins(c, k) - single(k)));
+    }
+  }
+  std::cout << "max |goertzel - dft|: " << diff
+            << ", multichannel vs single: " << singleDiff << '\n';
+
+  return diff < 1e-9 && singleDiff == 0.0;
+}
+
+bool testTracking() {
+  std::cout << "--- Testing sliding DFT tracking of tones ---\n";
+
+  const double  fs{1000.0};
+  const Index   window{200};
+  const Index   n{5000};
+  const ArrayXd frequencies{{50.0, 150.0, 61.3}};
+
+  // Tones with whole periods in the window; the third bin is off-grid
+  RowMajorMatrixXd x(2, n);
+  for (Index j{0}; j < n; ++j) {
+    const double t{j / fs};
+    const double w{2 * std::numbers::pi * t};
+    x(0, j) = 1.5 * std::cos(w * 50.0 + 0.3) + 0.4 * std::cos(w * 150.0 - 1.0);
+    x(1, j) = 0.8 * std::cos(w * 50.0 - 2.0) + 0.2 * std::sin(w * 100.0);
+  }
+
+  SlidingDft       tracker{frequencies, fs, window, 2};
+  RowMajorMatrixXd amplitude(6, n);
+  RowMajorMatrixXd phase(6, n);
+  tracker.process(x, amplitude, phase);
+
+  // Lane c * 3 + k, once the window is full
+  const auto steady{[&](const Index lane, const double a, const double p) {
+    const Index  tail{n - window};
+    const double ampErr{
+        (amplitude.row(lane).tail(tail).array() - a).abs().maxCoeff()};
+    const double phaseErr{
+        (phase.row(lane).tail(tail).array() - p).abs().maxCoeff()};
+    return ampErr < 1e-9 && phaseErr < 1e-9;
+  }};
+
+  const bool tones{steady(0, 1.5, 0.3) && steady(1, 0.4, -1.0) &&
+                   steady(3, 0.8, -2.0) && amplitude(4, n - 1) < 1e-9};
+
+  // The off-grid bin is the DFT of the last window, in absolute time
+  const double w{2 * std::numbers::pi * 61.3 / fs};
+  double       windowDiff{0.0};
+  for (Index c{0}; c < 2; ++c) {
+    const ArrayXd tail{x.row(c).tail(window).transpose().array()};
+    const Complex expected{
+        std::polar(1.0, -w * static_cast<double>(n - window)) *
+        goertzel(tail, ArrayXd{{61.3}}, fs)(0) * (2.0 / window)};
+    windowDiff = std::max(windowDiff,
+                          std::abs(tracker.bins()(c * 3 + 2) - expected));
+  }
+
+  // A bin at 0 reads the mean, not twice it
+  SlidingDft       dc{ArrayXd{{0.0, 50.0}}, fs, window};
+  RowMajorMatrixXd offset(1, n);
+  for (Index j{0}; j < n; ++j)
+    offset(0, j) = 0.5 + std::cos(2 * std::numbers::pi * 50.0 * j / fs);
+  RowMajorMatrixXd dcAmplitude(2, n);
+  RowMajorMatrixXd dcPhase(2, n);
+  dc.process(offset, dcAmplitude, dcPhase);
+  const double dcErr{std::max(std::abs(dcAmplitude(0, n - 1) - 0.5),
+                              std::abs(dcAmplitude(1, n - 1) - 1.0))};
+
+  std::cout << "tones tracked: " << tones
+            << ", off-grid bin difference: " << windowDiff
+            << ", DC error: " << dcErr << '\n';
+
+  return tones && windowDiff < 1e-9 && dcErr < 1e-9;
+}
+
+bool testChunked() {
+  std::cout << "--- Testing chunked and long-running tracking ---\n";
+
+  const double  fs{48000.0};
+  const Index   window{960};
+  const Index   n{400000};
+  const ArrayXd frequencies{{50.0, 100.0, 150.0}};
+
+  RowMajorMatrixXd x(1, n);
+  for (Index j{0}; j < n; ++j)
+    x(0, j) = 0.7 * std::cos(2 * std::numbers::pi * 50.0 * j / fs + 1.0) +
+              1e-3 * std::cos(2 * std::numbers::pi * 150.0 * j / fs);
+
+  SlidingDft       whole{frequencies, fs, window};
+  RowMajorMatrixXd amplitude(3, n);
+  RowMajorMatrixXd phase(3, n);
+  whole.process(x, amplitude, phase);
+
+  SlidingDft       chunked{frequencies, fs, window};
+  RowMajorMatrixXd chunkAmplitude(3, n);
+  RowMajorMatrixXd chunkPhase(3, n);
+  for (Index start{0}, i{0}; start < n; ++i) {
+    const Index size{std::min<Index>(i % 3 == 0 ? 1 : 1234, n - start)};
+    chunked.process(x.middleCols(start, size),
+                    chunkAmplitude.middleCols(start, size),
+                    chunkPhase.middleCols(start, size));
+    start += size;
+  }
+
+  const double chunkDiff{(chunkAmplitude - amplitude).cwiseAbs().maxCoeff() +
+                         (chunkPhase - phase).cwiseAbs().maxCoeff()};
+  const double drift{std::max({std::abs(amplitude(0, n - 1) - 0.7),
+                               std::abs(phase(0, n - 1) - 1.0),
+                               std::abs(amplitude(2, n - 1) - 1e-3),
+                               amplitude(1, n - 1)})};
+  std::cout << "chunked difference: " << chunkDiff
+            << ", error after " << n << " samples: " << drift << '\n';
+
+  whole.reset();
+  const bool cleared{whole.bins().isZero()};
+
+  bool rejected{false};
+  try {
+    whole.process(RowMajorMatrixXd::Zero(2, 4), amplitude.leftCols(4),
+                  phase.leftCols(4));
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return chunkDiff < 1e-12 && drift < 1e-9 && cleared && rejected;
+}
+
+int main() {
+  if (!testGoertzel()) {
+    std::cerr << "Goertzel test failed.\n";
+    return 1;
+  }
+
+  if (!testTracking()) {
+    std::cerr << "Sliding DFT tracking test failed.\n";
+    return 1;
+  }
+
+  if (!testChunked()) {
+    std::cerr << "Chunked sliding DFT test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
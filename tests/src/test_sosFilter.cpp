@@ -0,0 +1,169 @@
+#include "Filter.h"
+#include "FilterEigen.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <numbers>
+
+using namespace Nodex::Filter;
+
+double maxAbsDiff(const Signal& a, const Signal& b) {
+  double diff{0.0};
+  for (std::size_t i{0}; i < a.size(); ++i) {
+    diff = std::max(diff, std::abs(a[i] - b[i]));
+  }
+  return diff;
+}
+
+// Frequency response of a cascade of second-order sections
+Complex sosResponse(const SOS& sos, const double w) {
+  const Complex zm1{std::exp(Complex{0.0, -w})};
+  Complex       h{1.0};
+  for (const auto& s : sos) {
+    h *= (s[0] + s[1] * zm1 + s[2] * zm1 * zm1) /
+         (s[3] + s[4] * zm1 + s[5] * zm1 * zm1);
+  }
+  return h;
+}
+
+bool testMatchesTransferFunction(const ZPK& zpk) {
+  std::cout << "--- Testing SOS against transfer function filtering ---\n";
+
+  const Signal x{noiseSignal(2000)};
+  const Signal yTf{linearFilter(zpk2tf(zpk), x)};
+  const Signal ySos{sosFilter(zpk2sos(zpk), x)};
+
+  const double diff{maxAbsDiff(yTf, ySos)};
+  std::cout << "max |tf - sos|: " << diff << '\n';
+
+  return diff < 1e-9;
+}
+
+bool testFrequencyResponse(const ZPK& zpk) {
+  std::cout << "--- Testing SOS frequency response ---\n";
+
+  const SOS sos{zpk2sos(zpk)};
+
+  std::vector<double> w(64);
+  for (std::size_t i{0}; i < w.size(); ++i) {
+    w[i] = std::numbers::pi * static_cast<double>(i) /
+           static_cast<double>(w.size());
+  }
+  const std::vector<Complex> expected{freqz(zpk, w)};
+
+  double diff{0.0};
+  for (std::size_t i{0}; i < w.size(); ++i) {
+    diff = std::max(diff, std::abs(sosResponse(sos, w[i]) - expected[i]));
+  }
+  std::cout << "sections: " << sos.size() << ", max |H_sos - H_zpk|: " << diff
+            << '\n';
+
+  return sos.size() == (std::max(zpk.z.size(), zpk.p.size()) + 1) / 2 &&
+         diff < 1e-8;
+}
+
+bool testStateContinuity(const ZPK& zpk) {
+  std::cout << "--- Testing SOS chunked filtering ---\n";
+
+  const SosArray sos{zpk2sos(EigenZPK{zpk})};
+  const Signal   x{noiseSignal(1000)};
+
+  const Eigen::Map<const ArrayXd> xMap(x.data(),
+                                       static_cast<Index>(x.size()));
+  const ArrayXd                   whole{sosFilter(sos, xMap)};
+
+  ArrayXd state{ArrayXd::Zero(2 * sos.rows())};
+  ArrayXd chunked(xMap.size());
+  for (Index start{0}; start < xMap.size(); start += 137) {
+    const Index len{std::min<Index>(137, xMap.size() - start)};
+    chunked.segment(start, len) =
+        sosFilter(sos, xMap.segment(start, len), state);
+  }
+
+  return (whole - chunked).abs().maxCoeff() < 1e-12;
+}
+
+bool testPerChannel(const Index channels) {
+  std::cout << "--- Testing per-channel SOS filtering (" << channels
+            << " channels) ---\n";
+
+  // Bandpass filters of 2 to 6 sections; shorter cascades are padded with
+  // pass-through sections
+  std::vector<SosArray> sections{};
+  RowMajorMatrixXd      sos{RowMajorMatrixXd::Zero(channels, 36)};
+  for (Index r{0}; r < channels; ++r) {
+    const int    order{static_cast<int>(r % 5) + 2};
+    const double low{20.0 + 9.0 * static_cast<double>(r)};
+    sections.push_back(
+        zpk2sos(EigenZPK{iirFilter(order, low, 1.5 * low, 1000.0)}));
+    for (Index i{0}; i < 6; ++i) {
+      sos.block(r, 6 * i, 1, 6) =
+          i < sections.back().rows()
+              ? Eigen::RowVectorXd{sections.back().row(i).matrix()}
+              : Eigen::RowVectorXd{{1.0, 0.0, 0.0, 1.0, 0.0, 0.0}};
+    }
+  }
+
+  RowMajorMatrixXd x(channels, 1500);
+  for (Index r{0}; r < channels; ++r) {
+    const Signal row{noiseSignal(1500 + static_cast<std::size_t>(r))};
+    x.row(r) = Eigen::Map<const Eigen::RowVectorXd>(row.data() + r, 1500);
+  }
+
+  // Two chunks, so that the state is carried between calls
+  RowMajorMatrixXd state{RowMajorMatrixXd::Zero(channels, 12)};
+  RowMajorMatrixXd y(channels, x.cols());
+  y.leftCols(600) = sosFilterMultichannel(sos, x.leftCols(600), state);
+  y.rightCols(900) = sosFilterMultichannel(sos, x.rightCols(900), state);
+
+  double diff{0.0};
+  for (Index r{0}; r < channels; ++r) {
+    const ArrayXd expected{sosFilter(sections[static_cast<std::size_t>(r)],
+                                     x.row(r).transpose().array())};
+    diff = std::max(diff, (y.row(r).transpose().array() - expected)
+                              .abs()
+                              .maxCoeff());
+  }
+  std::cout << "max |per-channel - single|: " << diff << '\n';
+
+  return diff < 1e-12;
+}
+
+int main() {
+  const double fs{1000.0};
+
+  if (!testMatchesTransferFunction(iirFilter(4, 100.0, fs, butter, lowpass))) {
+    std::cerr << "SOS lowpass test failed.\n";
+    return 1;
+  }
+
+  if (!testMatchesTransferFunction(
+          iirFilter(2, 50.0, 150.0, fs, cheb1, bandpass, 1.0))) {
+    std::cerr << "SOS bandpass test failed.\n";
+    return 1;
+  }
+
+  if (!testFrequencyResponse(
+          iirFilter(10, 40.0, 60.0, fs, butter, bandstop))) {
+    std::cerr << "SOS bandstop frequency response test failed.\n";
+    return 1;
+  }
+
+  if (!testFrequencyResponse(iirFilter(7, 120.0, fs, cheb2, highpass, 40.0))) {
+    std::cerr << "SOS odd order frequency response test failed.\n";
+    return 1;
+  }
+
+  if (!testStateContinuity(iirFilter(5, 80.0, fs, cheb1, lowpass, 1.0))) {
+    std::cerr << "SOS chunked filtering test failed.\n";
+    return 1;
+  }
+
+  if (!testPerChannel(3) || !testPerChannel(20)) {
+    std::cerr << "Per-channel SOS filtering test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
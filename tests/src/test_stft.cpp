@@ -0,0 +1,143 @@
+#include "FilterEigen.h"
+#include "Fir.h"
+#include "Stft.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+
+using namespace Nodex::Filter;
+
+bool testSinePeak() {
+  std::cout << "--- Testing Welch PSD of a sine ---\n";
+
+  const double fs{1000.0};
+  const double f0{125.0};
+  const double amplitude{2.0};
+  const Index  n{8000};
+
+  const ArrayXd t{ArrayXd::LinSpaced(n, 0.0, static_cast<double>(n - 1)) /
+                  fs};
+  const ArrayXd x{amplitude * (2 * std::numbers::pi * f0 * t).sin()};
+
+  const ArrayXd psd{welch(x, hann, 256, 128, 512, fs)};
+  const ArrayXd f{Stft{hann, 256, 128, 512, 1, fs}.frequencies()};
+
+  Index peak{0};
+  psd.maxCoeff(&peak);
+
+  // The density integrates to the power of the sine
+  const double power{psd.sum() * fs / 512};
+  std::cout << "peak at " << f(peak) << " Hz, power: " << power << " (expected "
+            << amplitude * amplitude / 2 << ")\n";
+
+  return psd.size() == 257 && std::abs(f(peak) - f0) < 1e-9 &&
+         std::abs(power - amplitude * amplitude / 2) < 1e-2;
+}
+
+bool testWhiteNoise() {
+  std::cout << "--- Testing Welch PSD of white noise ---\n";
+
+  const double fs{200.0};
+  const double sigma{0.5};
+  const Index  n{200000};
+
+  std::mt19937                     gen{42};
+  std::normal_distribution<double> dist{0.0, sigma};
+  ArrayXd                          x(n);
+  for (Index i{0}; i < n; ++i)
+    x(i) = dist(gen);
+
+  // One-sided density of white noise: 2 sigma^2 / fs
+  const ArrayXd psd{welch(x, hamming, 128, 64, -1, fs)};
+  const double  level{psd.segment(1, psd.size() - 2).mean()};
+  const double  expected{2 * sigma * sigma / fs};
+  std::cout << "mean level: " << level << " (expected " << expected << ")\n";
+
+  return std::abs(level - expected) / expected < 0.02 &&
+         std::abs(psd(0) - expected / 2) / expected < 0.5;
+}
+
+bool testIncremental() {
+  std::cout << "--- Testing chunked STFT against a single call ---\n";
+
+  const Index      n{3000};
+  const Index      nC{3};
+  RowMajorMatrixXd x(nC, n);
+  for (Index c{0}; c < nC; ++c)
+    for (Index j{0}; j < n; ++j)
+      x(c, j) = std::sin(0.01 * (c + 1) * j) + 0.3 * std::cos(0.7 * j + c);
+
+  Stft                   whole{blackman, 200, 75, 256, nC, 500.0};
+  const Index            nFrames{whole.process(x)};
+  const RowMajorMatrixXd expected{whole.frames()};
+
+  // Chunks shorter and longer than the window, with empty ones
+  Stft             chunked{blackman, 200, 75, 256, nC, 500.0};
+  RowMajorMatrixXd frames(expected.rows(), expected.cols());
+  Index            done{0};
+  Index            start{0};
+  const Index      sizes[]{1, 0, 37, 199, 0, 400, 3, 751};
+  for (Index i{0}; start < n; ++i) {
+    const Index size{std::min(sizes[i % 8], n - start)};
+    const Index added{chunked.process(x.middleCols(start, size))};
+    frames.middleRows(done * nC, added * nC) = chunked.frames();
+    done += added;
+    start += size;
+  }
+
+  const double framesDiff{(frames - expected).cwiseAbs().maxCoeff()};
+  const double psdDiff{(chunked.psd() - whole.psd()).cwiseAbs().maxCoeff()};
+
+  // Each channel on its own
+  double channelDiff{0.0};
+  for (Index c{0}; c < nC; ++c) {
+    const ArrayXd          row{x.row(c).transpose().array()};
+    const RowMajorMatrixXd single{spectrogram(row, blackman, 200, 75, 256,
+                                              500.0)};
+    for (Index f{0}; f < nFrames; ++f)
+      channelDiff = std::max(
+          channelDiff,
+          (single.row(f) - expected.row(f * nC + c)).cwiseAbs().maxCoeff());
+  }
+
+  std::cout << "frames: " << nFrames << ", chunked difference: " << framesDiff
+            << ", psd difference: " << psdDiff
+            << ", per-channel difference: " << channelDiff << '\n';
+
+  chunked.reset();
+  const bool cleared{chunked.averaged() == 0 && chunked.psd().isZero() &&
+                     chunked.process(x.leftCols(199)) == 0};
+
+  bool rejected{false};
+  try {
+    Stft{hann, 64, 65};
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return nFrames == (n - 200) / 75 + 1 && done == nFrames &&
+         whole.averaged() == nFrames && framesDiff < 1e-12 &&
+         psdDiff < 1e-12 && channelDiff == 0.0 && cleared && rejected;
+}
+
+int main() {
+  if (!testSinePeak()) {
+    std::cerr << "Welch sine test failed.\n";
+    return 1;
+  }
+
+  if (!testWhiteNoise()) {
+    std::cerr << "Welch white noise test failed.\n";
+    return 1;
+  }
+
+  if (!testIncremental()) {
+    std::cerr << "Chunked STFT test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}
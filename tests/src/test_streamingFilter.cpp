@@ -0,0 +1,103 @@
+#include "StreamingFilter.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace Nodex::Filter;
+
+// Chunk lengths cycling through a few sizes, including single samples
+ArrayXd processChunked(StreamingFilter& filter, const ArrayXd& x) {
+  const std::vector<Index> chunks{1, 48, 7, 300, 1, 129};
+
+  ArrayXd y(x.size());
+  Index   start{0};
+  for (std::size_t i{0}; start < x.size(); ++i) {
+    const Index len{std::min(chunks[i % chunks.size()], x.size() - start)};
+    filter.process(x.segment(start, len), y.segment(start, len));
+    start += len;
+  }
+  return y;
+}
+
+bool testChunked(StreamingFilter filter, const ArrayXd& expected,
+                 const double tolerance) {
+  std::cout << "--- Testing chunked streaming filter (backend "
+            << filter.backend() << ") ---\n";
+
+  const ArrayXd x{noise(expected.size())};
+  const ArrayXd whole{filter.process(x)};
+
+  filter.reset();
+  const ArrayXd chunked{processChunked(filter, x)};
+
+  const double diff{(chunked - expected).abs().maxCoeff()};
+  std::cout << "max |chunked - one-shot|: " << diff << '\n';
+
+  return (whole - expected).abs().maxCoeff() <= tolerance &&
+         diff <= tolerance;
+}
+
+bool testSnapshot(StreamingFilter filter) {
+  std::cout << "--- Testing streaming filter snapshot (backend "
+            << filter.backend() << ") ---\n";
+
+  const ArrayXd x{noise(3000)};
+  filter.process(x.head(1700));
+
+  // Both continuations from the snapshot must be identical
+  const ArrayXd state{filter.snapshot()};
+  const ArrayXd first{filter.process(x.tail(1300))};
+  filter.restore(state);
+  const ArrayXd second{filter.process(x.tail(1300))};
+
+  bool rejected{false};
+  try {
+    filter.restore(ArrayXd::Zero(state.size() + 1));
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+
+  return state.size() == filter.stateSize() && (first == second).all() &&
+         rejected;
+}
+
+int main() {
+  const ArrayXd     x{noise(5000)};
+  const EigenZPK    zpk{iirFilter(4, 40.0, 90.0, 1000.0)};
+  const EigenCoeffs tf{zpk2tf(zpk)};
+  const SosArray    sections{zpk2sos(zpk)};
+
+  // Unnormalised coefficients and a pure gain
+  const EigenCoeffs scaled{2.0 * tf.b, 2.0 * tf.a};
+  const EigenCoeffs gain{ArrayXd::Constant(1, 3.0), ArrayXd::Constant(1, 2.0)};
+
+  const FftConvolver convolver{tf, 1e-14, 20000};
+
+  if (!testChunked(StreamingFilter{tf}, linearFilter(tf, x), 0.0) ||
+      !testChunked(StreamingFilter{scaled}, linearFilter(tf, x), 1e-12) ||
+      !testChunked(StreamingFilter{gain}, 1.5 * x, 0.0)) {
+    std::cerr << "Transfer function streaming filter test failed.\n";
+    return 1;
+  }
+
+  if (!testChunked(StreamingFilter{sections}, sosFilter(sections, x), 0.0)) {
+    std::cerr << "SOS streaming filter test failed.\n";
+    return 1;
+  }
+
+  if (!testChunked(StreamingFilter{convolver}, sosFilter(sections, x), 1e-9)) {
+    std::cerr << "FFT streaming filter test failed.\n";
+    return 1;
+  }
+
+  if (!testSnapshot(StreamingFilter{tf}) ||
+      !testSnapshot(StreamingFilter{sections}) ||
+      !testSnapshot(StreamingFilter{convolver})) {
+    std::cerr << "Streaming filter snapshot test failed.\n";
+    return 1;
+  }
+
+  return 0;
+}